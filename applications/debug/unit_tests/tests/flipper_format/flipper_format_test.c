@@ -4,6 +4,8 @@
 #include <toolbox/stream/stream.h>
 #include "../test.h" // IWYU pragma: keep
 
+#define TAG "FlipperFormatTest"
+
 #define TEST_DIR_NAME EXT_PATH(".tmp/unit_tests/ff")
 #define TEST_DIR TEST_DIR_NAME "/"
 
@@ -528,6 +530,131 @@ MU_TEST(flipper_format_oddities_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Oddities]");
 }
 
+#define UPDATE_TEST_FILE TEST_DIR "ff_update.test"
+#define UPDATE_TEST_CNT_KEY "Cnt"
+#define UPDATE_TEST_END_KEY "End"
+
+static bool test_update_create(size_t file_size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    bool result = false;
+
+    do {
+        if(!storage_file_open(file, UPDATE_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        furi_string_printf(line, "Filetype: %s\nVersion: %lu\n", test_filetype, test_version);
+        furi_string_cat_printf(line, UPDATE_TEST_CNT_KEY ": 00 00 00 01\n");
+        if(!storage_file_write(file, furi_string_get_cstr(line), furi_string_size(line))) break;
+
+        // Filler lines in the style of MIFARE Classic dumps
+        size_t written = furi_string_size(line);
+        bool error = false;
+        for(uint32_t block = 0; written < file_size; block++) {
+            furi_string_printf(line, "Block %lu:", block);
+            for(size_t i = 0; i < 16; i++) {
+                furi_string_cat_printf(line, " %02lX", (uint32_t)((block + i) & 0xFF));
+            }
+            furi_string_push_back(line, '\n');
+            if(!storage_file_write(file, furi_string_get_cstr(line), furi_string_size(line))) {
+                error = true;
+                break;
+            }
+            written += furi_string_size(line);
+        }
+        if(error) break;
+
+        furi_string_set(line, UPDATE_TEST_END_KEY ": true\n");
+        if(!storage_file_write(file, furi_string_get_cstr(line), furi_string_size(line))) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(line);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static uint32_t test_update_key(const uint8_t* data, size_t data_size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    uint32_t ticks = 0;
+
+    do {
+        if(!flipper_format_file_open_existing(file, UPDATE_TEST_FILE)) break;
+
+        uint32_t start = furi_get_tick();
+        if(!flipper_format_update_hex(file, UPDATE_TEST_CNT_KEY, data, data_size)) break;
+        ticks = MAX(furi_get_tick() - start, 1UL);
+    } while(false);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return ticks;
+}
+
+static bool test_update_check(const uint8_t* data, size_t data_size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    uint8_t buffer[8];
+    uint32_t count = 0;
+    bool end = false;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(file, UPDATE_TEST_FILE)) break;
+        if(!flipper_format_get_value_count(file, UPDATE_TEST_CNT_KEY, &count)) break;
+        if(count != data_size) break;
+        if(!flipper_format_read_hex(file, UPDATE_TEST_CNT_KEY, buffer, data_size)) break;
+        if(memcmp(buffer, data, data_size) != 0) break;
+        if(!flipper_format_read_bool(file, UPDATE_TEST_END_KEY, &end, 1) || !end) break;
+        result = true;
+    } while(false);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+MU_TEST(flipper_format_update_benchmark) {
+    const size_t file_sizes[] = {1024, 50 * 1024, 500 * 1024};
+    const uint8_t same_width[] = {0x00, 0x00, 0x00, 0x02};
+    const uint8_t shorter[] = {0x03, 0x04};
+    const uint8_t longer[] = {0x00, 0x00, 0x00, 0x00, 0x05};
+
+    for(size_t i = 0; i < COUNT_OF(file_sizes); i++) {
+        mu_assert(test_update_create(file_sizes[i]), "Cannot create update test file");
+
+        uint32_t in_place = test_update_key(same_width, sizeof(same_width));
+        mu_assert(in_place, "Cannot update key in place");
+        mu_assert(test_update_check(same_width, sizeof(same_width)), "Key updated incorrectly");
+
+        uint32_t padded = test_update_key(shorter, sizeof(shorter));
+        mu_assert(padded, "Cannot update key with padding");
+        mu_assert(test_update_check(shorter, sizeof(shorter)), "Key padded incorrectly");
+
+        uint32_t rewritten = test_update_key(longer, sizeof(longer));
+        mu_assert(rewritten, "Cannot update key with rewrite");
+        mu_assert(test_update_check(longer, sizeof(longer)), "Key rewritten incorrectly");
+
+        FURI_LOG_I(
+            TAG,
+            "%zu KB: in place %lu ms, padded %lu ms, rewrite %lu ms",
+            file_sizes[i] / 1024,
+            in_place,
+            padded,
+            rewritten);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(!storage_file_exists(storage, UPDATE_TEST_FILE ".tmp"), "Temp file left behind");
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -542,6 +669,7 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
+    MU_RUN_TEST(flipper_format_update_benchmark);
     tests_teardown();
 }
 
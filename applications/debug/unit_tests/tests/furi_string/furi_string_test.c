@@ -1,6 +1,20 @@
 #include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+#include <toolbox/keys_dict.h>
+#include <toolbox/stream/buffered_file_stream.h>
 #include "../test.h" // IWYU pragma: keep
 
+#define TAG "FuriStringTest"
+
+#define BENCHMARK_SOURCE_DICT_PATH EXT_PATH("nfc/assets/mf_classic_dict.nfc")
+#define BENCHMARK_DICT_PATH EXT_PATH(".tmp/unit_tests/furi_string_dict.nfc")
+#define BENCHMARK_DICT_KEYS (48)
+#define BENCHMARK_FLIPPER_FILE_PATH EXT_PATH("unit_tests/nfc/Ntag216.nfc")
+#define BENCHMARK_FLIPPER_FILE_PAGES (231)
+#define BENCHMARK_SEEK_STEP (10)
+#define BENCHMARK_SEEK_COUNT (24)
+
 static void test_setup(void) {
 }
 
@@ -445,6 +459,128 @@ MU_TEST(mu_test_furi_string_utf8) {
     furi_string_free(utf8_string);
 }
 
+MU_TEST(mu_test_furi_string_scratch) {
+    size_t mark = furi_string_scratch_mark();
+
+    FuriString* string_1 = furi_string_scratch_alloc();
+    furi_string_set(string_1, "scratch");
+    FuriString* string_2 = furi_string_scratch_alloc();
+    mu_check(string_1 != string_2);
+    mu_check(furi_string_empty(string_2));
+    mu_assert_int_eq(mark + 2, furi_string_scratch_mark());
+
+    // released string is reused and empty
+    furi_string_set(string_2, "scratch");
+    furi_string_scratch_free(string_2);
+    mu_check(furi_string_scratch_alloc() == string_2);
+    mu_check(furi_string_empty(string_2));
+
+    // reset releases everything taken after the mark
+    furi_string_scratch_reset(mark);
+    mu_assert_int_eq(mark, furi_string_scratch_mark());
+    mu_check(furi_string_scratch_alloc() == string_1);
+    mu_check(furi_string_empty(string_1));
+    furi_string_scratch_free(string_1);
+}
+
+// Small dictionaries are read line by line, without compiled index
+static bool furi_string_benchmark_dict_prepare(Storage* storage) {
+    Stream* source = buffered_file_stream_alloc(storage);
+    Stream* dict = buffered_file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    size_t keys = 0;
+
+    bool success =
+        buffered_file_stream_open(
+            source, BENCHMARK_SOURCE_DICT_PATH, FSAM_READ, FSOM_OPEN_EXISTING) &&
+        buffered_file_stream_open(dict, BENCHMARK_DICT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    while(success && keys < BENCHMARK_DICT_KEYS && stream_read_line(source, line)) {
+        if(furi_string_start_with_str(line, "#") || furi_string_size(line) < 2) continue;
+        success = stream_write_string(dict, line) == furi_string_size(line);
+        keys++;
+    }
+
+    furi_string_free(line);
+    buffered_file_stream_close(dict);
+    buffered_file_stream_close(source);
+    stream_free(dict);
+    stream_free(source);
+    return success && keys == BENCHMARK_DICT_KEYS;
+}
+
+// Before scratch strings every call took its temporary from the heap
+static size_t furi_string_benchmark_dict(bool heap_temporary) {
+    KeysDict* dict = keys_dict_alloc(BENCHMARK_DICT_PATH, KeysDictModeOpenExisting, 6);
+    uint8_t key[6];
+    size_t keys = 0;
+    bool key_read = true;
+
+    size_t alloc_count = memmgr_heap_get_alloc_count();
+    while(key_read) {
+        FuriString* temporary = heap_temporary ? furi_string_alloc() : NULL;
+        key_read = keys_dict_get_next_key(dict, key, sizeof(key));
+        if(key_read) keys++;
+        if(temporary) furi_string_free(temporary);
+    }
+    alloc_count = memmgr_heap_get_alloc_count() - alloc_count;
+
+    keys_dict_free(dict);
+    return keys == BENCHMARK_DICT_KEYS ? alloc_count : SIZE_MAX;
+}
+
+static size_t furi_string_benchmark_seek(Storage* storage, bool heap_temporary) {
+    FlipperFormat* file = flipper_format_buffered_file_alloc(storage);
+    char key[16];
+    size_t keys = 0;
+    size_t alloc_count = 0;
+
+    if(flipper_format_buffered_file_open_existing(file, BENCHMARK_FLIPPER_FILE_PATH)) {
+        alloc_count = memmgr_heap_get_alloc_count();
+        for(size_t page = 0; page < BENCHMARK_FLIPPER_FILE_PAGES; page += BENCHMARK_SEEK_STEP) {
+            snprintf(key, sizeof(key), "Page %zu", page);
+            FuriString* temporary = heap_temporary ? furi_string_alloc() : NULL;
+            if(flipper_format_key_exist(file, key)) keys++;
+            if(temporary) furi_string_free(temporary);
+        }
+        alloc_count = memmgr_heap_get_alloc_count() - alloc_count;
+    }
+
+    flipper_format_free(file);
+    return keys == BENCHMARK_SEEK_COUNT ? alloc_count : SIZE_MAX;
+}
+
+MU_TEST(mu_test_furi_string_scratch_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(furi_string_benchmark_dict_prepare(storage), "Benchmark dictionary not created");
+
+    // Warm up scratch pool of the test thread
+    furi_string_scratch_free(furi_string_scratch_alloc());
+
+    size_t dict_before = furi_string_benchmark_dict(true);
+    size_t dict_after = furi_string_benchmark_dict(false);
+    size_t seek_before = furi_string_benchmark_seek(storage, true);
+    size_t seek_after = furi_string_benchmark_seek(storage, false);
+    storage_simply_remove(storage, BENCHMARK_DICT_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    FURI_LOG_I(
+        TAG,
+        "keys_dict_get_next_key, %d keys: %zu allocations before, %zu after",
+        BENCHMARK_DICT_KEYS,
+        dict_before,
+        dict_after);
+    FURI_LOG_I(
+        TAG,
+        "flipper_format_stream_seek_to_key, %d lookups: %zu allocations before, %zu after",
+        BENCHMARK_SEEK_COUNT,
+        seek_before,
+        seek_after);
+    mu_assert(dict_after != SIZE_MAX, "Dictionary keys not read");
+    mu_assert(seek_after != SIZE_MAX, "Flipper format keys not found");
+    mu_check(dict_after + BENCHMARK_DICT_KEYS <= dict_before);
+    mu_check(seek_after + BENCHMARK_SEEK_COUNT <= seek_before);
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -460,6 +596,8 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_string_start_end);
     MU_RUN_TEST(mu_test_furi_string_trim);
     MU_RUN_TEST(mu_test_furi_string_utf8);
+    MU_RUN_TEST(mu_test_furi_string_scratch);
+    MU_RUN_TEST(mu_test_furi_string_scratch_benchmark);
 }
 
 int run_minunit_test_furi_string(void) {
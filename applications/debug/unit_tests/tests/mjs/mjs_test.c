@@ -0,0 +1,85 @@
+#include <furi.h>
+#include <mjs_core_public.h>
+#include <mjs_exec_public.h>
+#include <mjs_primitive_public.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "MjsTest"
+
+#define MJS_TEST_ITERATIONS   2000
+#define MJS_TEST_OBJECT_PROPS 30
+
+static uint32_t mjs_test_run(const char* script, int expected) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_val_t result = MJS_UNDEFINED;
+
+    uint32_t start = furi_get_tick();
+    mjs_err_t err = mjs_exec(mjs, script, &result);
+    uint32_t ticks = MAX(furi_get_tick() - start, 1UL);
+
+    bool valid = (err == MJS_OK) && mjs_is_number(result) &&
+                 (mjs_get_int(mjs, result) == expected);
+    mjs_destroy(mjs);
+
+    return valid ? ticks : 0;
+}
+
+MU_TEST(mjs_test_big_object_benchmark) {
+    FuriString* script = furi_string_alloc_set("let o = {");
+    for(size_t i = 0; i < MJS_TEST_OBJECT_PROPS; i++) {
+        furi_string_cat_printf(script, "%sp%zu: %zu", i ? ", " : "", i, i);
+    }
+    furi_string_cat_printf(
+        script,
+        "};\nlet s = 0;\n"
+        "for(let i = 0; i < %d; i++) { s = s + o.p%d + o.p0; }\ns;",
+        MJS_TEST_ITERATIONS,
+        MJS_TEST_OBJECT_PROPS - 1);
+
+    uint32_t ticks = mjs_test_run(
+        furi_string_get_cstr(script), MJS_TEST_ITERATIONS * (MJS_TEST_OBJECT_PROPS - 1));
+    mu_assert(ticks, "Script returned a wrong result");
+    FURI_LOG_I(TAG, "%d-property object reads: %lu ms", MJS_TEST_OBJECT_PROPS, ticks);
+
+    furi_string_free(script);
+}
+
+MU_TEST(mjs_test_small_object_benchmark) {
+    FuriString* script = furi_string_alloc_printf(
+        "let p = {x: 1, y: 2};\nlet s = 0;\n"
+        "for(let i = 0; i < %d; i++) { s = s + p.x + p.y; }\ns;",
+        MJS_TEST_ITERATIONS);
+
+    uint32_t ticks = mjs_test_run(furi_string_get_cstr(script), MJS_TEST_ITERATIONS * 3);
+    mu_assert(ticks, "Script returned a wrong result");
+    FURI_LOG_I(TAG, "Small object reads: %lu ms", ticks);
+
+    furi_string_free(script);
+}
+
+MU_TEST(mjs_test_global_read_benchmark) {
+    FuriString* script = furi_string_alloc_printf(
+        "let g = 5;\n"
+        "function f() { let s = 0; for(let i = 0; i < %d; i++) { s = s + g; } return s; }\n"
+        "f();",
+        MJS_TEST_ITERATIONS);
+
+    uint32_t ticks = mjs_test_run(furi_string_get_cstr(script), MJS_TEST_ITERATIONS * 5);
+    mu_assert(ticks, "Script returned a wrong result");
+    FURI_LOG_I(TAG, "Global reads from a function: %lu ms", ticks);
+
+    furi_string_free(script);
+}
+
+MU_TEST_SUITE(test_mjs_suite) {
+    MU_RUN_TEST(mjs_test_big_object_benchmark);
+    MU_RUN_TEST(mjs_test_small_object_benchmark);
+    MU_RUN_TEST(mjs_test_global_read_benchmark);
+}
+
+int run_minunit_test_mjs(void) {
+    MU_RUN_SUITE(test_mjs_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_mjs)
@@ -4,6 +4,9 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/nfc_util.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/mfkey32.h>
 #include <nfc/nfc_poller.h>
 #include <nfc/nfc_listener.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
@@ -24,6 +27,8 @@
 #include <nfc/nfc_poller.h>
 
 #include <toolbox/keys_dict.h>
+#include <toolbox/stream/file_stream.h>
+#include <bit_lib/bit_lib.h>
 #include <nfc/nfc.h>
 
 #include "../test.h" // IWYU pragma: keep
@@ -32,9 +37,18 @@
 
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_INDEX_TEST_PATH EXT_PATH("unit_tests/mf_dict_index.nfc")
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+#define NFC_TEST_CRYPTO1_ROUNDS (200)
+#define NFC_TEST_CRYPTO1_FRAME_SIZE (18)
+#define NFC_TEST_MFKEY32_TIME_SLICE_MS (100)
+// Two contribution bytes per round with little headroom for dense keystreams
+#define NFC_TEST_MFKEY32_ROUNDS_MEMORY (52368)
+// Full search takes minutes, broken nonces are only checked not to end early
+#define NFC_TEST_MFKEY32_BROKEN_SLICES (10)
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -583,6 +597,207 @@ MU_TEST(mf_classic_send_frame_test) {
     nfc_free(poller);
 }
 
+// Bit by bit reference for table driven crypto1_byte() and crypto1_word()
+static uint8_t crypto1_test_byte(Crypto1* crypto, uint8_t in) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_bit(crypto, FURI_BIT(in, i), 0) << i;
+    }
+    return out;
+}
+
+static uint32_t crypto1_test_word(Crypto1* crypto, uint32_t in) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)crypto1_bit(crypto, FURI_BIT(in, i ^ 24), 0) << (i ^ 24);
+    }
+    return out;
+}
+
+static void crypto1_test_encrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
+    const uint8_t* plain_data = bit_buffer_get_data(buff);
+    bit_buffer_set_size(out, bit_buffer_get_size(buff));
+    for(size_t i = 0; i < bit_buffer_get_size_bytes(buff); i++) {
+        uint8_t encrypted_byte = crypto1_test_byte(crypto, 0) ^ plain_data[i];
+        Crypto1 next = *crypto;
+        bool parity_bit = (crypto1_bit(&next, 0, 0) ^ nfc_util_odd_parity8(plain_data[i])) & 1;
+        bit_buffer_set_byte_with_parity(out, i, encrypted_byte, parity_bit);
+    }
+}
+
+MU_TEST(crypto1_table_test) {
+    Crypto1* crypto = crypto1_alloc();
+    Crypto1* reference = crypto1_alloc();
+    BitBuffer* plain = bit_buffer_alloc(NFC_TEST_CRYPTO1_FRAME_SIZE);
+    BitBuffer* encrypted = bit_buffer_alloc(NFC_TEST_CRYPTO1_FRAME_SIZE);
+    BitBuffer* expected = bit_buffer_alloc(NFC_TEST_CRYPTO1_FRAME_SIZE);
+
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_ROUNDS; i++) {
+        uint64_t key = 0;
+        furi_hal_random_fill_buf((uint8_t*)&key, sizeof(MfClassicKey));
+        crypto1_init(crypto, key);
+        crypto1_init(reference, key);
+
+        uint32_t word = furi_hal_random_get();
+        mu_assert(
+            crypto1_word(crypto, word, 0) == crypto1_test_word(reference, word),
+            "crypto1_word() output mismatch");
+        uint8_t byte = furi_hal_random_get();
+        mu_assert(
+            crypto1_byte(crypto, byte, 0) == crypto1_test_byte(reference, byte),
+            "crypto1_byte() output mismatch");
+        mu_assert(
+            crypto->odd == reference->odd && crypto->even == reference->even,
+            "Crypto1 state mismatch");
+
+        uint8_t frame[NFC_TEST_CRYPTO1_FRAME_SIZE];
+        furi_hal_random_fill_buf(frame, sizeof(frame));
+        bit_buffer_copy_bytes(plain, frame, sizeof(frame));
+        crypto1_encrypt(crypto, NULL, plain, encrypted);
+        crypto1_test_encrypt(reference, plain, expected);
+        mu_assert(
+            memcmp(bit_buffer_get_data(encrypted), bit_buffer_get_data(expected), sizeof(frame)) ==
+                0,
+            "crypto1_encrypt() data mismatch");
+        mu_assert(
+            memcmp(
+                bit_buffer_get_parity(encrypted),
+                bit_buffer_get_parity(expected),
+                (sizeof(frame) + 7) / 8) == 0,
+            "crypto1_encrypt() parity mismatch");
+    }
+
+    // Listener side of authentication: nonce, reader nonce and answer, tag answer
+    const uint64_t key = 0xa0a1a2a3a4a5;
+    const uint32_t nt = 0x01200145, cuid = 0x2a234f80, nr = 0x91bdc3f8;
+    uint8_t at[4] = {};
+    bit_buffer_copy_bytes(plain, at, sizeof(at));
+
+    uint32_t start = DWT->CYCCNT;
+    crypto1_init(crypto, key);
+    crypto1_word(crypto, nt ^ cuid, 0);
+    crypto1_word(crypto, nr, 1);
+    crypto1_word(crypto, 0, 0);
+    crypto1_encrypt(crypto, NULL, plain, encrypted);
+    uint32_t table_cycles = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    crypto1_init(reference, key);
+    crypto1_test_word(reference, nt ^ cuid);
+    crypto1_word(reference, nr, 1);
+    crypto1_test_word(reference, 0);
+    crypto1_test_encrypt(reference, plain, expected);
+    uint32_t bit_cycles = DWT->CYCCNT - start;
+
+    mu_assert(
+        memcmp(bit_buffer_get_data(encrypted), bit_buffer_get_data(expected), sizeof(at)) == 0,
+        "Auth answer mismatch");
+    FURI_LOG_I(TAG, "Crypto1 auth: %lu cycles, bit by bit: %lu cycles", table_cycles, bit_cycles);
+
+    bit_buffer_free(expected);
+    bit_buffer_free(encrypted);
+    bit_buffer_free(plain);
+    crypto1_free(reference);
+    crypto1_free(crypto);
+}
+
+typedef struct {
+    Mfkey32Nonces nonces;
+    uint64_t key;
+} NfcTestMfkey32Vector;
+
+// Authentications of a simulated reader, keys are found in the first round
+static const NfcTestMfkey32Vector nfc_test_mfkey32_vectors[] = {
+    {
+        .nonces =
+            {0x082B8199, 0xE95C90DA, 0x53CFDAAA, 0x97EF97C2, 0x11475F7B, 0xCCD4E2BC, 0x8907668B},
+        .key = 0xC73C26AFF039,
+    },
+    {
+        .nonces =
+            {0x3D35CCB9, 0xF56BA960, 0x842B1E44, 0x677DA294, 0x51232632, 0x04834A5B, 0xE55F6538},
+        .key = 0xA7F654A1A13B,
+    },
+    {
+        .nonces =
+            {0xEB233287, 0xC62D3522, 0x3774EF00, 0x60AED0FE, 0xF1D867C8, 0x4AD8B1C5, 0xFE4920B8},
+        .key = 0xE678C55F6915,
+    },
+};
+
+// Keystream of this reader is dense: a round overflows and is retried with a smaller range,
+// the key is found in the contribution byte 10 round
+static const NfcTestMfkey32Vector nfc_test_mfkey32_rounds_vector = {
+    .nonces = {0x9D86F877, 0x6F25FAB1, 0x90569735, 0xB5D6C468, 0xB95DA944, 0xB195C447, 0x639E048F},
+    .key = 0xE0D9B4D51BE5,
+};
+
+static Mfkey32Status nfc_test_mfkey32_run(Mfkey32* mfkey32, const Mfkey32Nonces* nonces) {
+    uint32_t start = furi_get_tick();
+    size_t slices = 0;
+
+    mfkey32_start(mfkey32, nonces);
+    Mfkey32Status status = Mfkey32StatusInProgress;
+    while(status == Mfkey32StatusInProgress) {
+        status = mfkey32_run(mfkey32, NFC_TEST_MFKEY32_TIME_SLICE_MS);
+        slices++;
+    }
+
+    FURI_LOG_I(TAG, "Mfkey32 done: %lu ms in %zu slices", furi_get_tick() - start, slices);
+    return status;
+}
+
+MU_TEST(mfkey32_test) {
+    // All memory is allocated upfront, so this is also peak usage during recovery
+    size_t heap_start = memmgr_get_free_heap();
+    Mfkey32* mfkey32 = mfkey32_alloc(MFKEY32_MEMORY_MIN);
+    size_t heap_used = heap_start - memmgr_get_free_heap();
+    mu_assert(heap_used <= MFKEY32_MEMORY_MIN + 64, "Memory limit exceeded");
+
+    FURI_LOG_I(TAG, "Mfkey32 uses %zu bytes", heap_used);
+
+    for(size_t i = 0; i < COUNT_OF(nfc_test_mfkey32_vectors); i++) {
+        const NfcTestMfkey32Vector* vector = &nfc_test_mfkey32_vectors[i];
+        Mfkey32Status status = nfc_test_mfkey32_run(mfkey32, &vector->nonces);
+
+        uint64_t key = 0;
+        mu_assert(status == Mfkey32StatusKeyFound, "Key not found");
+        mu_assert(mfkey32_get_key(mfkey32, &key), "Key not returned");
+        mu_assert(key == vector->key, "Wrong key found");
+        mu_assert(mfkey32_get_progress(mfkey32) == 100, "Wrong progress");
+    }
+
+    mfkey32_free(mfkey32);
+}
+
+MU_TEST(mfkey32_rounds_test) {
+    const NfcTestMfkey32Vector* vector = &nfc_test_mfkey32_rounds_vector;
+    Mfkey32* mfkey32 = mfkey32_alloc(NFC_TEST_MFKEY32_ROUNDS_MEMORY);
+    Mfkey32Status status = Mfkey32StatusInProgress;
+    uint64_t key = 0;
+
+    // Broken second reader answer, no key matches in the rounds before the real one
+    Mfkey32Nonces nonces = vector->nonces;
+    nonces.ar1 ^= 1;
+    mfkey32_start(mfkey32, &nonces);
+    for(size_t i = 0; i < NFC_TEST_MFKEY32_BROKEN_SLICES; i++) {
+        status = mfkey32_run(mfkey32, NFC_TEST_MFKEY32_TIME_SLICE_MS);
+        if(status != Mfkey32StatusInProgress) break;
+    }
+    mu_assert(status == Mfkey32StatusInProgress, "Search of broken nonces ended");
+    mu_assert(!mfkey32_get_key(mfkey32, &key), "Key returned for broken nonces");
+    mu_assert(mfkey32_get_progress(mfkey32) < 100, "Wrong progress");
+
+    // Restart drops the unfinished search
+    status = nfc_test_mfkey32_run(mfkey32, &vector->nonces);
+    mu_assert(status == Mfkey32StatusKeyFound, "Key not found");
+    mu_assert(mfkey32_get_key(mfkey32, &key), "Key not returned");
+    mu_assert(key == vector->key, "Wrong key found");
+    mu_assert(mfkey32_get_progress(mfkey32) == 100, "Wrong progress");
+
+    mfkey32_free(mfkey32);
+}
+
 MU_TEST(mf_classic_dict_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
@@ -652,6 +867,121 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+static void mf_classic_dict_index_test_key(uint32_t seed, uint32_t idx, MfClassicKey* key) {
+    uint64_t value = (seed + idx) * 0x9E3779B97F4A7C15ULL;
+    value ^= value >> 29;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 32;
+    bit_lib_num_to_bytes_be(value, sizeof(MfClassicKey), key->data);
+}
+
+static void mf_classic_dict_index_test_run(Storage* storage, uint32_t keys_total) {
+    const char* path = NFC_APP_MF_CLASSIC_DICT_INDEX_TEST_PATH;
+    const uint32_t seed = furi_hal_random_get();
+
+    // Write plain text dictionary
+    Stream* stream = file_stream_alloc(storage);
+    mu_assert(
+        file_stream_open(stream, path, FSAM_WRITE, FSOM_CREATE_ALWAYS), "Open test dict failed");
+    stream_write_cstring(stream, "# Index test dictionary\n");
+    MfClassicKey key = {};
+    for(uint32_t i = 0; i < keys_total; i++) {
+        mf_classic_dict_index_test_key(seed, i, &key);
+        stream_write_format(
+            stream,
+            "%02X%02X%02X%02X%02X%02X\n",
+            key.data[0],
+            key.data[1],
+            key.data[2],
+            key.data[3],
+            key.data[4],
+            key.data[5]);
+    }
+    file_stream_close(stream);
+    stream_free(stream);
+
+    // First alloc compiles the index, second one only loads it
+    uint32_t build_ticks = furi_get_tick();
+    KeysDict* dict = keys_dict_alloc(path, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    build_ticks = furi_get_tick() - build_ticks;
+    keys_dict_free(dict);
+
+    uint32_t load_ticks = furi_get_tick();
+    dict = keys_dict_alloc(path, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    load_ticks = furi_get_tick() - load_ticks;
+    mu_assert(keys_dict_get_total_keys(dict) == keys_total, "keys_dict_keys_total() failed");
+
+    // Keys must come in dictionary order
+    MfClassicKey key_dut = {};
+    uint32_t key_idx = 0;
+    while(keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey))) {
+        mf_classic_dict_index_test_key(seed, key_idx, &key);
+        mu_assert(memcmp(key.data, key_dut.data, sizeof(MfClassicKey)) == 0, "Key order mismatch");
+        key_idx++;
+    }
+    mu_assert(key_idx == keys_total, "Key count mismatch");
+
+    const uint32_t lookups = 100;
+    uint32_t index_ticks = furi_get_tick();
+    for(uint32_t i = 0; i < lookups; i++) {
+        mf_classic_dict_index_test_key(seed, (i * 7919) % keys_total, &key);
+        mu_assert(
+            keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey)),
+            "keys_dict_is_key_present() failed");
+        mf_classic_dict_index_test_key(seed, keys_total + i, &key);
+        mu_assert(
+            !keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey)),
+            "Absent key reported present");
+    }
+    index_ticks = furi_get_tick() - index_ticks;
+
+    // Modifying the dictionary falls back to plain text lookups
+    mf_classic_dict_index_test_key(seed, keys_total, &key);
+    mu_assert(keys_dict_add_key(dict, key.data, sizeof(MfClassicKey)), "add key failed");
+    uint32_t text_ticks = furi_get_tick();
+    for(uint32_t i = 0; i < lookups / 10; i++) {
+        mf_classic_dict_index_test_key(seed, (i * 7919) % keys_total, &key);
+        mu_assert(
+            keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey)),
+            "keys_dict_is_key_present() failed");
+    }
+    text_ticks = (furi_get_tick() - text_ticks) * 10;
+    keys_dict_free(dict);
+
+    FURI_LOG_I(
+        TAG,
+        "%lu keys: build %lu ms, load %lu ms, %lu lookups: index %lu ms, text %lu ms",
+        keys_total,
+        build_ticks,
+        load_ticks,
+        lookups * 2,
+        index_ticks,
+        text_ticks * 2);
+
+    // Index is rebuilt for the modified dictionary
+    dict = keys_dict_alloc(path, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    mu_assert(keys_dict_get_total_keys(dict) == keys_total + 1, "keys_dict_keys_total() failed");
+    mf_classic_dict_index_test_key(seed, keys_total, &key);
+    mu_assert(
+        keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey)),
+        "keys_dict_is_key_present() failed");
+    keys_dict_free(dict);
+
+    mu_assert(storage_simply_remove(storage, path), "Remove test dict failed");
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_INDEX_TEST_PATH ".kdx"),
+        "Remove test dict index failed");
+}
+
+MU_TEST(mf_classic_dict_index_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    mf_classic_dict_index_test_run(storage, 5000);
+    mf_classic_dict_index_test_run(storage, 50000);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 static FelicaError
     felica_do_request_response(FelicaData* felica_data, const FelicaCardKey* card_key) {
     NfcDeviceData* nfc_device = nfc_device_alloc();
@@ -863,7 +1193,11 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_write);
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
+    MU_RUN_TEST(crypto1_table_test);
+    MU_RUN_TEST(mfkey32_test);
+    MU_RUN_TEST(mfkey32_rounds_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_dict_index_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
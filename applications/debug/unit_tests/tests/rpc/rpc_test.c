@@ -45,10 +45,12 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TAG "UnitTestsRpc"
 #define MAX_RECEIVE_OUTPUT_TIMEOUT 3000
 #define MAX_NAME_LENGTH 254
-#define MAX_DATA_SIZE 512u // have to be exact as in rpc_storage.c
+#define MAX_DATA_SIZE 512u // have to be exact as RPC_DATA_SIZE_DEFAULT
 #define TEST_DIR_NAME EXT_PATH(".tmp/unit_tests/rpc")
 #define TEST_DIR TEST_DIR_NAME "/"
 #define MD5SUM_SIZE 16
+#define BENCHMARK_FILE_SIZE (64 * 1024)
+#define BENCHMARK_DATA_SIZE 2048u
 
 #define PING_REQUEST 0
 #define PING_RESPONSE 1
@@ -1095,6 +1097,116 @@ MU_TEST(test_storage_write) {
     test_storage_write_run(TEST_DIR "test2.txt", 512, 3, ++command_id, PB_CommandStatus_OK);
 }
 
+static uint32_t
+    test_storage_benchmark_write_run(const char* path, size_t size, uint32_t command_id) {
+    MsgList_t expected_msg_list;
+    MsgList_init(expected_msg_list);
+    test_rpc_add_empty_to_list(expected_msg_list, PB_CommandStatus_OK, command_id);
+
+    uint32_t start = furi_get_tick();
+    size_t size_left = size;
+    do {
+        size_t write_size = MIN(size_left, MAX_DATA_SIZE);
+        PB_Main request = {
+            .command_id = command_id,
+            .command_status = PB_CommandStatus_OK,
+            .cb_content.funcs.encode = NULL,
+            .has_next = (size_left > write_size),
+            .which_content = PB_Main_storage_write_request_tag,
+        };
+        request.content.storage_write_request.path = strdup(path);
+        request.content.storage_write_request.has_file = true;
+        pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(write_size));
+        data->size = write_size;
+        for(size_t i = 0; i < write_size; ++i) {
+            data->bytes[i] = '0' + ((size - size_left + i) % 10);
+        }
+        request.content.storage_write_request.file.data = data;
+
+        /* messages are fed one by one to keep memory usage low */
+        test_rpc_encode_and_feed_one(&request, 0);
+        size_left -= write_size;
+    } while(size_left);
+    test_rpc_decode_and_compare(expected_msg_list, 0);
+    uint32_t time = furi_get_tick() - start;
+
+    test_rpc_free_msg_list(expected_msg_list);
+    return time;
+}
+
+static uint32_t test_storage_benchmark_read_run(
+    const char* path,
+    size_t size,
+    size_t data_size,
+    uint32_t command_id) {
+    rpc_session_set_max_data_size(rpc_session[0].session, data_size);
+
+    PB_Main request;
+    test_rpc_create_simple_message(&request, PB_Main_storage_read_request_tag, path, command_id);
+
+    uint32_t start = furi_get_tick();
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+
+    size_t size_received = 0;
+    bool has_next = true;
+    while(has_next) {
+        rpc_session[0].timeout = furi_get_tick() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+        if(!pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+            mu_fail("not all expected messages decoded");
+            break;
+        }
+
+        mu_assert_int_eq(PB_Main_storage_read_response_tag, result.which_content);
+        mu_assert_int_eq(PB_CommandStatus_OK, result.command_status);
+        pb_bytes_array_t* data = result.content.storage_read_response.file.data;
+        mu_assert(data, "no data in read response");
+        mu_assert_int_eq(MIN(size - size_received, data_size), data->size);
+
+        bool data_valid = true;
+        for(size_t i = 0; i < data->size; ++i) {
+            data_valid &= (data->bytes[i] == '0' + ((size_received + i) % 10));
+        }
+        mu_assert(data_valid, "read data mismatch");
+
+        size_received += data->size;
+        has_next = result.has_next;
+        pb_release(&PB_Main_msg, &result);
+    }
+    uint32_t time = furi_get_tick() - start;
+
+    mu_assert_int_eq(size, size_received);
+    rpc_session_set_max_data_size(rpc_session[0].session, RPC_DATA_SIZE_DEFAULT);
+    return time;
+}
+
+MU_TEST(test_storage_benchmark) {
+    const char* path = TEST_DIR "benchmark.bin";
+
+    uint32_t write_time =
+        test_storage_benchmark_write_run(path, BENCHMARK_FILE_SIZE, ++command_id);
+    uint32_t read_time = test_storage_benchmark_read_run(
+        path, BENCHMARK_FILE_SIZE, RPC_DATA_SIZE_DEFAULT, ++command_id);
+    uint32_t read_big_time = test_storage_benchmark_read_run(
+        path, BENCHMARK_FILE_SIZE, BENCHMARK_DATA_SIZE, ++command_id);
+
+    FURI_LOG_I(
+        TAG,
+        "%d bytes: write %lums, read %lums, read by %u bytes %lums",
+        BENCHMARK_FILE_SIZE,
+        write_time,
+        read_time,
+        BENCHMARK_DATA_SIZE,
+        read_big_time);
+}
+
 MU_TEST(test_storage_interrupt_continuous_same_system) {
     MsgList_t input_msg_list;
     MsgList_init(input_msg_list);
@@ -1504,6 +1616,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_mkdir);
     MU_RUN_TEST(test_storage_md5sum);
     MU_RUN_TEST(test_storage_rename);
+    MU_RUN_TEST(test_storage_benchmark);
 
     DISABLE_TEST(MU_RUN_TEST(test_storage_interrupt_continuous_same_system););
     MU_RUN_TEST(test_storage_interrupt_continuous_another_system);
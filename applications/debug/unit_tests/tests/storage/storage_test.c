@@ -5,6 +5,9 @@
 // DO NOT USE THIS IN PRODUCTION CODE
 // This is a hack to access internal storage functions and definitions
 #include <storage/storage_i.h>
+#include <sector_cache.h>
+
+#define TAG "StorageTest"
 
 #define UNIT_TESTS_PATH(path) EXT_PATH("unit_tests/" path)
 
@@ -689,19 +692,546 @@ MU_TEST(test_md5_calc) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#include <lib/toolbox/delta_sync.h>
+
+#define DELTA_SYNC_TEST_BLOCK_SIZE (512)
+#define DELTA_SYNC_TEST_FILE_SIZE (DELTA_SYNC_TEST_BLOCK_SIZE * 5 + 440)
+#define DELTA_SYNC_TEST_PATH UNIT_TESTS_PATH("delta_sync.bin")
+#define DELTA_SYNC_TEST_DELTA_PATH UNIT_TESTS_PATH("delta_sync.delta")
+
+typedef struct {
+    uint32_t checksums[6];
+    size_t count;
+} DeltaSyncTestSignature;
+
+static void
+    delta_sync_test_signature_callback(uint32_t checksum, const uint8_t* md5, void* context) {
+    UNUSED(md5);
+    DeltaSyncTestSignature* signature = context;
+    furi_check(signature->count < COUNT_OF(signature->checksums));
+    signature->checksums[signature->count++] = checksum;
+}
+
+static bool
+    delta_sync_test_write(Storage* storage, const char* path, const void* data, size_t size) {
+    File* file = storage_file_alloc(storage);
+    bool result = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                  storage_file_write(file, data, size) == size;
+    storage_file_close(file);
+    storage_file_free(file);
+    return result;
+}
+
+static void delta_sync_test_put_u32(uint8_t** data, uint32_t value) {
+    for(size_t i = 0; i < sizeof(uint32_t); i++) {
+        *(*data)++ = value >> (i * 8);
+    }
+}
+
+MU_TEST(test_delta_sync) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    uint8_t* original = malloc(DELTA_SYNC_TEST_FILE_SIZE);
+    for(size_t i = 0; i < DELTA_SYNC_TEST_FILE_SIZE; i++) {
+        original[i] = i * 7 + i / 256;
+    }
+    mu_check(delta_sync_test_write(
+        storage, DELTA_SYNC_TEST_PATH, original, DELTA_SYNC_TEST_FILE_SIZE));
+
+    // Signature of every block, last one is shorter
+    DeltaSyncTestSignature signature = {};
+    mu_check(delta_sync_signature_file(
+        file,
+        DELTA_SYNC_TEST_PATH,
+        DELTA_SYNC_TEST_BLOCK_SIZE,
+        delta_sync_test_signature_callback,
+        &signature,
+        NULL));
+    mu_assert_int_eq(6, signature.count);
+    for(size_t i = 0; i < signature.count; i++) {
+        size_t offset = i * DELTA_SYNC_TEST_BLOCK_SIZE;
+        size_t size = MIN(DELTA_SYNC_TEST_BLOCK_SIZE, DELTA_SYNC_TEST_FILE_SIZE - offset);
+        mu_assert_int_eq(
+            delta_sync_checksum(&original[offset], size), signature.checksums[i]);
+    }
+
+    // Rolling checksum matches checksum calculated from scratch
+    uint32_t checksum = delta_sync_checksum(original, DELTA_SYNC_TEST_BLOCK_SIZE);
+    for(size_t i = 1; i < DELTA_SYNC_TEST_BLOCK_SIZE; i++) {
+        checksum = delta_sync_checksum_roll(
+            checksum,
+            DELTA_SYNC_TEST_BLOCK_SIZE,
+            original[i - 1],
+            original[i + DELTA_SYNC_TEST_BLOCK_SIZE - 1]);
+    }
+    mu_assert_int_eq(
+        delta_sync_checksum(&original[DELTA_SYNC_TEST_BLOCK_SIZE - 1], DELTA_SYNC_TEST_BLOCK_SIZE),
+        checksum);
+
+    // Literal, blocks 1-2 and the short last block
+    const char literal[] = "patched";
+    uint8_t delta[64];
+    uint8_t* delta_end = delta;
+    delta_sync_test_put_u32(&delta_end, DELTA_SYNC_MAGIC);
+    delta_sync_test_put_u32(&delta_end, DELTA_SYNC_TEST_BLOCK_SIZE);
+    *delta_end++ = 'L';
+    delta_sync_test_put_u32(&delta_end, strlen(literal));
+    memcpy(delta_end, literal, strlen(literal));
+    delta_end += strlen(literal);
+    *delta_end++ = 'C';
+    delta_sync_test_put_u32(&delta_end, 1);
+    delta_sync_test_put_u32(&delta_end, 2);
+    *delta_end++ = 'C';
+    delta_sync_test_put_u32(&delta_end, 5);
+    delta_sync_test_put_u32(&delta_end, 1);
+    mu_check(delta_sync_test_write(
+        storage, DELTA_SYNC_TEST_DELTA_PATH, delta, delta_end - delta));
+
+    FS_Error error;
+    mu_check(
+        delta_sync_patch_file(storage, DELTA_SYNC_TEST_PATH, DELTA_SYNC_TEST_DELTA_PATH, &error));
+    mu_assert_int_eq(FSE_OK, error);
+
+    const size_t patched_size = strlen(literal) + DELTA_SYNC_TEST_BLOCK_SIZE * 2 + 440;
+    uint8_t* patched = malloc(patched_size + 1);
+    mu_check(storage_file_open(file, DELTA_SYNC_TEST_PATH, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_assert_int_eq(patched_size, storage_file_read(file, patched, patched_size + 1));
+    storage_file_close(file);
+    mu_assert_mem_eq(literal, patched, strlen(literal));
+    mu_assert_mem_eq(
+        &original[DELTA_SYNC_TEST_BLOCK_SIZE],
+        &patched[strlen(literal)],
+        DELTA_SYNC_TEST_BLOCK_SIZE * 2);
+    mu_assert_mem_eq(
+        &original[DELTA_SYNC_TEST_BLOCK_SIZE * 5],
+        &patched[strlen(literal) + DELTA_SYNC_TEST_BLOCK_SIZE * 2],
+        440);
+
+    // Copy beyond the end of file is rejected and file is left as is
+    delta_end = delta + sizeof(uint32_t) * 2;
+    *delta_end++ = 'C';
+    delta_sync_test_put_u32(&delta_end, 10);
+    delta_sync_test_put_u32(&delta_end, 1);
+    mu_check(delta_sync_test_write(
+        storage, DELTA_SYNC_TEST_DELTA_PATH, delta, delta_end - delta));
+    mu_check(
+        !delta_sync_patch_file(storage, DELTA_SYNC_TEST_PATH, DELTA_SYNC_TEST_DELTA_PATH, &error));
+    mu_assert_int_eq(FSE_INVALID_PARAMETER, error);
+
+    FileInfo fileinfo;
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, DELTA_SYNC_TEST_PATH, &fileinfo));
+    mu_assert_int_eq(patched_size, fileinfo.size);
+
+    free(patched);
+    free(original);
+    storage_file_free(file);
+    storage_common_remove(storage, DELTA_SYNC_TEST_PATH);
+    storage_common_remove(storage, DELTA_SYNC_TEST_DELTA_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define SECTOR_CACHE_TEST_DISK_SECTORS (32)
+
+typedef struct {
+    uint8_t* data;
+    uint32_t reads;
+    uint32_t reads_failed;
+    uint32_t writes;
+} SectorCacheTestDisk;
+
+static bool
+    sector_cache_test_read(void* context, uint8_t* data, uint32_t sector, uint32_t count) {
+    SectorCacheTestDisk* disk = context;
+    if(sector + count > SECTOR_CACHE_TEST_DISK_SECTORS) {
+        disk->reads_failed++;
+        return false;
+    }
+
+    memcpy(
+        data,
+        &disk->data[sector * SECTOR_CACHE_SECTOR_SIZE],
+        count * SECTOR_CACHE_SECTOR_SIZE);
+    disk->reads++;
+    return true;
+}
+
+static bool
+    sector_cache_test_write(void* context, const uint8_t* data, uint32_t sector, uint32_t count) {
+    SectorCacheTestDisk* disk = context;
+    if(sector + count > SECTOR_CACHE_TEST_DISK_SECTORS) return false;
+
+    memcpy(
+        &disk->data[sector * SECTOR_CACHE_SECTOR_SIZE],
+        data,
+        count * SECTOR_CACHE_SECTOR_SIZE);
+    disk->writes++;
+    return true;
+}
+
+static SectorCache* sector_cache_test_alloc(SectorCacheTestDisk* disk) {
+    disk->data = malloc(SECTOR_CACHE_TEST_DISK_SECTORS * SECTOR_CACHE_SECTOR_SIZE);
+    for(uint32_t sector = 0; sector < SECTOR_CACHE_TEST_DISK_SECTORS; sector++) {
+        memset(&disk->data[sector * SECTOR_CACHE_SECTOR_SIZE], sector, SECTOR_CACHE_SECTOR_SIZE);
+    }
+    disk->reads = 0;
+    disk->reads_failed = 0;
+    disk->writes = 0;
+
+    const SectorCacheConfig config = {
+        .sectors = 8,
+        .read_ahead = 4,
+    };
+    return sector_cache_alloc(&config, sector_cache_test_read, sector_cache_test_write, disk);
+}
+
+static void sector_cache_test_free(SectorCache* cache, SectorCacheTestDisk* disk) {
+    sector_cache_free(cache);
+    free(disk->data);
+}
+
+static bool sector_cache_test_check(const uint8_t* data, uint8_t value) {
+    for(size_t i = 0; i < SECTOR_CACHE_SECTOR_SIZE; i++) {
+        if(data[i] != value) return false;
+    }
+    return true;
+}
+
+MU_TEST(test_sector_cache_read_ahead) {
+    SectorCacheTestDisk disk;
+    SectorCache* cache = sector_cache_test_alloc(&disk);
+    uint8_t* data = malloc(SECTOR_CACHE_SECTOR_SIZE);
+
+    for(uint32_t sector = 0; sector < SECTOR_CACHE_TEST_DISK_SECTORS; sector++) {
+        mu_check(sector_cache_read(cache, data, sector, 1));
+        mu_check(sector_cache_test_check(data, sector));
+    }
+
+    // Sectors are fetched 4 at a time, except at the end of the disk
+    mu_check(disk.reads < SECTOR_CACHE_TEST_DISK_SECTORS / 2);
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(SECTOR_CACHE_TEST_DISK_SECTORS, stats.hits + stats.misses);
+    mu_assert_int_eq(stats.hits, stats.read_ahead_hits);
+
+    free(data);
+    sector_cache_test_free(cache, &disk);
+}
+
+MU_TEST(test_sector_cache_read_ahead_disk_end) {
+    SectorCacheTestDisk disk;
+    SectorCache* cache = sector_cache_test_alloc(&disk);
+    uint8_t* data = malloc(SECTOR_CACHE_SECTOR_SIZE);
+
+    sector_cache_set_disk_sectors(cache, SECTOR_CACHE_TEST_DISK_SECTORS);
+
+    // Read ahead from the second last sector only fetches the last one
+    for(uint32_t sector = SECTOR_CACHE_TEST_DISK_SECTORS - 3;
+        sector < SECTOR_CACHE_TEST_DISK_SECTORS;
+        sector++) {
+        mu_check(sector_cache_read(cache, data, sector, 1));
+        mu_check(sector_cache_test_check(data, sector));
+    }
+    mu_assert_int_eq(2, disk.reads);
+    mu_assert_int_eq(0, disk.reads_failed);
+
+    free(data);
+    sector_cache_test_free(cache, &disk);
+}
+
+MU_TEST(test_sector_cache_scan_resistance) {
+    SectorCacheTestDisk disk;
+    SectorCache* cache = sector_cache_test_alloc(&disk);
+    uint8_t* data = malloc(SECTOR_CACHE_SECTOR_SIZE);
+
+    // Sector 0 is pushed out by other sectors, then read again
+    mu_check(sector_cache_read(cache, data, 0, 1));
+    for(uint32_t sector = 2; sector < 20; sector += 2) {
+        mu_check(sector_cache_read(cache, data, sector, 1));
+    }
+    mu_check(sector_cache_read(cache, data, 0, 1));
+
+    // Scan of sectors read once doesn't evict it
+    for(uint32_t sector = 3; sector < SECTOR_CACHE_TEST_DISK_SECTORS; sector += 2) {
+        mu_check(sector_cache_read(cache, data, sector, 1));
+    }
+
+    uint32_t reads = disk.reads;
+    mu_check(sector_cache_read(cache, data, 0, 1));
+    mu_check(sector_cache_test_check(data, 0));
+    mu_assert_int_eq(reads, disk.reads);
+
+    free(data);
+    sector_cache_test_free(cache, &disk);
+}
+
+MU_TEST(test_sector_cache_write_back) {
+    SectorCacheTestDisk disk;
+    SectorCache* cache = sector_cache_test_alloc(&disk);
+    uint8_t* data = malloc(SECTOR_CACHE_SECTOR_SIZE * 4);
+
+    sector_cache_set_write_back_range(cache, 4, 8);
+
+    // Writes inside the range stay in cache
+    memset(data, 0xA5, SECTOR_CACHE_SECTOR_SIZE);
+    mu_check(sector_cache_write(cache, data, 5, 1));
+    memset(data, 0x5A, SECTOR_CACHE_SECTOR_SIZE);
+    mu_check(sector_cache_write(cache, data, 5, 1));
+    memset(data, 0xC3, SECTOR_CACHE_SECTOR_SIZE);
+    mu_check(sector_cache_write(cache, data, 6, 1));
+    mu_assert_int_eq(0, disk.writes);
+    mu_check(sector_cache_test_check(&disk.data[5 * SECTOR_CACHE_SECTOR_SIZE], 5));
+
+    // Reads see deferred data, multi-sector ones too
+    mu_check(sector_cache_read(cache, data, 5, 1));
+    mu_check(sector_cache_test_check(data, 0x5A));
+    mu_check(sector_cache_read(cache, data, 4, 4));
+    mu_check(sector_cache_test_check(&data[0 * SECTOR_CACHE_SECTOR_SIZE], 4));
+    mu_check(sector_cache_test_check(&data[1 * SECTOR_CACHE_SECTOR_SIZE], 0x5A));
+    mu_check(sector_cache_test_check(&data[2 * SECTOR_CACHE_SECTOR_SIZE], 0xC3));
+    mu_check(sector_cache_test_check(&data[3 * SECTOR_CACHE_SECTOR_SIZE], 7));
+
+    // Writes outside the range go to the disk
+    memset(data, 0x3C, SECTOR_CACHE_SECTOR_SIZE);
+    mu_check(sector_cache_write(cache, data, 20, 1));
+    mu_assert_int_eq(1, disk.writes);
+    mu_check(sector_cache_test_check(&disk.data[20 * SECTOR_CACHE_SECTOR_SIZE], 0x3C));
+
+    // Adjacent deferred sectors are flushed with one write
+    mu_check(sector_cache_sync(cache));
+    mu_assert_int_eq(2, disk.writes);
+    mu_check(sector_cache_test_check(&disk.data[5 * SECTOR_CACHE_SECTOR_SIZE], 0x5A));
+    mu_check(sector_cache_test_check(&disk.data[6 * SECTOR_CACHE_SECTOR_SIZE], 0xC3));
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(3, stats.writes_deferred);
+    mu_assert_int_eq(2, stats.writes_flushed);
+
+    free(data);
+    sector_cache_test_free(cache, &disk);
+}
+
+MU_TEST_SUITE(test_sector_cache) {
+    MU_RUN_TEST(test_sector_cache_read_ahead);
+    MU_RUN_TEST(test_sector_cache_read_ahead_disk_end);
+    MU_RUN_TEST(test_sector_cache_scan_resistance);
+    MU_RUN_TEST(test_sector_cache_write_back);
+}
+
+#define STORAGE_BATCH_DIR UNIT_TESTS_PATH("batch_dir")
+#define STORAGE_BATCH_FILES (5000)
+#define STORAGE_BATCH_SIZE (16)
+#define STORAGE_BATCH_NAME_LENGTH (32)
+
+static void storage_batch_create_files(Storage* storage) {
+    FuriString* path = furi_string_alloc();
+    File* file = storage_file_alloc(storage);
+
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR);
+    storage_simply_mkdir(storage, STORAGE_BATCH_DIR);
+    for(size_t i = 0; i < STORAGE_BATCH_FILES; i++) {
+        furi_string_printf(path, "%s/%04u.test", STORAGE_BATCH_DIR, i);
+        storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS);
+        storage_file_write(file, &i, i % sizeof(i));
+        storage_file_close(file);
+    }
+
+    storage_file_free(file);
+    furi_string_free(path);
+}
+
+MU_TEST(test_storage_dir_read_batch) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    storage_batch_create_files(storage);
+
+    FileInfo* fileinfos = malloc(sizeof(FileInfo) * STORAGE_BATCH_SIZE);
+    char* names = malloc(STORAGE_BATCH_NAME_LENGTH * STORAGE_BATCH_SIZE);
+
+    size_t single = 0;
+    uint32_t single_ticks = furi_get_tick();
+    mu_check(storage_dir_open(dir, STORAGE_BATCH_DIR));
+    while(storage_dir_read(dir, &fileinfos[0], names, STORAGE_BATCH_NAME_LENGTH)) {
+        single++;
+    }
+    storage_dir_close(dir);
+    single_ticks = furi_get_tick() - single_ticks;
+
+    size_t batched = 0;
+    size_t size_errors = 0;
+    uint32_t batched_ticks = furi_get_tick();
+    mu_check(storage_dir_open(dir, STORAGE_BATCH_DIR));
+    size_t read;
+    do {
+        read = storage_dir_read_batch(
+            dir, fileinfos, names, STORAGE_BATCH_NAME_LENGTH, STORAGE_BATCH_SIZE);
+        for(size_t i = 0; i < read; i++) {
+            const char* name = &names[i * STORAGE_BATCH_NAME_LENGTH];
+            if(fileinfos[i].size != strtoul(name, NULL, 10) % sizeof(size_t)) size_errors++;
+        }
+        batched += read;
+    } while(read == STORAGE_BATCH_SIZE);
+    storage_dir_close(dir);
+    batched_ticks = furi_get_tick() - batched_ticks;
+
+    FURI_LOG_I(
+        TAG,
+        "Dir read: %lu entries/s single, %lu entries/s batched",
+        single * 1000 / MAX(single_ticks, 1UL),
+        batched * 1000 / MAX(batched_ticks, 1UL));
+
+    mu_assert_int_eq(STORAGE_BATCH_FILES, single);
+    mu_assert_int_eq(STORAGE_BATCH_FILES, batched);
+    mu_assert_int_eq(0, size_errors);
+
+    free(names);
+    free(fileinfos);
+    storage_file_free(dir);
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_storage_stat_batch) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(storage_simply_mkdir(storage, STORAGE_TEST_DIR));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/stat.test", "stat"));
+
+    const char* const paths[] = {
+        STORAGE_TEST_DIR,
+        STORAGE_TEST_DIR "/stat.test",
+        STORAGE_TEST_DIR "/missing.test",
+    };
+    FileInfo fileinfos[COUNT_OF(paths)];
+    FS_Error errors[COUNT_OF(paths)];
+
+    mu_assert_int_eq(
+        2, storage_common_stat_batch(storage, paths, fileinfos, errors, COUNT_OF(paths)));
+    mu_assert_int_eq(FSE_OK, errors[0]);
+    mu_check(file_info_is_dir(&fileinfos[0]));
+    mu_assert_int_eq(FSE_OK, errors[1]);
+    mu_check(!file_info_is_dir(&fileinfos[1]));
+    mu_assert_int_eq(4, fileinfos[1].size);
+    mu_assert_int_eq(FSE_NOT_EXIST, errors[2]);
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_TEST_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_storage_file_readv_writev) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = UNIT_TESTS_PATH("iov.test");
+
+    char head[] = "Flipper";
+    char tail[] = " Zero";
+    const StorageIoVec write_iov[] = {
+        {.buff = head, .size = strlen(head)},
+        {.buff = tail, .size = strlen(tail)},
+    };
+    mu_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(12, storage_file_writev(file, write_iov, COUNT_OF(write_iov)));
+    storage_file_close(file);
+
+    char first[5] = {0};
+    char second[16] = {0};
+    const StorageIoVec read_iov[] = {
+        {.buff = first, .size = sizeof(first) - 1},
+        {.buff = second, .size = sizeof(second) - 1},
+    };
+    mu_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_assert_int_eq(12, storage_file_readv(file, read_iov, COUNT_OF(read_iov)));
+    storage_file_close(file);
+    mu_assert_string_eq("Flip", first);
+    mu_assert_string_eq("per Zero", second);
+
+    storage_file_free(file);
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, path));
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_request_test_callback(StorageRequest* request, void* context) {
+    UNUSED(request);
+    furi_semaphore_release(context);
+}
+
+MU_TEST(test_storage_request_submit) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriSemaphore* done = furi_semaphore_alloc(2, 0);
+
+    const char* const paths[] = {EXT_PATH("unit_tests"), UNIT_TESTS_PATH("missing.test")};
+    FileInfo fileinfos[COUNT_OF(paths)];
+    StorageRequest requests[COUNT_OF(paths)];
+    for(size_t i = 0; i < COUNT_OF(paths); i++) {
+        requests[i] = (StorageRequest){
+            .type = StorageRequestTypeStat,
+            .stat = {.paths = &paths[i], .fileinfos = &fileinfos[i], .count = 1},
+            .callback = storage_request_test_callback,
+            .context = done,
+        };
+        storage_request_submit(storage, &requests[i]);
+    }
+
+    for(size_t i = 0; i < COUNT_OF(paths); i++) {
+        mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(done, 1000));
+    }
+    mu_assert_int_eq(1, requests[0].result);
+    mu_check(file_info_is_dir(&fileinfos[0]));
+    mu_assert_int_eq(0, requests[1].result);
+
+    furi_semaphore_free(done);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_storage_batch) {
+    MU_RUN_TEST(test_storage_stat_batch);
+    MU_RUN_TEST(test_storage_file_readv_writev);
+    MU_RUN_TEST(test_storage_request_submit);
+    MU_RUN_TEST(test_storage_dir_read_batch);
+}
+
 MU_TEST_SUITE(test_data_path) {
     MU_RUN_TEST(test_storage_data_path);
     MU_RUN_TEST(test_storage_data_path_apps);
 }
 
+MU_TEST(test_storage_common_dir_timestamp) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(storage_simply_mkdir(storage, STORAGE_TEST_DIR));
+
+    uint32_t created = 0, modified = 0;
+    mu_assert_int_eq(FSE_OK, storage_common_timestamp(storage, STORAGE_TEST_DIR, &created));
+
+    // FAT timestamps have 2 second resolution
+    furi_delay_ms(2100);
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/timestamp.test", "data"));
+    mu_assert_int_eq(FSE_OK, storage_common_timestamp(storage, STORAGE_TEST_DIR, &modified));
+    mu_check(modified > created);
+
+    furi_delay_ms(2100);
+    created = modified;
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_TEST_DIR "/timestamp.test"));
+    mu_assert_int_eq(FSE_OK, storage_common_timestamp(storage, STORAGE_TEST_DIR, &modified));
+    mu_check(modified > created);
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_TEST_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_storage_common) {
     MU_RUN_TEST(test_storage_common_migrate);
+    MU_RUN_TEST(test_storage_common_dir_timestamp);
 }
 
 MU_TEST_SUITE(test_md5_calc_suite) {
     MU_RUN_TEST(test_md5_calc);
 }
 
+MU_TEST_SUITE(test_delta_sync_suite) {
+    MU_RUN_TEST(test_delta_sync);
+}
+
 int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_file_64k);
@@ -710,6 +1240,9 @@ int run_minunit_test_storage(void) {
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
     MU_RUN_SUITE(test_md5_calc_suite);
+    MU_RUN_SUITE(test_delta_sync_suite);
+    MU_RUN_SUITE(test_sector_cache);
+    MU_RUN_SUITE(test_storage_batch);
     return MU_EXIT_CODE;
 }
 
@@ -5,7 +5,10 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_bin.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/math.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
@@ -17,6 +20,10 @@
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_RANDOM_BIN_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw_bin.sub")
+#define TEST_RANDOM_TEXT_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw_text.sub")
+#define TEST_KEYSTORE_BENCH_DIR_NAME EXT_PATH("unit_tests/subghz/keystore_bench.txt")
+#define TEST_KEYSTORE_BENCH_REPEAT 16
 #define TEST_TIMEOUT 10000
 
 static SubGhzEnvironment* environment_handler;
@@ -116,6 +123,8 @@ static bool subghz_decode_random_test(const char* path) {
         furi_delay_ms(100);
 
         LevelDuration level_duration;
+        uint32_t decode_cycles = 0;
+        uint32_t decode_count = 0;
         while(furi_get_tick() - test_start < TEST_TIMEOUT * 10) {
             level_duration =
                 subghz_file_encoder_worker_get_level_duration(file_worker_encoder_handler);
@@ -124,11 +133,21 @@ static bool subghz_decode_random_test(const char* path) {
                 uint32_t duration = level_duration_get_duration(level_duration);
                 // Yield, to load data inside the worker
                 furi_thread_yield();
+                uint32_t decode_start = DWT->CYCCNT;
                 subghz_receiver_decode(receiver_handler, level, duration);
+                decode_cycles += DWT->CYCCNT - decode_start;
+                decode_count++;
             } else {
                 break;
             }
         }
+        if(decode_count) {
+            FURI_LOG_I(
+                TAG,
+                "Receiver decode: %lu pulses, %lu cycles per pulse",
+                decode_count,
+                decode_cycles / decode_count);
+        }
         furi_delay_ms(10);
         if(subghz_file_encoder_worker_is_running(file_worker_encoder_handler)) {
             subghz_file_encoder_worker_stop(file_worker_encoder_handler);
@@ -214,6 +233,122 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+static bool subghz_keystore_bench_write(const char* path, size_t key_count, uint64_t match_key) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_always(fff_file, path)) break;
+        if(!flipper_format_write_header_cstr(fff_file, "Flipper SubGhz Keystore File", 0)) break;
+        uint32_t encryption = 0;
+        if(!flipper_format_write_uint32(fff_file, "Encryption", &encryption, 1)) break;
+
+        // Matching key goes last, so uncached lookup has to walk the whole keystore
+        Stream* stream = flipper_format_get_raw_stream(fff_file);
+        result = true;
+        for(size_t i = 0; i < key_count && result; i++) {
+            uint64_t key = (i == key_count - 1) ? match_key : ((uint64_t)i << 32 | ~i);
+            uint16_t type = (i == key_count - 1) ? KEELOQ_LEARNING_NORMAL :
+                                                   (KEELOQ_LEARNING_SIMPLE + i % 3);
+            result = stream_write_format(
+                         stream,
+                         "%08lX%08lX:%hu:Bench%zu\n",
+                         (uint32_t)(key >> 32),
+                         (uint32_t)key,
+                         type,
+                         i) > 0;
+        }
+    } while(false);
+
+    flipper_format_free(fff_file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool subghz_keystore_bench_run(size_t key_count) {
+    const uint64_t match_key = 0x0123456789ABCDEF;
+    const uint32_t serial = 0x0ABCDEF;
+    const uint8_t btn = 0x2;
+
+    if(!subghz_keystore_bench_write(TEST_KEYSTORE_BENCH_DIR_NAME, key_count, match_key)) {
+        return false;
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    FlipperFormat* fff_data = flipper_format_string_alloc();
+    FuriString* text = furi_string_alloc();
+    bool result = false;
+
+    do {
+        if(!subghz_environment_load_keystore(environment, TEST_KEYSTORE_BENCH_DIR_NAME)) break;
+
+        uint64_t man =
+            subghz_protocol_keeloq_common_normal_learning(btn << 28 | serial, match_key);
+        uint32_t hop = subghz_protocol_keeloq_common_encrypt(
+            (uint32_t)btn << 28 | (serial & 0xFF) << 16 | 0x0042, man);
+        uint64_t key = subghz_protocol_blocks_reverse_key(
+            (uint64_t)((uint32_t)btn << 28 | serial) << 32 | hop, 64);
+        uint8_t key_data[sizeof(uint64_t)];
+        for(size_t i = 0; i < sizeof(uint64_t); i++) {
+            key_data[sizeof(uint64_t) - i - 1] = (key >> (i * 8)) & 0xFF;
+        }
+        uint32_t bit = 64;
+        flipper_format_write_uint32(fff_data, "Bit", &bit, 1);
+        flipper_format_write_hex(fff_data, "Key", key_data, sizeof(uint64_t));
+        if(subghz_protocol_decoder_base_deserialize(decoder, fff_data) != SubGhzProtocolStatusOk) {
+            break;
+        }
+
+        // First parcel resolves manufacture by full keystore walk, repeats hit the cache
+        uint32_t cold_time = 0;
+        uint32_t warm_time = 0;
+        result = true;
+        for(size_t i = 0; i < TEST_KEYSTORE_BENCH_REPEAT && result; i++) {
+            subghz_environment_reset_keeloq(environment);
+            uint32_t start = DWT->CYCCNT;
+            subghz_protocol_decoder_base_get_string(decoder, text);
+            uint32_t time = DWT->CYCCNT - start;
+            if(i == 0) {
+                cold_time = time;
+            } else {
+                warm_time += time;
+            }
+            result = furi_string_search_str(text, "Bench") != FURI_STRING_FAILURE;
+        }
+        warm_time /= TEST_KEYSTORE_BENCH_REPEAT - 1;
+
+        FURI_LOG_I(
+            TAG,
+            "Keystore %zu keys: cold %luus, warm %luus",
+            key_count,
+            cold_time / furi_hal_cortex_instructions_per_microsecond(),
+            warm_time / furi_hal_cortex_instructions_per_microsecond());
+    } while(false);
+
+    furi_string_free(text);
+    flipper_format_free(fff_data);
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_KEYSTORE_BENCH_DIR_NAME);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+MU_TEST(subghz_keystore_keeloq_lookup_test) {
+    mu_assert(subghz_keystore_bench_run(100), "Keystore 100 keys lookup error");
+    // Loaded keystore is kept in one array, bigger ones don't fit into the heap
+    mu_assert(subghz_keystore_bench_run(1000), "Keystore 1000 keys lookup error");
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -830,9 +965,44 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+MU_TEST(subghz_random_bin_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    mu_assert(
+        subghz_raw_bin_convert_file(
+            storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_BIN_DIR_NAME, true),
+        "Convert to binary error\r\n");
+    mu_assert(
+        subghz_raw_bin_convert_file(
+            storage, TEST_RANDOM_BIN_DIR_NAME, TEST_RANDOM_TEXT_DIR_NAME, false),
+        "Convert to text error\r\n");
+
+    FileInfo text_info;
+    FileInfo bin_info;
+    mu_assert(
+        storage_common_stat(storage, TEST_RANDOM_DIR_NAME, &text_info) == FSE_OK,
+        "Stat text error\r\n");
+    mu_assert(
+        storage_common_stat(storage, TEST_RANDOM_BIN_DIR_NAME, &bin_info) == FSE_OK,
+        "Stat binary error\r\n");
+    FURI_LOG_I(TAG, "RAW text %llu bytes, binary %llu bytes", text_info.size, bin_info.size);
+    mu_assert(bin_info.size * 2 < text_info.size, "Binary RAW is not compact\r\n");
+
+    mu_assert(
+        subghz_decode_random_test(TEST_RANDOM_BIN_DIR_NAME), "Random binary test error\r\n");
+    mu_assert(
+        subghz_decode_random_test(TEST_RANDOM_TEXT_DIR_NAME),
+        "Random converted text test error\r\n");
+
+    storage_simply_remove(storage, TEST_RANDOM_BIN_DIR_NAME);
+    storage_simply_remove(storage, TEST_RANDOM_TEXT_DIR_NAME);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_keeloq_lookup_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -907,6 +1077,7 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_acurite_592txr_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_random_bin_test);
     subghz_test_deinit();
 }
 
@@ -5,9 +5,12 @@
 #include <FreeRTOS-Kernel/include/queue.h>
 #include <task.h>
 
+#include <subghz/protocols/keeloq_common.h>
+
 #include <rpc/rpc_i.h>
 #include <flipper.pb.h>
 #include <core/event_loop.h>
+#include <sector_cache.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -18,6 +21,12 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
+    API_METHOD(rpc_session_set_max_data_size, void, (RpcSession*, size_t)),
+    API_METHOD(subghz_protocol_keeloq_common_encrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_normal_learning,
+        uint64_t,
+        (uint32_t, const uint64_t)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(
         xTaskGenericNotify,
@@ -46,4 +55,15 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(furi_event_loop_message_queue_unsubscribe, void, (FuriEventLoop*, FuriMessageQueue*)),
     API_METHOD(furi_event_loop_run, void, (FuriEventLoop*)),
     API_METHOD(furi_event_loop_stop, void, (FuriEventLoop*)),
+    API_METHOD(
+        sector_cache_alloc,
+        SectorCache*,
+        (const SectorCacheConfig*, SectorCacheReadCallback, SectorCacheWriteCallback, void*)),
+    API_METHOD(sector_cache_free, void, (SectorCache*)),
+    API_METHOD(sector_cache_read, bool, (SectorCache*, uint8_t*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_write, bool, (SectorCache*, const uint8_t*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_sync, bool, (SectorCache*)),
+    API_METHOD(sector_cache_set_write_back_range, void, (SectorCache*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_set_disk_sectors, void, (SectorCache*, uint32_t)),
+    API_METHOD(sector_cache_get_stats, void, (SectorCache*, SectorCacheStats*)),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
@@ -146,8 +146,8 @@ bool archive_favorites_read(void* context) {
                     need_refresh = true;
                 }
             } else {
-                if(storage_common_exists(storage, furi_string_get_cstr(buffer))) {
-                    storage_common_stat(storage, furi_string_get_cstr(buffer), &file_info);
+                if(storage_common_stat(storage, furi_string_get_cstr(buffer), &file_info) ==
+                   FSE_OK) {
                     archive_add_file_item(
                         browser, file_info_is_dir(&file_info), furi_string_get_cstr(buffer));
                     file_count++;
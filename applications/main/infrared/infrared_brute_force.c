@@ -2,10 +2,25 @@
 
 #include <stdlib.h>
 #include <m-dict.h>
+#include <m-array.h>
+#include <furi_hal_rtc.h>
+#include <storage/storage.h>
+#include <toolbox/path.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+#define INFRARED_BRUTE_FORCE_INDEX_FOLDER EXT_PATH("infrared/.cache")
+#define INFRARED_BRUTE_FORCE_INDEX_EXT ".idx"
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC (0x58444952UL) // "RIDX"
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION (1UL)
+#define INFRARED_BRUTE_FORCE_INDEX_NAME_MAX (255U)
+#define INFRARED_BRUTE_FORCE_INDEX_NONE (UINT32_MAX)
+#define INFRARED_BRUTE_FORCE_INDEX_MTIME_WINDOW (3U) // FAT timestamps have 2 second resolution
+
 typedef struct {
     uint32_t index;
     uint32_t count;
@@ -18,12 +33,38 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+/*
+ * Location of a signal body in the database file.
+ *
+ * While the index is being built or loaded, id refers to the signal name table.
+ * Once resolved, id holds the index of the record the signal belongs to.
+ */
+typedef struct {
+    uint32_t id;
+    uint32_t offset;
+} InfraredBruteForceSignal;
+
+ARRAY_DEF(InfraredBruteForceSignalArray, InfraredBruteForceSignal, M_POD_OPLIST);
+ARRAY_DEF(InfraredBruteForceNameArray, FuriString*, FURI_STRING_OPLIST);
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_timestamp;
+    uint32_t name_count;
+    uint32_t signal_count;
+} InfraredBruteForceIndexHeader;
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
     FuriString* current_record_name;
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
+    InfraredBruteForceSignalArray_t signals;
+    size_t current_signal_pos;
+    uint32_t current_record_index;
     bool is_started;
 };
 
@@ -35,11 +76,13 @@ InfraredBruteForce* infrared_brute_force_alloc(void) {
     brute_force->is_started = false;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
+    InfraredBruteForceSignalArray_init(brute_force->signals);
     return brute_force;
 }
 
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    InfraredBruteForceSignalArray_clear(brute_force->signals);
     InfraredBruteForceRecordDict_clear(brute_force->records);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
@@ -50,13 +93,49 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(!brute_force->is_started);
-    furi_assert(brute_force->db_filename);
+static void infrared_brute_force_get_index_path(const char* db_filename, FuriString* index_path) {
+    FuriString* db_path = furi_string_alloc_set(db_filename);
+    FuriString* db_name = furi_string_alloc();
+
+    path_extract_filename(db_path, db_name, false);
+    furi_string_printf(
+        index_path,
+        "%s/%s%s",
+        INFRARED_BRUTE_FORCE_INDEX_FOLDER,
+        furi_string_get_cstr(db_name),
+        INFRARED_BRUTE_FORCE_INDEX_EXT);
+
+    furi_string_free(db_name);
+    furi_string_free(db_path);
+}
+
+static uint32_t
+    infrared_brute_force_get_name_id(InfraredBruteForceNameArray_t names, FuriString* name) {
+    uint32_t name_id = 0;
+
+    for
+        M_EACH(item, names, InfraredBruteForceNameArray_t) {
+            if(furi_string_equal(*item, name)) return name_id;
+            ++name_id;
+        }
+
+    InfraredBruteForceNameArray_push_back(names, name);
+    return name_id;
+}
+
+/*
+ * Read every signal in the database, validating it and remembering
+ * where its body starts so that it can be parsed again without a search.
+ */
+static bool infrared_brute_force_scan_db(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceNameArray_t names,
+    InfraredBruteForceSignalArray_t signals) {
     bool success = false;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    Stream* stream = flipper_format_get_raw_stream(ff);
     FuriString* signal_name = furi_string_alloc();
     InfraredSignal* signal = infrared_signal_alloc();
 
@@ -65,15 +144,14 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
 
         bool signals_valid = false;
         while(infrared_signal_read_name(ff, signal_name)) {
+            const uint32_t offset = stream_tell(stream);
             signals_valid = infrared_signal_read_body(signal, ff) &&
                             infrared_signal_is_valid(signal);
             if(!signals_valid) break;
 
-            InfraredBruteForceRecord* record =
-                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
-            if(record) { //-V547
-                ++(record->count);
-            }
+            InfraredBruteForceSignal* item = InfraredBruteForceSignalArray_push_new(signals);
+            item->id = infrared_brute_force_get_name_id(names, signal_name);
+            item->offset = offset;
         }
 
         if(!signals_valid) break;
@@ -82,8 +160,208 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
 
     infrared_signal_free(signal);
     furi_string_free(signal_name);
-
     flipper_format_free(ff);
+
+    return success;
+}
+
+static bool infrared_brute_force_load_index(
+    Storage* storage,
+    const char* index_path,
+    const FileInfo* db_info,
+    uint32_t db_timestamp,
+    InfraredBruteForceNameArray_t names,
+    InfraredBruteForceSignalArray_t signals) {
+    bool success = false;
+
+    File* file = storage_file_alloc(storage);
+    FuriString* name = furi_string_alloc();
+    char name_buf[INFRARED_BRUTE_FORCE_INDEX_NAME_MAX + 1];
+
+    do {
+        if(!storage_file_open(file, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        InfraredBruteForceIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != INFRARED_BRUTE_FORCE_INDEX_MAGIC) break;
+        if(header.version != INFRARED_BRUTE_FORCE_INDEX_VERSION) break;
+        if(header.db_size != db_info->size || header.db_timestamp != db_timestamp) break;
+        if(header.name_count > header.signal_count || header.signal_count > header.db_size) break;
+
+        bool names_valid = true;
+        for(uint32_t i = 0; i < header.name_count; ++i) {
+            uint8_t name_size;
+            names_valid = storage_file_read(file, &name_size, 1) == 1 &&
+                          storage_file_read(file, name_buf, name_size) == name_size;
+            if(!names_valid) break;
+
+            name_buf[name_size] = '\0';
+            furi_string_set(name, name_buf);
+            InfraredBruteForceNameArray_push_back(names, name);
+        }
+
+        if(!names_valid) break;
+
+        const size_t signals_size = header.signal_count * sizeof(InfraredBruteForceSignal);
+        if(signals_size) {
+            InfraredBruteForceSignalArray_resize(signals, header.signal_count);
+            void* signals_data = InfraredBruteForceSignalArray_get(signals, 0);
+            if(storage_file_read(file, signals_data, signals_size) != signals_size) break;
+        }
+
+        bool ids_valid = true;
+        for
+            M_EACH(item, signals, InfraredBruteForceSignalArray_t) {
+                ids_valid = item->id < header.name_count && item->offset < db_info->size;
+                if(!ids_valid) break;
+            }
+
+        success = ids_valid;
+    } while(false);
+
+    if(!success) {
+        InfraredBruteForceNameArray_reset(names);
+        InfraredBruteForceSignalArray_reset(signals);
+    }
+
+    furi_string_free(name);
+    storage_file_free(file);
+
+    return success;
+}
+
+static void infrared_brute_force_save_index(
+    Storage* storage,
+    const char* index_path,
+    const FileInfo* db_info,
+    uint32_t db_timestamp,
+    InfraredBruteForceNameArray_t names,
+    InfraredBruteForceSignalArray_t signals) {
+    const InfraredBruteForceIndexHeader header = {
+        .magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC,
+        .version = INFRARED_BRUTE_FORCE_INDEX_VERSION,
+        .db_size = db_info->size,
+        .db_timestamp = db_timestamp,
+        .name_count = InfraredBruteForceNameArray_size(names),
+        .signal_count = InfraredBruteForceSignalArray_size(signals),
+    };
+
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_simply_mkdir(storage, INFRARED_BRUTE_FORCE_INDEX_FOLDER)) break;
+        if(!storage_file_open(file, index_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        bool names_written = true;
+        for
+            M_EACH(name, names, InfraredBruteForceNameArray_t) {
+                const size_t name_size = furi_string_size(*name);
+                const uint8_t name_size_byte = name_size;
+                names_written = name_size <= INFRARED_BRUTE_FORCE_INDEX_NAME_MAX &&
+                                storage_file_write(file, &name_size_byte, 1) == 1 &&
+                                storage_file_write(file, furi_string_get_cstr(*name), name_size) ==
+                                    name_size;
+                if(!names_written) break;
+            }
+
+        if(!names_written) break;
+
+        const size_t signals_size = header.signal_count * sizeof(InfraredBruteForceSignal);
+        if(signals_size) {
+            const void* signals_data = InfraredBruteForceSignalArray_cget(signals, 0);
+            if(storage_file_write(file, signals_data, signals_size) != signals_size) break;
+        }
+
+        success = true;
+    } while(false);
+
+    storage_file_free(file);
+
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to save index %s", index_path);
+        storage_simply_remove(storage, index_path);
+    }
+}
+
+/*
+ * Keep only the signals that belong to a known record,
+ * replacing name ids with record indices and counting the signals per record.
+ */
+static void infrared_brute_force_resolve_signals(
+    InfraredBruteForce* brute_force,
+    InfraredBruteForceNameArray_t names,
+    InfraredBruteForceSignalArray_t signals) {
+    InfraredBruteForceSignalArray_reset(brute_force->signals);
+
+    const size_t name_count = InfraredBruteForceNameArray_size(names);
+    if(!name_count) return;
+
+    InfraredBruteForceRecord** name_records =
+        malloc(name_count * sizeof(InfraredBruteForceRecord*));
+
+    for(size_t i = 0; i < name_count; ++i) {
+        name_records[i] = InfraredBruteForceRecordDict_get(
+            brute_force->records, *InfraredBruteForceNameArray_cget(names, i));
+    }
+
+    for
+        M_EACH(item, signals, InfraredBruteForceSignalArray_t) {
+            InfraredBruteForceRecord* record = name_records[item->id];
+            if(record) {
+                ++(record->count);
+                InfraredBruteForceSignal* resolved =
+                    InfraredBruteForceSignalArray_push_new(brute_force->signals);
+                resolved->id = record->index;
+                resolved->offset = item->offset;
+            }
+        }
+
+    free(name_records);
+}
+
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(!brute_force->is_started);
+    furi_assert(brute_force->db_filename);
+    bool success = false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* index_path = furi_string_alloc();
+    InfraredBruteForceNameArray_t names;
+    InfraredBruteForceSignalArray_t signals;
+    InfraredBruteForceNameArray_init(names);
+    InfraredBruteForceSignalArray_init(signals);
+
+    do {
+        FileInfo db_info;
+        uint32_t db_timestamp;
+        if(storage_common_stat(storage, brute_force->db_filename, &db_info) != FSE_OK) break;
+        // Modification time of the database file itself, the index lives in another folder
+        if(storage_common_timestamp(storage, brute_force->db_filename, &db_timestamp) != FSE_OK)
+            break;
+
+        infrared_brute_force_get_index_path(brute_force->db_filename, index_path);
+        const char* index_path_cstr = furi_string_get_cstr(index_path);
+
+        if(!infrared_brute_force_load_index(
+               storage, index_path_cstr, &db_info, db_timestamp, names, signals)) {
+            if(!infrared_brute_force_scan_db(brute_force, storage, names, signals)) break;
+            // Database changed just now may change again without a visible timestamp change
+            if(furi_hal_rtc_get_timestamp() - db_timestamp >=
+               INFRARED_BRUTE_FORCE_INDEX_MTIME_WINDOW) {
+                infrared_brute_force_save_index(
+                    storage, index_path_cstr, &db_info, db_timestamp, names, signals);
+            }
+        }
+
+        infrared_brute_force_resolve_signals(brute_force, names, signals);
+        success = true;
+    } while(false);
+
+    InfraredBruteForceSignalArray_clear(signals);
+    InfraredBruteForceNameArray_clear(names);
+    furi_string_free(index_path);
     furi_record_close(RECORD_STORAGE);
     return success;
 }
@@ -114,6 +392,8 @@ bool infrared_brute_force_start(
         Storage* storage = furi_record_open(RECORD_STORAGE);
         brute_force->ff = flipper_format_buffered_file_alloc(storage);
         brute_force->current_signal = infrared_signal_alloc();
+        brute_force->current_signal_pos = 0;
+        brute_force->current_record_index = index;
         brute_force->is_started = true;
         success =
             flipper_format_buffered_file_open_existing(brute_force->ff, brute_force->db_filename);
@@ -139,10 +419,20 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_by_name_and_read(
-        brute_force->current_signal,
-        brute_force->ff,
-        furi_string_get_cstr(brute_force->current_record_name));
+    bool success = false;
+
+    const size_t signal_count = InfraredBruteForceSignalArray_size(brute_force->signals);
+    while(brute_force->current_signal_pos < signal_count) {
+        const InfraredBruteForceSignal* item = InfraredBruteForceSignalArray_cget(
+            brute_force->signals, brute_force->current_signal_pos++);
+        if(item->id != brute_force->current_record_index) continue;
+
+        Stream* stream = flipper_format_get_raw_stream(brute_force->ff);
+        success = stream_seek(stream, item->offset, StreamOffsetFromStart) &&
+                  infrared_signal_read_body(brute_force->current_signal, brute_force->ff);
+        break;
+    }
+
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
     }
@@ -163,4 +453,5 @@ void infrared_brute_force_add_record(
 void infrared_brute_force_reset(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_reset(brute_force->records);
+    InfraredBruteForceSignalArray_reset(brute_force->signals);
 }
@@ -44,6 +44,11 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
  * This function must be called each time after setting the database via
  * a infrared_brute_force_set_db_filename() call.
  *
+ * The file offset of every signal is recorded, so that infrared_brute_force_send_next()
+ * can seek directly to the next signal instead of searching for it. The offsets are
+ * also saved to an index file in /ext/infrared/.cache, which is reused for as long
+ * as the database size and modification time stay the same.
+ *
  * @param[in,out] brute_force pointer to the instance to be updated.
  * @returns true on success, false otherwise.
  */
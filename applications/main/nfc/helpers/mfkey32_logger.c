@@ -171,3 +171,40 @@ void mfkey32_logger_get_params_data(Mfkey32Logger* instance, FuriString* str) {
         furi_string_cat_printf(str, "Sector %d, key %c\n", params->sector_num, key_char);
     }
 }
+
+bool mfkey32_logger_get_nonces(
+    Mfkey32Logger* instance,
+    size_t index,
+    Mfkey32Nonces* nonces,
+    uint8_t* sector_num,
+    MfClassicKeyType* key_type) {
+    furi_assert(instance);
+    furi_assert(nonces);
+    furi_assert(sector_num);
+    furi_assert(key_type);
+
+    bool nonces_found = false;
+    Mfkey32LoggerParams_it_t it;
+    for(Mfkey32LoggerParams_it(it, instance->params_arr); !Mfkey32LoggerParams_end_p(it);
+        Mfkey32LoggerParams_next(it)) {
+        Mfkey32LoggerParams* params = Mfkey32LoggerParams_ref(it);
+        if(!params->is_filled) continue;
+        if(index--) continue;
+
+        *nonces = (Mfkey32Nonces){
+            .cuid = params->cuid,
+            .nt0 = params->nt0,
+            .nr0 = params->nr0,
+            .ar0 = params->ar0,
+            .nt1 = params->nt1,
+            .nr1 = params->nr1,
+            .ar1 = params->ar1,
+        };
+        *sector_num = params->sector_num;
+        *key_type = params->key_type;
+        nonces_found = true;
+        break;
+    }
+
+    return nonces_found;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nfc/protocols/mf_classic/mf_classic.h>
+#include <nfc/helpers/mfkey32.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +21,13 @@ bool mfkey32_logger_save_params(Mfkey32Logger* instance, const char* path);
 
 void mfkey32_logger_get_params_data(Mfkey32Logger* instance, FuriString* str);
 
+bool mfkey32_logger_get_nonces(
+    Mfkey32Logger* instance,
+    size_t index,
+    Mfkey32Nonces* nonces,
+    uint8_t* sector_num,
+    MfClassicKeyType* key_type);
+
 #ifdef __cplusplus
 }
 #endif
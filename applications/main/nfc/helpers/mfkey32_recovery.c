@@ -0,0 +1,217 @@
+#include "mfkey32_recovery.h"
+#include "mf_classic_key_cache.h"
+
+#include <furi/furi.h>
+#include <bit_lib/bit_lib.h>
+#include <toolbox/keys_dict.h>
+
+#define TAG "Mfkey32Recovery"
+
+#define NFC_APP_FOLDER ANY_PATH("nfc")
+#define NFC_APP_MF_CLASSIC_DICT_USER_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict_user.nfc")
+
+#define MFKEY32_RECOVERY_STACK_SIZE (4 * 1024)
+#define MFKEY32_RECOVERY_TIME_SLICE_MS (100)
+// Memory left for storage and GUI while recovering, more memory means less rounds
+#define MFKEY32_RECOVERY_MEMORY_RESERVE (16 * 1024)
+#define MFKEY32_RECOVERY_MEMORY_MAX (96 * 1024)
+
+typedef enum {
+    Mfkey32RecoveryFlagStop = (1 << 0),
+} Mfkey32RecoveryFlag;
+
+typedef struct {
+    Mfkey32Nonces nonces;
+    uint8_t sector_num;
+    MfClassicKeyType key_type;
+} Mfkey32RecoveryParams;
+
+struct Mfkey32Recovery {
+    Mfkey32RecoveryParams* params;
+    MfClassicData* data;
+    MfClassicKeyCache* key_cache;
+    FuriThread* thread;
+    FuriMutex* mutex;
+    Mfkey32RecoveryState state;
+    Mfkey32RecoveryCallback callback;
+    void* context;
+};
+
+Mfkey32Recovery* mfkey32_recovery_alloc(Mfkey32Logger* logger, const MfClassicData* data) {
+    furi_assert(logger);
+    furi_assert(data);
+
+    Mfkey32Recovery* instance = malloc(sizeof(Mfkey32Recovery));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->key_cache = mf_classic_key_cache_alloc();
+
+    size_t params_num = mfkey32_logger_get_params_num(logger);
+    instance->params = malloc(MAX(params_num, 1U) * sizeof(Mfkey32RecoveryParams));
+    for(size_t i = 0; i < params_num; i++) {
+        Mfkey32RecoveryParams* params = &instance->params[i];
+        furi_check(mfkey32_logger_get_nonces(
+            logger, i, &params->nonces, &params->sector_num, &params->key_type));
+    }
+    instance->state.nonces_total = params_num;
+
+    // Keys already in cache don't need recovery and must stay in cache after saving
+    instance->data = mf_classic_alloc();
+    mf_classic_copy(instance->data, data);
+    size_t uid_len = 0;
+    const uint8_t* uid = mf_classic_get_uid(data, &uid_len);
+    if(mf_classic_key_cache_load(instance->key_cache, uid, uid_len)) {
+        uint8_t sector_num = 0;
+        MfClassicKey key = {};
+        MfClassicKeyType key_type = MfClassicKeyTypeA;
+        while(mf_classic_key_cahce_get_next_key(
+            instance->key_cache, &sector_num, &key, &key_type)) {
+            uint64_t key_num = bit_lib_bytes_to_num_be(key.data, sizeof(MfClassicKey));
+            mf_classic_set_key_found(instance->data, sector_num, key_type, key_num);
+        }
+    }
+
+    return instance;
+}
+
+void mfkey32_recovery_free(Mfkey32Recovery* instance) {
+    furi_assert(instance);
+
+    mfkey32_recovery_stop(instance);
+
+    mf_classic_free(instance->data);
+    mf_classic_key_cache_free(instance->key_cache);
+    furi_mutex_free(instance->mutex);
+    free(instance->params);
+    free(instance);
+}
+
+static void mfkey32_recovery_update(Mfkey32Recovery* instance, Mfkey32RecoveryState* state) {
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->state = *state;
+    Mfkey32RecoveryCallback callback = instance->callback;
+    furi_mutex_release(instance->mutex);
+
+    if(callback) {
+        callback(instance->context);
+    }
+}
+
+static void mfkey32_recovery_save_key(
+    Mfkey32Recovery* instance,
+    const Mfkey32RecoveryParams* params,
+    uint64_t key_num) {
+    MfClassicKey key = {};
+    bit_lib_num_to_bytes_be(key_num, sizeof(MfClassicKey), key.data);
+
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_USER_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    if(!keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey))) {
+        keys_dict_add_key(dict, key.data, sizeof(MfClassicKey));
+    }
+    keys_dict_free(dict);
+
+    mf_classic_set_key_found(instance->data, params->sector_num, params->key_type, key_num);
+    if(!mf_classic_key_cache_save(instance->key_cache, instance->data)) {
+        FURI_LOG_E(TAG, "Failed to save key cache");
+    }
+}
+
+static int32_t mfkey32_recovery_worker(void* context) {
+    Mfkey32Recovery* instance = context;
+    Mfkey32RecoveryState state = instance->state;
+
+    size_t memory = memmgr_heap_get_max_free_block();
+    memory -= MIN(memory, MFKEY32_RECOVERY_MEMORY_RESERVE);
+    memory = MIN(memory, MFKEY32_RECOVERY_MEMORY_MAX);
+    if(memory < MFKEY32_MEMORY_MIN) {
+        FURI_LOG_E(TAG, "Not enough memory: %zu", memory);
+        state.is_running = false;
+        mfkey32_recovery_update(instance, &state);
+        return 0;
+    }
+
+    Mfkey32* mfkey32 = mfkey32_alloc(memory);
+    for(; state.nonces_done < state.nonces_total; state.nonces_done++) {
+        const Mfkey32RecoveryParams* params = &instance->params[state.nonces_done];
+        // Reader may authenticate with the same key several times
+        if(mf_classic_is_key_found(instance->data, params->sector_num, params->key_type)) {
+            continue;
+        }
+
+        state.sector_num = params->sector_num;
+        state.key_type = params->key_type;
+        state.progress = 0;
+        mfkey32_recovery_update(instance, &state);
+
+        uint32_t start = furi_get_tick();
+        mfkey32_start(mfkey32, &params->nonces);
+        Mfkey32Status status = Mfkey32StatusInProgress;
+        while(status == Mfkey32StatusInProgress &&
+              !(furi_thread_flags_get() & Mfkey32RecoveryFlagStop)) {
+            status = mfkey32_run(mfkey32, MFKEY32_RECOVERY_TIME_SLICE_MS);
+            state.progress = mfkey32_get_progress(mfkey32);
+            mfkey32_recovery_update(instance, &state);
+        }
+        if(status == Mfkey32StatusInProgress) break;
+
+        uint64_t key_num = 0;
+        FURI_LOG_I(
+            TAG,
+            "Sector %u key %c: %s in %lu ms",
+            params->sector_num,
+            params->key_type == MfClassicKeyTypeA ? 'A' : 'B',
+            mfkey32_get_key(mfkey32, &key_num) ? "found" : "not found",
+            furi_get_tick() - start);
+        if(status == Mfkey32StatusKeyFound) {
+            mfkey32_recovery_save_key(instance, params, key_num);
+            state.keys_found++;
+        }
+    }
+    mfkey32_free(mfkey32);
+
+    state.is_running = false;
+    mfkey32_recovery_update(instance, &state);
+
+    return 0;
+}
+
+void mfkey32_recovery_start(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryCallback callback,
+    void* context) {
+    furi_assert(instance);
+    furi_assert(instance->thread == NULL);
+
+    instance->callback = callback;
+    instance->context = context;
+    instance->state.is_running = true;
+
+    instance->thread = furi_thread_alloc_ex(
+        TAG, MFKEY32_RECOVERY_STACK_SIZE, mfkey32_recovery_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+}
+
+void mfkey32_recovery_stop(Mfkey32Recovery* instance) {
+    furi_assert(instance);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->callback = NULL;
+    furi_mutex_release(instance->mutex);
+
+    if(instance->thread) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), Mfkey32RecoveryFlagStop);
+        furi_thread_join(instance->thread);
+        furi_thread_free(instance->thread);
+        instance->thread = NULL;
+    }
+}
+
+void mfkey32_recovery_get_state(Mfkey32Recovery* instance, Mfkey32RecoveryState* state) {
+    furi_assert(instance);
+    furi_assert(state);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    *state = instance->state;
+    furi_mutex_release(instance->mutex);
+}
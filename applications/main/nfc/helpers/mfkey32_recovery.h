@@ -0,0 +1,38 @@
+#pragma once
+
+#include "mfkey32_logger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Mfkey32Recovery Mfkey32Recovery;
+
+typedef struct {
+    size_t nonces_total;
+    size_t nonces_done;
+    size_t keys_found;
+    uint8_t sector_num;
+    MfClassicKeyType key_type;
+    uint8_t progress;
+    bool is_running;
+} Mfkey32RecoveryState;
+
+typedef void (*Mfkey32RecoveryCallback)(void* context);
+
+Mfkey32Recovery* mfkey32_recovery_alloc(Mfkey32Logger* logger, const MfClassicData* data);
+
+void mfkey32_recovery_free(Mfkey32Recovery* instance);
+
+void mfkey32_recovery_start(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryCallback callback,
+    void* context);
+
+void mfkey32_recovery_stop(Mfkey32Recovery* instance);
+
+void mfkey32_recovery_get_state(Mfkey32Recovery* instance, Mfkey32RecoveryState* state);
+
+#ifdef __cplusplus
+}
+#endif
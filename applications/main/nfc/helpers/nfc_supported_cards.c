@@ -8,6 +8,10 @@
 #include <flipper_application/plugins/composite_resolver.h>
 #include <loader/firmware_api/firmware_api.h>
 
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include <bit_lib/bit_lib.h>
+
 #include <furi.h>
 #include <path.h>
 #include <m-array.h>
@@ -17,16 +21,39 @@
 #define NFC_SUPPORTED_CARDS_PLUGINS_PATH APP_DATA_PATH("plugins")
 #define NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX "_parser.fal"
 
+#define NFC_SUPPORTED_CARDS_CACHE_FOLDER "/ext/nfc/.cache"
+#define NFC_SUPPORTED_CARDS_CACHE_PATH NFC_SUPPORTED_CARDS_CACHE_FOLDER "/supported_cards"
+#define NFC_SUPPORTED_CARDS_CACHE_MAGIC 0x43435346 // "FSCC"
+#define NFC_SUPPORTED_CARDS_CACHE_VERSION 1
+#define NFC_SUPPORTED_CARDS_CACHE_NAME_SIZE 32
+#define NFC_SUPPORTED_CARDS_FILTER_AIDS_MAX 4
+#define NFC_SUPPORTED_CARDS_FILTER_KEYS_MAX 8
+
 typedef enum {
     NfcSupportedCardsPluginFeatureHasVerify = (1U << 0),
     NfcSupportedCardsPluginFeatureHasRead = (1U << 1),
     NfcSupportedCardsPluginFeatureHasParse = (1U << 2),
 } NfcSupportedCardsPluginFeature;
 
+// Plugin filter as stored in cache, keys are kept as hashes
+typedef struct {
+    uint16_t atqa;
+    uint16_t atqa_mask;
+    uint8_t sak;
+    uint8_t sak_mask;
+    uint8_t aid_count;
+    uint8_t key_sector;
+    uint8_t key_count;
+    uint8_t reserved[3];
+    MfDesfireApplicationId aids[NFC_SUPPORTED_CARDS_FILTER_AIDS_MAX];
+    uint32_t key_hashes[NFC_SUPPORTED_CARDS_FILTER_KEYS_MAX];
+} FURI_PACKED NfcSupportedCardsPluginCacheFilter;
+
 typedef struct {
     FuriString* name;
     NfcProtocol protocol;
     NfcSupportedCardsPluginFeature feature;
+    NfcSupportedCardsPluginCacheFilter filter;
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST);
@@ -38,11 +65,31 @@ typedef enum {
     NfcSupportedCardsLoadStateFail,
 } NfcSupportedCardsLoadState;
 
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t plugin_api_version;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint32_t timestamp; // Plugins directory modification time
+    uint16_t plugin_count;
+    uint16_t record_size;
+} FURI_PACKED NfcSupportedCardsCacheHeader;
+
+typedef struct {
+    char name[NFC_SUPPORTED_CARDS_CACHE_NAME_SIZE];
+    uint8_t protocol;
+    uint8_t feature;
+    uint16_t reserved;
+    NfcSupportedCardsPluginCacheFilter filter;
+} FURI_PACKED NfcSupportedCardsCacheRecord;
+
 typedef struct {
     Storage* storage;
     File* directory;
     char file_name[256];
     FlipperApplication* app;
+    uint32_t plugin_api_version;
 } NfcSupportedCardsLoadContext;
 
 struct NfcSupportedCards {
@@ -64,9 +111,7 @@ NfcSupportedCards* nfc_supported_cards_alloc(void) {
     return instance;
 }
 
-void nfc_supported_cards_free(NfcSupportedCards* instance) {
-    furi_assert(instance);
-
+static void nfc_supported_cards_reset_plugins_cache(NfcSupportedCards* instance) {
     NfcSupportedCardsPluginCache_it_t iter;
     for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
         !NfcSupportedCardsPluginCache_end_p(iter);
@@ -74,6 +119,13 @@ void nfc_supported_cards_free(NfcSupportedCards* instance) {
         NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
         furi_string_free(plugin_cache->name);
     }
+    NfcSupportedCardsPluginCache_reset(instance->plugins_cache_arr);
+}
+
+void nfc_supported_cards_free(NfcSupportedCards* instance) {
+    furi_assert(instance);
+
+    nfc_supported_cards_reset_plugins_cache(instance);
     NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
     composite_api_resolver_free(instance->api_resolver);
@@ -131,8 +183,12 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
         if(descriptor == NULL) break;
 
         if(strcmp(descriptor->appid, NFC_SUPPORTED_CARD_PLUGIN_APP_ID) != 0) break;
-        if(descriptor->ep_api_version != NFC_SUPPORTED_CARD_PLUGIN_API_VERSION) break;
+        // Newer API versions only add fields at the end of the plugin structure
+        if(descriptor->ep_api_version == 0 ||
+           descriptor->ep_api_version > NFC_SUPPORTED_CARD_PLUGIN_API_VERSION)
+            break;
 
+        instance->plugin_api_version = descriptor->ep_api_version;
         plugin = descriptor->entry_point;
     } while(false);
     furi_string_free(plugin_path);
@@ -171,6 +227,198 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
     return plugin;
 }
 
+static uint32_t nfc_supported_cards_key_hash(uint64_t key) {
+    uint32_t hash = 0x811C9DC5; // fnv-1a
+    for(size_t i = 0; i < sizeof(MfClassicKey); i++) {
+        hash = (hash ^ (uint8_t)(key >> (i * 8))) * 0x01000193;
+    }
+    return hash;
+}
+
+static void nfc_supported_cards_set_filter(
+    NfcSupportedCardsPluginCacheFilter* cache_filter,
+    const NfcSupportedCardsPluginFilter* filter) {
+    cache_filter->atqa = filter->atqa;
+    cache_filter->atqa_mask = filter->atqa_mask;
+    cache_filter->sak = filter->sak;
+    cache_filter->sak_mask = filter->sak_mask;
+
+    // Checks that don't fit are skipped, so the plugin is loaded for any card
+    if(filter->aid_count <= NFC_SUPPORTED_CARDS_FILTER_AIDS_MAX) {
+        cache_filter->aid_count = filter->aid_count;
+        memcpy(
+            cache_filter->aids, filter->aids, sizeof(MfDesfireApplicationId) * filter->aid_count);
+    }
+    if(filter->key_count <= NFC_SUPPORTED_CARDS_FILTER_KEYS_MAX) {
+        cache_filter->key_sector = filter->key_sector;
+        cache_filter->key_count = filter->key_count;
+        for(size_t i = 0; i < filter->key_count; i++) {
+            cache_filter->key_hashes[i] = nfc_supported_cards_key_hash(filter->keys[i]);
+        }
+    }
+}
+
+static bool nfc_supported_cards_filter_match(
+    const NfcSupportedCardsPluginCacheFilter* filter,
+    const NfcDevice* device,
+    bool check_data) {
+    const NfcProtocol protocol = nfc_device_get_protocol(device);
+    bool match = false;
+
+    do {
+        if((filter->atqa_mask || filter->sak_mask) &&
+           (protocol == NfcProtocolIso14443_3a ||
+            nfc_protocol_has_parent(protocol, NfcProtocolIso14443_3a))) {
+            const Iso14443_3aData* iso14443_3a_data =
+                nfc_device_get_data(device, NfcProtocolIso14443_3a);
+            uint8_t atqa[2];
+            iso14443_3a_get_atqa(iso14443_3a_data, atqa);
+            if(((atqa[0] | atqa[1] << 8) ^ filter->atqa) & filter->atqa_mask) break;
+            if((iso14443_3a_get_sak(iso14443_3a_data) ^ filter->sak) & filter->sak_mask) break;
+        }
+
+        // Applications and keys are only known once the card is read
+        if(!check_data) {
+            match = true;
+            break;
+        }
+
+        if(filter->aid_count && protocol == NfcProtocolMfDesfire) {
+            const MfDesfireData* data = nfc_device_get_data(device, NfcProtocolMfDesfire);
+            size_t i = 0;
+            for(; i < filter->aid_count; i++) {
+                if(mf_desfire_get_application(data, &filter->aids[i])) break;
+            }
+            if(i == filter->aid_count) break;
+        }
+
+        if(filter->key_count && protocol == NfcProtocolMfClassic) {
+            const MfClassicData* data = nfc_device_get_data(device, NfcProtocolMfClassic);
+            if(filter->key_sector >= mf_classic_get_total_sectors_num(data->type)) break;
+            const MfClassicSectorTrailer* sec_tr =
+                mf_classic_get_sector_trailer_by_sector(data, filter->key_sector);
+            const uint32_t key_hash = nfc_supported_cards_key_hash(
+                bit_lib_bytes_to_num_be(sec_tr->key_a.data, COUNT_OF(sec_tr->key_a.data)));
+            size_t i = 0;
+            for(; i < filter->key_count; i++) {
+                if(filter->key_hashes[i] == key_hash) break;
+            }
+            if(i == filter->key_count) break;
+        }
+
+        match = true;
+    } while(false);
+
+    return match;
+}
+
+static bool nfc_supported_cards_cache_header_init(
+    NfcSupportedCardsCacheHeader* header,
+    Storage* storage,
+    size_t plugin_count) {
+    uint32_t timestamp = 0;
+    if(storage_common_timestamp(storage, NFC_SUPPORTED_CARDS_PLUGINS_PATH, &timestamp) !=
+       FSE_OK) {
+        return false;
+    }
+
+    *header = (NfcSupportedCardsCacheHeader){
+        .magic = NFC_SUPPORTED_CARDS_CACHE_MAGIC,
+        .version = NFC_SUPPORTED_CARDS_CACHE_VERSION,
+        .plugin_api_version = NFC_SUPPORTED_CARD_PLUGIN_API_VERSION,
+        .api_version_major = firmware_api_interface->api_version_major,
+        .api_version_minor = firmware_api_interface->api_version_minor,
+        .timestamp = timestamp,
+        .plugin_count = plugin_count,
+        .record_size = sizeof(NfcSupportedCardsCacheRecord),
+    };
+    return true;
+}
+
+static bool nfc_supported_cards_cache_load(NfcSupportedCards* instance, Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    NfcSupportedCardsCacheHeader header, expected;
+    bool success = false;
+
+    do {
+        if(!nfc_supported_cards_cache_header_init(&expected, storage, 0)) break;
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_CACHE_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        // Plugin count is the only field not known in advance
+        expected.plugin_count = header.plugin_count;
+        if(memcmp(&header, &expected, sizeof(header)) != 0) break;
+        if(header.plugin_count == 0) break;
+
+        NfcSupportedCardsCacheRecord record;
+        size_t i = 0;
+        for(; i < header.plugin_count; i++) {
+            if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+            if(record.protocol >= NfcProtocolNum) break;
+            record.name[sizeof(record.name) - 1] = '\0';
+
+            NfcSupportedCardsPluginCache plugin_cache = {};
+            plugin_cache.name = furi_string_alloc_set(record.name);
+            plugin_cache.protocol = record.protocol;
+            plugin_cache.feature = record.feature;
+            plugin_cache.filter = record.filter;
+            NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
+        }
+
+        success = (i == header.plugin_count);
+    } while(false);
+
+    if(!success) {
+        nfc_supported_cards_reset_plugins_cache(instance);
+    }
+
+    storage_file_free(file);
+    return success;
+}
+
+static void nfc_supported_cards_cache_save(NfcSupportedCards* instance, Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    NfcSupportedCardsCacheHeader header;
+    const size_t plugin_count = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+    bool success = false;
+
+    do {
+        if(!nfc_supported_cards_cache_header_init(&header, storage, plugin_count)) break;
+        if(!storage_simply_mkdir(storage, NFC_SUPPORTED_CARDS_CACHE_FOLDER)) break;
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_CACHE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        NfcSupportedCardsPluginCache_it_t iter;
+        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+            !NfcSupportedCardsPluginCache_end_p(iter);
+            NfcSupportedCardsPluginCache_next(iter)) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cref(iter);
+            if(furi_string_size(plugin_cache->name) >= NFC_SUPPORTED_CARDS_CACHE_NAME_SIZE) break;
+
+            NfcSupportedCardsCacheRecord record = {};
+            strlcpy(record.name, furi_string_get_cstr(plugin_cache->name), sizeof(record.name));
+            record.protocol = plugin_cache->protocol;
+            record.feature = plugin_cache->feature;
+            record.filter = plugin_cache->filter;
+            if(storage_file_write(file, &record, sizeof(record)) != sizeof(record)) break;
+        }
+
+        success = NfcSupportedCardsPluginCache_end_p(iter);
+    } while(false);
+
+    storage_file_close(file);
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to save cache");
+        storage_simply_remove(storage, NFC_SUPPORTED_CARDS_CACHE_PATH);
+    }
+    storage_file_free(file);
+}
+
 void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     furi_assert(instance);
 
@@ -179,9 +427,13 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
            (instance->load_state == NfcSupportedCardsLoadStateFail))
             break;
 
+        const uint32_t start = furi_get_tick();
         instance->load_context = nfc_supported_cards_load_context_alloc();
 
-        while(true) {
+        const bool cached =
+            nfc_supported_cards_cache_load(instance, instance->load_context->storage);
+
+        while(!cached) {
             const ElfApiInterface* api_interface =
                 composite_api_resolver_get(instance->api_resolver);
             const NfcSupportedCardsPlugin* plugin =
@@ -200,17 +452,29 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
             if(plugin->parse) {
                 plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
             }
+            if(instance->load_context->plugin_api_version >= 2 && plugin->filter) {
+                nfc_supported_cards_set_filter(&plugin_cache.filter, plugin->filter);
+            }
             NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
         }
 
+        size_t plugins_loaded = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+        if(!cached && plugins_loaded > 0) {
+            nfc_supported_cards_cache_save(instance, instance->load_context->storage);
+        }
+
         nfc_supported_cards_load_context_free(instance->load_context);
 
-        size_t plugins_loaded = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
         if(plugins_loaded == 0) {
             FURI_LOG_D(TAG, "Plugins not found");
             instance->load_state = NfcSupportedCardsLoadStateFail;
         } else {
-            FURI_LOG_D(TAG, "Loaded %zu plugins", plugins_loaded);
+            FURI_LOG_I(
+                TAG,
+                "Loaded %zu plugins %s in %lu ms",
+                plugins_loaded,
+                cached ? "from cache" : "from files",
+                furi_get_tick() - start);
             instance->load_state = NfcSupportedCardsLoadStateSuccess;
         }
 
@@ -224,6 +488,8 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
 
     bool card_read = false;
     NfcProtocol protocol = nfc_device_get_protocol(device);
+    const uint32_t start = furi_get_tick();
+    size_t plugins_loaded = 0;
 
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
@@ -237,12 +503,14 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+            if(!nfc_supported_cards_filter_match(&plugin_cache->filter, device, false)) continue;
 
             const ElfApiInterface* api_interface =
                 composite_api_resolver_get(instance->api_resolver);
             const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
                 instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
             if(plugin == NULL) continue;
+            plugins_loaded++;
 
             if(plugin->verify) {
                 if(!plugin->verify(nfc)) continue;
@@ -257,6 +525,13 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
         }
 
         nfc_supported_cards_load_context_free(instance->load_context);
+
+        FURI_LOG_I(
+            TAG,
+            "%s in %lu ms, %zu plugins loaded",
+            card_read ? "Read" : "Not read",
+            furi_get_tick() - start,
+            plugins_loaded);
     } while(false);
 
     return card_read;
@@ -272,6 +547,8 @@ bool nfc_supported_cards_parse(
 
     bool card_parsed = false;
     NfcProtocol protocol = nfc_device_get_protocol(device);
+    const uint32_t start = furi_get_tick();
+    size_t plugins_loaded = 0;
 
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
@@ -285,12 +562,14 @@ bool nfc_supported_cards_parse(
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasParse) == 0) continue;
+            if(!nfc_supported_cards_filter_match(&plugin_cache->filter, device, true)) continue;
 
             const ElfApiInterface* api_interface =
                 composite_api_resolver_get(instance->api_resolver);
             const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
                 instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
             if(plugin == NULL) continue;
+            plugins_loaded++;
 
             if(plugin->parse) {
                 if(plugin->parse(device, parsed_data)) {
@@ -301,6 +580,13 @@ bool nfc_supported_cards_parse(
         }
 
         nfc_supported_cards_load_context_free(instance->load_context);
+
+        FURI_LOG_I(
+            TAG,
+            "%s in %lu ms, %zu plugins loaded",
+            card_parsed ? "Parsed" : "Not parsed",
+            furi_get_tick() - start,
+            plugins_loaded);
     } while(false);
 
     return card_parsed;
@@ -37,6 +37,9 @@ void nfc_supported_cards_free(NfcSupportedCards* instance);
 /**
  * @brief Load plugins information to cache.
  *
+ * Plugins information is also saved on SD card and reused while the plugins directory and
+ * firmware API version stay the same, so plugins are not loaded at all in that case.
+ *
  * @note This function must be called before calling read and parse fanctions.
  *
  * @param[in, out] instance pointer to NfcSupportedCards instance.
@@ -47,7 +50,8 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance);
  * @brief Read the card using a custom procedure.
  *
  * This function will load all suitable supported card plugins one by one and
- * try to execute the custom read procedure specified in each. Upon first success,
+ * try to execute the custom read procedure specified in each. Plugins whose filter
+ * doesn't match the card are not loaded. Upon first success,
  * no further attempts will be made and the function will return.
  *
  * @param[in, out] instance pointer to NfcSupportedCards instance.
@@ -63,7 +67,8 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
  * @brief Parse raw data into human-readable representation.
  *
  * This function will load all suitable supported card plugins one by one and
- * try to parse the data according to each implementation. Upon first success,
+ * try to parse the data according to each implementation. Plugins whose filter
+ * doesn't match the card are not loaded. Upon first success,
  * no further attempts will be made and the function will return.
  *
  * @param[in, out] instance pointer to NfcSupportedCards instance.
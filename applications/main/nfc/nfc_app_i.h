@@ -30,6 +30,7 @@
 #include "helpers/mf_ultralight_auth.h"
 #include "helpers/mf_user_dict.h"
 #include "helpers/mfkey32_logger.h"
+#include "helpers/mfkey32_recovery.h"
 #include "helpers/nfc_emv_parser.h"
 #include "helpers/mf_classic_key_cache.h"
 #include "helpers/nfc_supported_cards.h"
@@ -136,6 +137,7 @@ struct NfcApp {
     SlixUnlock* slix_unlock;
     NfcMfClassicDictAttackContext nfc_dict_context;
     Mfkey32Logger* mfkey32_logger;
+    Mfkey32Recovery* mfkey32_recovery;
     MfUserDict* mf_user_dict;
     MfClassicKeyCache* mfc_key_cache;
     NfcSupportedCards* nfc_supported_cards;
@@ -147,12 +147,19 @@ static bool aime_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardsPluginFilter aime_filter = {
+    .key_sector = 0,
+    .keys = &aime_key,
+    .key_count = 1,
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin aime_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = aime_verify,
     .read = aime_read,
     .parse = aime_parse,
+    .filter = &aime_filter,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -131,12 +131,19 @@ static bool hid_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardsPluginFilter hid_filter = {
+    .key_sector = 1,
+    .keys = &hid_key,
+    .key_count = 1,
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin hid_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = hid_verify,
     .read = hid_read,
     .parse = hid_parse,
+    .filter = &hid_filter,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
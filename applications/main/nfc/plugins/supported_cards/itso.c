@@ -104,12 +104,18 @@ static bool itso_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardsPluginFilter itso_filter = {
+    .aids = &itso_app_id,
+    .aid_count = 1,
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin itso_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = itso_parse,
+    .filter = &itso_filter,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
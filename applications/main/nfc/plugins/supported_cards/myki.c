@@ -95,12 +95,18 @@ static bool myki_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardsPluginFilter myki_filter = {
+    .aids = &myki_app_id,
+    .aid_count = 1,
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin myki_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = myki_parse,
+    .filter = &myki_filter,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -27,6 +27,7 @@
 
 #include <nfc/nfc.h>
 #include <nfc/nfc_device.h>
+#include <nfc/protocols/mf_desfire/mf_desfire.h>
 
 /**
  * @brief Unique string identifier for supported card plugins.
@@ -35,8 +36,10 @@
 
 /**
  * @brief Currently supported plugin API version.
+ *
+ * Version 2 added the optional filter field. Plugins built for version 1 are still loaded.
  */
-#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 1
+#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 2
 
 /**
  * @brief Verify that the card is of a supported type.
@@ -81,6 +84,27 @@ typedef bool (*NfcSupportedCardPluginRead)(Nfc* nfc, NfcDevice* device);
  */
 typedef bool (*NfcSupportedCardPluginParse)(const NfcDevice* device, FuriString* parsed_data);
 
+/**
+ * @brief Cheap checks that a card may be of a supported type.
+ *
+ * The application keeps filters of all plugins in a cache on SD card and evaluates them
+ * without loading the plugin, so only plugins with a matching filter are loaded for a card.
+ * Empty fields match any card. A filter must never reject a card the plugin could handle.
+ *
+ * ATQA and SAK are checked before verify() and read(), applications and keys before parse().
+ */
+typedef struct {
+    uint16_t atqa; /**< Expected ATQA, first byte in the low bits. */
+    uint16_t atqa_mask; /**< ATQA bits to compare, 0 to skip ATQA check. */
+    uint8_t sak; /**< Expected SAK. */
+    uint8_t sak_mask; /**< SAK bits to compare, 0 to skip SAK check. */
+    const MfDesfireApplicationId* aids; /**< MIFARE DESFire card must have one of these. */
+    size_t aid_count; /**< Number of applications, 0 to skip applications check. */
+    uint8_t key_sector; /**< MIFARE Classic sector to check key A of. */
+    const uint64_t* keys; /**< Key A of key_sector must be one of these. */
+    size_t key_count; /**< Number of keys, 0 to skip key check. */
+} NfcSupportedCardsPluginFilter;
+
 /**
  * @brief Supported card plugin interface.
  *
@@ -91,4 +115,5 @@ typedef struct {
     NfcSupportedCardPluginVerify verify; /**< Pointer to the verify() function. */
     NfcSupportedCardPluginRead read; /**< Pointer to the read() function. */
     NfcSupportedCardPluginParse parse; /**< Pointer to the parse() function. */
+    const NfcSupportedCardsPluginFilter* filter; /**< Optional filter, since API version 2. */
 } NfcSupportedCardsPlugin;
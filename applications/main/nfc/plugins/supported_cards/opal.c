@@ -212,12 +212,18 @@ static bool opal_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardsPluginFilter opal_filter = {
+    .aids = &opal_app_id,
+    .aid_count = 1,
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin opal_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = opal_parse,
+    .filter = &opal_filter,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
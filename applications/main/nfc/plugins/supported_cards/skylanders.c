@@ -155,12 +155,19 @@ static bool skylanders_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardsPluginFilter skylanders_filter = {
+    .key_sector = 0,
+    .keys = &skylanders_key,
+    .key_count = 1,
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin skylanders_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = skylanders_verify,
     .read = skylanders_read,
     .parse = skylanders_parse,
+    .filter = &skylanders_filter,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
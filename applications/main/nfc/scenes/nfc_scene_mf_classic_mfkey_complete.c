@@ -10,28 +10,112 @@ void nfc_scene_mf_classic_mfkey_complete_callback(
     }
 }
 
+static void nfc_scene_mf_classic_mfkey_complete_recovery_callback(void* context) {
+    NfcApp* instance = context;
+
+    view_dispatcher_send_custom_event(instance->view_dispatcher, NfcCustomEventWorkerUpdate);
+}
+
+static void nfc_scene_mf_classic_mfkey_complete_setup_view(NfcApp* instance) {
+    Mfkey32RecoveryState state = {};
+    mfkey32_recovery_get_state(instance->mfkey32_recovery, &state);
+    FuriString* temp_str = furi_string_alloc();
+
+    widget_reset(instance->widget);
+    if(state.is_running) {
+        widget_add_string_element(
+            instance->widget, 64, 2, AlignCenter, AlignTop, FontPrimary, "Recovering Keys");
+        furi_string_printf(
+            temp_str,
+            "Sector %u key %c: %u%%\nNonce pair %zu/%zu",
+            state.sector_num,
+            state.key_type == MfClassicKeyTypeA ? 'A' : 'B',
+            state.progress,
+            state.nonces_done + 1,
+            state.nonces_total);
+        widget_add_string_multiline_element(
+            instance->widget,
+            64,
+            16,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            furi_string_get_cstr(temp_str));
+        furi_string_printf(temp_str, "Keys found: %zu", state.keys_found);
+        widget_add_string_element(
+            instance->widget,
+            64,
+            40,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            furi_string_get_cstr(temp_str));
+        widget_add_button_element(
+            instance->widget,
+            GuiButtonTypeRight,
+            "Skip",
+            nfc_scene_mf_classic_mfkey_complete_callback,
+            instance);
+    } else if(state.nonces_done == state.nonces_total) {
+        furi_string_printf(temp_str, "Keys found: %zu", state.keys_found);
+        widget_add_string_element(
+            instance->widget, 64, 2, AlignCenter, AlignTop, FontPrimary, "Completed!");
+        widget_add_string_multiline_element(
+            instance->widget,
+            64,
+            20,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            state.keys_found ? "Keys recovered on Flipper\nand added to user dict" :
+                               "No new keys recovered");
+        widget_add_string_element(
+            instance->widget,
+            64,
+            42,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            furi_string_get_cstr(temp_str));
+        widget_add_button_element(
+            instance->widget,
+            GuiButtonTypeRight,
+            "Finish",
+            nfc_scene_mf_classic_mfkey_complete_callback,
+            instance);
+    } else {
+        widget_add_string_element(
+            instance->widget, 64, 2, AlignCenter, AlignTop, FontPrimary, "Completed!");
+        widget_add_string_multiline_element(
+            instance->widget,
+            64,
+            16,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            "Now use Mfkey32 to extract \nkeys: r.flipper.net/nfc-tools");
+        widget_add_string_element(
+            instance->widget, 29, 38, AlignLeft, AlignTop, FontSecondary, "or Apps > NFC > MFKey");
+        widget_add_icon_element(instance->widget, 0, 39, &I_MFKey_qr_25x25);
+        widget_add_button_element(
+            instance->widget,
+            GuiButtonTypeRight,
+            "Finish",
+            nfc_scene_mf_classic_mfkey_complete_callback,
+            instance);
+    }
+
+    furi_string_free(temp_str);
+}
+
 void nfc_scene_mf_classic_mfkey_complete_on_enter(void* context) {
     NfcApp* instance = context;
 
-    widget_add_string_element(
-        instance->widget, 64, 2, AlignCenter, AlignTop, FontPrimary, "Completed!");
-    widget_add_string_multiline_element(
-        instance->widget,
-        64,
-        16,
-        AlignCenter,
-        AlignTop,
-        FontSecondary,
-        "Now use Mfkey32 to extract \nkeys: r.flipper.net/nfc-tools");
-    widget_add_string_element(
-        instance->widget, 29, 38, AlignLeft, AlignTop, FontSecondary, "or Apps > NFC > MFKey");
-    widget_add_icon_element(instance->widget, 0, 39, &I_MFKey_qr_25x25);
-    widget_add_button_element(
-        instance->widget,
-        GuiButtonTypeRight,
-        "Finish",
-        nfc_scene_mf_classic_mfkey_complete_callback,
+    mfkey32_recovery_start(
+        instance->mfkey32_recovery,
+        nfc_scene_mf_classic_mfkey_complete_recovery_callback,
         instance);
+    nfc_scene_mf_classic_mfkey_complete_setup_view(instance);
 
     view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewWidget);
 }
@@ -41,9 +125,20 @@ bool nfc_scene_mf_classic_mfkey_complete_on_event(void* context, SceneManagerEve
     bool consumed = false;
 
     if(event.type == SceneManagerEventTypeCustom) {
-        if(event.event == GuiButtonTypeRight) {
-            consumed = scene_manager_search_and_switch_to_previous_scene(
-                instance->scene_manager, NfcSceneStart);
+        if(event.event == NfcCustomEventWorkerUpdate) {
+            nfc_scene_mf_classic_mfkey_complete_setup_view(instance);
+            consumed = true;
+        } else if(event.event == GuiButtonTypeRight) {
+            Mfkey32RecoveryState state = {};
+            mfkey32_recovery_get_state(instance->mfkey32_recovery, &state);
+            if(state.is_running) {
+                mfkey32_recovery_stop(instance->mfkey32_recovery);
+                nfc_scene_mf_classic_mfkey_complete_setup_view(instance);
+                consumed = true;
+            } else {
+                consumed = scene_manager_search_and_switch_to_previous_scene(
+                    instance->scene_manager, NfcSceneStart);
+            }
         }
     } else if(event.type == SceneManagerEventTypeBack) {
         const uint32_t prev_scenes[] = {NfcSceneSavedMenu, NfcSceneStart};
@@ -57,5 +152,8 @@ bool nfc_scene_mf_classic_mfkey_complete_on_event(void* context, SceneManagerEve
 void nfc_scene_mf_classic_mfkey_complete_on_exit(void* context) {
     NfcApp* instance = context;
 
+    mfkey32_recovery_free(instance->mfkey32_recovery);
+    instance->mfkey32_recovery = NULL;
+
     widget_reset(instance->widget);
 }
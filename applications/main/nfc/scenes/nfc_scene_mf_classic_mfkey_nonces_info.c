@@ -46,6 +46,10 @@ bool nfc_scene_mf_classic_mfkey_nonces_info_on_event(void* context, SceneManager
         if(event.event == GuiButtonTypeCenter) {
             if(mfkey32_logger_save_params(
                    instance->mfkey32_logger, NFC_APP_MFKEY32_LOGS_FILE_PATH)) {
+                // Logger is freed on exit, recovery keeps its own copy of nonces
+                instance->mfkey32_recovery = mfkey32_recovery_alloc(
+                    instance->mfkey32_logger,
+                    nfc_device_get_data(instance->nfc_device, NfcProtocolMfClassic));
                 scene_manager_next_scene(instance->scene_manager, NfcSceneMfClassicMfkeyComplete);
             } else {
                 scene_manager_search_and_switch_to_previous_scene(
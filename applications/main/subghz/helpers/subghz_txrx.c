@@ -54,8 +54,8 @@ SubGhzTxRx* subghz_txrx_alloc(void) {
 
     subghz_worker_set_overrun_callback(
         instance->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-    subghz_worker_set_pair_callback(
-        instance->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
+    subghz_worker_set_pair_batch_callback(
+        instance->worker, (SubGhzWorkerPairBatchCallback)subghz_receiver_decode_batch);
     subghz_worker_set_context(instance->worker, instance->receiver);
 
     //set default device External
@@ -87,18 +87,13 @@ static void subghz_scene_add_to_history_callback(
 
         if(subghz->remove_duplicates) {
             // Look in history for signal hash
-            uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
+            uint16_t duplicate_idx;
             subghz_view_receiver_disable_draw_callback(subghz->subghz_receiver);
-            for(uint16_t i = idx; i > 0; i--) {
-                i--; // Iterating in reverse with off by one
-                if(subghz_history_get_hash_data(subghz->history, i) == hash_data &&
-                   subghz_history_get_protocol(subghz->history, i) == decoder_base->protocol) {
-                    // Remove previous instance and update menu index
-                    subghz_history_delete_item(subghz->history, i);
-                    subghz_view_receiver_delete_item(subghz->subghz_receiver, i);
-                    idx--;
-                }
-                i++;
+            while(subghz_history_get_previous_duplicate(subghz->history, idx, &duplicate_idx)) {
+                // Remove previous instance and update menu index
+                subghz_history_delete_item(subghz->history, duplicate_idx);
+                subghz_view_receiver_delete_item(subghz->subghz_receiver, duplicate_idx);
+                idx--;
             }
             // Restore ui state
             subghz->idx_menu_chosen = subghz_view_receiver_get_idx_menu(subghz->subghz_receiver);
@@ -169,18 +169,13 @@ static void subghz_scene_add_to_history_callback(
 
             if(subghz->remove_duplicates) {
                 // Look in history for signal hash
-                uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
+                uint16_t duplicate_idx;
                 subghz_view_receiver_disable_draw_callback(subghz->subghz_receiver);
-                for(uint16_t i = idx; i > 0; i--) {
-                    i--; // Iterating in reverse with off by one
-                    if(subghz_history_get_hash_data(subghz->history, i) == hash_data &&
-                       subghz_history_get_protocol(subghz->history, i) == decoder_base->protocol) {
-                        // Remove previous instance and update menu index
-                        subghz_history_delete_item(subghz->history, i);
-                        subghz_view_receiver_delete_item(subghz->subghz_receiver, i);
-                        idx--;
-                    }
-                    i++;
+                while(subghz_history_get_previous_duplicate(history, idx, &duplicate_idx)) {
+                    // Remove previous instance and update menu index
+                    subghz_history_delete_item(subghz->history, duplicate_idx);
+                    subghz_view_receiver_delete_item(subghz->subghz_receiver, duplicate_idx);
+                    idx--;
                 }
                 // Restore ui state
                 subghz->idx_menu_chosen =
@@ -200,8 +195,9 @@ static void subghz_scene_add_to_history_callback(
                 subghz_history_get_type_protocol(history, idx),
                 subghz_history_get_repeats(history, idx));
 
+            FlipperFormat* autosave_data = subghz_history_get_raw_data(history, idx);
             if(decoder_base->protocol->flag & SubGhzProtocolFlag_Save &&
-               subghz->last_settings->autosave) {
+               subghz->last_settings->autosave && autosave_data) {
                 // File name
                 char file[SUBGHZ_MAX_LEN_NAME] = {0};
                 const char* suf = subghz->last_settings->protocol_file_names ?
@@ -221,8 +217,7 @@ static void subghz_scene_add_to_history_callback(
                 furi_record_close(RECORD_STORAGE);
                 free(dir);
                 // Save
-                subghz_save_protocol_to_file(
-                    subghz, subghz_history_get_raw_data(history, idx), furi_string_get_cstr(path));
+                subghz_save_protocol_to_file(subghz, autosave_data, furi_string_get_cstr(path));
                 furi_string_free(path);
             }
 
@@ -413,13 +408,16 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
                 subghz->history, subghz_history_get_last_index(subghz->history) - 1);
 
             uint32_t tmpTe = 300;
-            if(!flipper_format_rewind(key_repeat_data)) {
+            if(!key_repeat_data) {
+                FURI_LOG_E(TAG, "Missing history data");
+            } else if(!flipper_format_rewind(key_repeat_data)) {
                 FURI_LOG_E(TAG, "Rewind error");
             } else if(!flipper_format_read_uint32(key_repeat_data, "TE", (uint32_t*)&tmpTe, 1)) {
                 FURI_LOG_E(TAG, "Missing TE");
             }
 
-            if(subghz_txrx_tx_start(subghz->txrx, key_repeat_data) != SubGhzTxRxStartTxStateOk) {
+            if(!key_repeat_data ||
+               subghz_txrx_tx_start(subghz->txrx, key_repeat_data) != SubGhzTxRxStartTxStateOk) {
                 view_dispatcher_send_custom_event(
                     subghz->view_dispatcher, SubGhzCustomEventViewRepeaterStop);
             } else {
@@ -448,12 +446,10 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
         case SubGhzCustomEventViewReceiverOKLong:
             subghz_txrx_stop(subghz->txrx);
             subghz_txrx_hopper_pause(subghz->txrx);
-            if(subghz_txrx_tx_start(
-                   subghz->txrx,
-                   subghz_history_get_raw_data(
-                       subghz->history,
-                       subghz_view_receiver_get_idx_menu(subghz->subghz_receiver))) !=
-               SubGhzTxRxStartTxStateOk) {
+            FlipperFormat* tx_data = subghz_history_get_raw_data(
+                subghz->history, subghz_view_receiver_get_idx_menu(subghz->subghz_receiver));
+            if(!tx_data ||
+               subghz_txrx_tx_start(subghz->txrx, tx_data) != SubGhzTxRxStartTxStateOk) {
                 view_dispatcher_send_custom_event(
                     subghz->view_dispatcher, SubGhzCustomEventViewReceiverOKRelease);
             } else {
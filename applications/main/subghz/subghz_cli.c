@@ -9,6 +9,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_bin.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <applications/drivers/subghz/cc1101_ext/cc1101_ext_interconnect.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
@@ -279,10 +280,14 @@ void subghz_cli_command_tx(Cli* cli, FuriString* args, void* context) {
     subghz_environment_free(environment);
 }
 
+#define SUBGHZ_CLI_RX_BATCH_SIZE 64
+
 typedef struct {
     volatile bool overrun;
     FuriStreamBuffer* stream;
     size_t packet_count;
+    uint32_t edge_count;
+    uint32_t overrun_count;
 } SubGhzCliCommandRx;
 
 static void subghz_cli_command_rx_capture_callback(bool level, uint32_t duration, void* context) {
@@ -366,21 +371,30 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
         "Listening at frequency: %lu device: %lu. Press CTRL+C to stop\r\n",
         frequency,
         device_ind);
-    LevelDuration level_duration;
+    LevelDuration level_durations[SUBGHZ_CLI_RX_BATCH_SIZE];
+    uint32_t rx_start = furi_get_tick();
     while(!cli_cmd_interrupt_received(cli)) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, level_durations, sizeof(level_durations), 10);
+        size_t count = ret / sizeof(LevelDuration);
+        instance->edge_count += count;
+
+        // Decode block by block, overrun markers split blocks
+        size_t block_start = 0;
+        for(size_t i = 0; i < count; i++) {
+            if(level_duration_is_reset(level_durations[i])) {
+                subghz_receiver_decode_batch(
+                    receiver, &level_durations[block_start], i - block_start);
+                block_start = i + 1;
                 printf(".");
+                instance->overrun_count++;
                 subghz_receiver_reset(receiver);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_receiver_decode(receiver, level, duration);
             }
         }
+        subghz_receiver_decode_batch(
+            receiver, &level_durations[block_start], count - block_start);
     }
+    uint32_t rx_time = furi_get_tick() - rx_start;
 
     // Shutdown radio
     subghz_devices_stop_async_rx(device);
@@ -392,6 +406,11 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
     furi_hal_power_suppress_charge_exit();
 
     printf("\r\nPackets received %zu\r\n", instance->packet_count);
+    printf(
+        "Edges received %lu (%lu/s), overruns %lu\r\n",
+        instance->edge_count,
+        rx_time ? (uint32_t)((uint64_t)instance->edge_count * 1000 / rx_time) : 0,
+        instance->overrun_count);
 
     // Cleanup
     subghz_receiver_free(receiver);
@@ -831,6 +850,50 @@ void subghz_cli_command_tx_from_file(Cli* cli, FuriString* args, void* context)
     subghz_environment_free(environment);
 }
 
+static void subghz_cli_command_raw_convert(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+    FuriString* format = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source) ||
+           !args_read_string_and_trim(args, destination) ||
+           !args_read_string_and_trim(args, format) ||
+           (furi_string_cmp_str(format, "bin") != 0 && furi_string_cmp_str(format, "text") != 0)) {
+            cli_print_usage(
+                "subghz raw_convert",
+                "<path_RAW_file> <path_output_file> <format: bin or text>",
+                furi_string_get_cstr(args));
+            break;
+        }
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        bool binary = furi_string_cmp_str(format, "bin") == 0;
+        if(subghz_raw_bin_convert_file(
+               storage,
+               furi_string_get_cstr(source),
+               furi_string_get_cstr(destination),
+               binary)) {
+            FileInfo source_info = {0};
+            FileInfo destination_info = {0};
+            storage_common_stat(storage, furi_string_get_cstr(source), &source_info);
+            storage_common_stat(storage, furi_string_get_cstr(destination), &destination_info);
+            printf(
+                "Converted %llu bytes to %llu bytes \033[0;32mOK\033[0m\r\n",
+                source_info.size,
+                destination_info.size);
+        } else {
+            printf("Convert \033[0;31mERROR\033[0m\r\n");
+        }
+        furi_record_close(RECORD_STORAGE);
+    } while(false);
+
+    furi_string_free(format);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_print_usage(void) {
     printf("Usage:\r\n");
     printf("subghz <cmd> <args>\r\n");
@@ -843,6 +906,8 @@ static void subghz_cli_command_print_usage(void) {
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\traw_convert <path_RAW_file> <path_output_file> <format: bin or text>\t - Convert RAW file data format\r\n");
     printf(
         "\ttx_from_file <file_name: path_file> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting from file\r\n");
 
@@ -1166,6 +1231,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "raw_convert") == 0) {
+            subghz_cli_command_raw_convert(cli, args);
+            break;
+        }
+
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(furi_string_cmp_str(cmd, "encrypt_keeloq") == 0) {
                 subghz_cli_command_encrypt_keeloq(cli, args);
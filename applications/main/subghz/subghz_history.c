@@ -1,6 +1,9 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <lib/flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
 #include <rpc/rpc.h>
+#include <m-dict.h>
 
 #include <furi.h>
 
@@ -8,33 +11,71 @@
 #define SUBGHZ_HISTORY_FREE_HEAP (10240 * (3 - MIN(rpc_get_sessions_count(instance->rpc), 2U)))
 #define TAG "SubGhzHistory"
 
+// Items whose serialized data is kept in RAM, older ones are spilled to SD
+#define SUBGHZ_HISTORY_RESIDENT_MAX 32
+#define SUBGHZ_HISTORY_SPILL_FOLDER EXT_PATH("subghz/.cache")
+#define SUBGHZ_HISTORY_SPILL_PATH SUBGHZ_HISTORY_SPILL_FOLDER "/history.bin"
+
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-    DateTime datetime;
+    uint32_t serial;
+    uint32_t prev_serial; // Previous item with the same hash and protocol, 0 if none
+    uint32_t next_serial; // Next item with the same hash and protocol, 0 if none
     uint32_t hash_data;
     const SubGhzProtocol* protocol;
-    uint16_t repeats;
+    uint32_t frequency;
     float latitude;
     float longitude;
+    DateTime datetime;
+    char* item_str;
+    uint8_t* data; // Serialized protocol data, NULL if spilled
+    uint32_t data_offset; // Offset of the spilled data in the spill file
+    uint32_t data_size;
+    uint16_t repeats;
+    uint16_t preset_id;
+    uint8_t type;
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
+typedef struct {
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
+
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
+
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
+
+// (protocol, hash) -> serial of the latest item with them
+DICT_DEF2(SubGhzHistoryKeyDict, uint64_t, M_DEFAULT_OPLIST, uint32_t, M_DEFAULT_OPLIST)
+
 typedef struct {
     SubGhzHistoryItemArray_t data;
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzHistoryKeyDict_t keys;
 } SubGhzHistoryStruct;
 
 struct SubGhzHistory {
     uint32_t last_update_timestamp;
     uint16_t last_index_write;
     uint32_t code_last_hash_data;
+    uint32_t last_serial;
     FuriString* tmp_string;
     SubGhzHistoryStruct* history;
+    SubGhzRadioPreset preset;
+    FlipperFormat* serialize_data;
+    FlipperFormat* raw_data;
+    uint32_t raw_data_serial; // Item currently loaded into raw_data, 0 if none
+    FuriMutex* mutex;
+    Storage* storage;
+    File* spill_file;
+    uint32_t spill_size;
+    bool spill_failed;
+    size_t spill_pos; // Items before this index are spilled
+    size_t resident_count;
     Rpc* rpc;
 };
 
@@ -43,27 +84,226 @@ SubGhzHistory* subghz_history_alloc(void) {
     instance->tmp_string = furi_string_alloc();
     instance->history = malloc(sizeof(SubGhzHistoryStruct));
     SubGhzHistoryItemArray_init(instance->history->data);
+    SubGhzHistoryPresetArray_init(instance->history->presets);
+    SubGhzHistoryKeyDict_init(instance->history->keys);
+    instance->serialize_data = flipper_format_string_alloc();
+    instance->raw_data = flipper_format_string_alloc();
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->storage = furi_record_open(RECORD_STORAGE);
     instance->rpc = furi_record_open(RECORD_RPC);
     return instance;
 }
 
+static void subghz_history_item_free(SubGhzHistory* instance, SubGhzHistoryItem* item) {
+    free(item->item_str);
+    if(item->data) {
+        free(item->data);
+        instance->resident_count--;
+    }
+    item->type = 0;
+}
+
+static void subghz_history_spill_close(SubGhzHistory* instance) {
+    if(instance->spill_file) {
+        storage_file_free(instance->spill_file);
+        instance->spill_file = NULL;
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_SPILL_PATH);
+    }
+    instance->spill_size = 0;
+    instance->spill_failed = false;
+    instance->spill_pos = 0;
+}
+
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
     furi_string_free(instance->tmp_string);
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+            subghz_history_item_free(instance, item);
         }
     SubGhzHistoryItemArray_clear(instance->history->data);
+    for
+        M_EACH(preset, instance->history->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
+        }
+    SubGhzHistoryPresetArray_clear(instance->history->presets);
+    SubGhzHistoryKeyDict_clear(instance->history->keys);
     free(instance->history);
+    subghz_history_spill_close(instance);
+    flipper_format_free(instance->serialize_data);
+    flipper_format_free(instance->raw_data);
+    furi_mutex_free(instance->mutex);
+    furi_record_close(RECORD_STORAGE);
     furi_record_close(RECORD_RPC);
     free(instance);
 }
 
+static inline uint64_t subghz_history_get_key(const SubGhzProtocol* protocol, uint32_t hash_data) {
+    return ((uint64_t)(uintptr_t)protocol << 32) | hash_data;
+}
+
+// Items are kept in the order they were added, so serials are ascending
+static SubGhzHistoryItem*
+    subghz_history_find_serial(SubGhzHistory* instance, uint32_t serial, size_t* idx) {
+    size_t low = 0;
+    size_t high = SubGhzHistoryItemArray_size(instance->history->data);
+
+    while(low < high) {
+        const size_t mid = low + (high - low) / 2;
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, mid);
+        if(item->serial == serial) {
+            if(idx) *idx = mid;
+            return item;
+        } else if(item->serial < serial) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return NULL;
+}
+
+static uint16_t subghz_history_intern_preset(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    uint16_t preset_id = 0;
+    for
+        M_EACH(item, instance->history->presets, SubGhzHistoryPresetArray_t) {
+            if(item->data == preset->data && item->data_size == preset->data_size &&
+               furi_string_equal(item->name, preset->name)) {
+                return preset_id;
+            }
+            preset_id++;
+        }
+
+    SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_push_raw(instance->history->presets);
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    return preset_id;
+}
+
+static bool subghz_history_spill_open(SubGhzHistory* instance) {
+    if(instance->spill_file) return true;
+    if(instance->spill_failed) return false;
+
+    instance->spill_file = storage_file_alloc(instance->storage);
+    if(!storage_simply_mkdir(instance->storage, SUBGHZ_HISTORY_SPILL_FOLDER) ||
+       !storage_file_open(
+           instance->spill_file, SUBGHZ_HISTORY_SPILL_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        FURI_LOG_W(TAG, "Spill file unavailable, keeping history in RAM");
+        storage_file_free(instance->spill_file);
+        instance->spill_file = NULL;
+        instance->spill_failed = true;
+        return false;
+    }
+
+    instance->spill_size = 0;
+    return true;
+}
+
+// Move the data of the oldest resident items to the end of the spill file
+static void subghz_history_spill(SubGhzHistory* instance) {
+    if(instance->resident_count <= SUBGHZ_HISTORY_RESIDENT_MAX) return;
+    if(!subghz_history_spill_open(instance)) return;
+
+    File* file = instance->spill_file;
+    if(!storage_file_seek(file, instance->spill_size, true)) return;
+
+    const size_t count = SubGhzHistoryItemArray_size(instance->history->data);
+    while(instance->spill_pos < count &&
+          instance->resident_count > SUBGHZ_HISTORY_RESIDENT_MAX / 2) {
+        SubGhzHistoryItem* item =
+            SubGhzHistoryItemArray_get(instance->history->data, instance->spill_pos);
+        if(item->data) {
+            if(storage_file_write(file, item->data, item->data_size) != item->data_size) {
+                FURI_LOG_E(TAG, "Spill write error");
+                break;
+            }
+            item->data_offset = instance->spill_size;
+            instance->spill_size += item->data_size;
+            free(item->data);
+            item->data = NULL;
+            instance->resident_count--;
+        }
+        instance->spill_pos++;
+    }
+}
+
+static void subghz_history_delete_item_at(SubGhzHistory* instance, size_t idx) {
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+
+    SubGhzHistoryItem* prev = NULL;
+    SubGhzHistoryItem* next = NULL;
+    if(item->prev_serial) prev = subghz_history_find_serial(instance, item->prev_serial, NULL);
+    if(item->next_serial) next = subghz_history_find_serial(instance, item->next_serial, NULL);
+    if(prev) prev->next_serial = item->next_serial;
+    if(next) {
+        next->prev_serial = item->prev_serial;
+    } else {
+        const uint64_t key = subghz_history_get_key(item->protocol, item->hash_data);
+        if(prev) {
+            SubGhzHistoryKeyDict_set_at(instance->history->keys, key, prev->serial);
+        } else {
+            SubGhzHistoryKeyDict_erase(instance->history->keys, key);
+        }
+    }
+
+    subghz_history_item_free(instance, item);
+    SubGhzHistoryItemArray_remove_v(instance->history->data, idx, idx + 1);
+    if(idx < instance->spill_pos) instance->spill_pos--;
+    instance->last_index_write--;
+}
+
+/*
+ * Transmitting may update the data returned by subghz_history_get_raw_data(),
+ * e.g. the counter of dynamic protocols, so it is written back to the item
+ * it was loaded from. Spilled data is appended again, the file is never rewritten.
+ */
+static void subghz_history_store_raw_data(SubGhzHistory* instance) {
+    if(!instance->raw_data_serial) return;
+    SubGhzHistoryItem* item =
+        subghz_history_find_serial(instance, instance->raw_data_serial, NULL);
+    instance->raw_data_serial = 0;
+    if(!item) return;
+
+    Stream* stream = flipper_format_get_raw_stream(instance->raw_data);
+    const size_t data_size = stream_size(stream);
+    uint8_t* data = malloc(data_size);
+    stream_rewind(stream);
+    if(stream_read(stream, data, data_size) != data_size) {
+        free(data);
+        return;
+    }
+
+    if(item->data) {
+        if(data_size == item->data_size && !memcmp(data, item->data, data_size)) {
+            free(data);
+        } else {
+            free(item->data);
+            item->data = data;
+            item->data_size = data_size;
+        }
+        return;
+    }
+
+    bool changed = true;
+    if(data_size == item->data_size) {
+        uint8_t* spilled = malloc(data_size);
+        changed = !storage_file_seek(instance->spill_file, item->data_offset, true) ||
+                  storage_file_read(instance->spill_file, spilled, data_size) != data_size ||
+                  memcmp(data, spilled, data_size);
+        free(spilled);
+    }
+
+    if(changed && storage_file_seek(instance->spill_file, instance->spill_size, true) &&
+       storage_file_write(instance->spill_file, data, data_size) == data_size) {
+        item->data_offset = instance->spill_size;
+        item->data_size = data_size;
+        instance->spill_size += data_size;
+    }
+    free(data);
+}
+
 uint32_t subghz_history_get_hash_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
@@ -85,19 +325,29 @@ uint16_t subghz_history_get_repeats(SubGhzHistory* instance, uint16_t idx) {
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    return item->frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    SubGhzHistoryPreset* preset =
+        SubGhzHistoryPresetArray_get(instance->history->presets, item->preset_id);
+    instance->preset.name = preset->name;
+    instance->preset.frequency = item->frequency;
+    instance->preset.data = preset->data;
+    instance->preset.data_size = preset->data_size;
+    instance->preset.latitude = item->latitude;
+    instance->preset.longitude = item->longitude;
+    return &instance->preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    SubGhzHistoryPreset* preset =
+        SubGhzHistoryPresetArray_get(instance->history->presets, item->preset_id);
+    return furi_string_get_cstr(preset->name);
 }
 
 float subghz_history_get_latitude(SubGhzHistory* instance, uint16_t idx) {
@@ -114,33 +364,47 @@ float subghz_history_get_longitude(SubGhzHistory* instance, uint16_t idx) {
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     furi_string_reset(instance->tmp_string);
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+            subghz_history_item_free(instance, item);
         }
     SubGhzHistoryItemArray_reset(instance->history->data);
+    SubGhzHistoryKeyDict_reset(instance->history->keys);
+    subghz_history_spill_close(instance);
+    instance->raw_data_serial = 0;
     instance->last_index_write = 0;
     instance->code_last_hash_data = 0;
+    furi_mutex_release(instance->mutex);
 }
 
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
 
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     if(idx < SubGhzHistoryItemArray_size(instance->history->data)) {
-        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-        furi_string_free(item->item_str);
-        furi_string_free(item->preset->name);
-        free(item->preset);
-        flipper_format_free(item->flipper_string);
-        item->type = 0;
-        SubGhzHistoryItemArray_remove_v(instance->history->data, idx, idx + 1);
-        instance->last_index_write--;
+        subghz_history_delete_item_at(instance, idx);
+    }
+    furi_mutex_release(instance->mutex);
+}
+
+bool subghz_history_get_previous_duplicate(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    uint16_t* duplicate_idx) {
+    furi_assert(instance);
+    furi_assert(duplicate_idx);
+
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    size_t found_idx;
+    if(!item->prev_serial ||
+       !subghz_history_find_serial(instance, item->prev_serial, &found_idx)) {
+        return false;
     }
+
+    *duplicate_idx = found_idx;
+    return true;
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
@@ -157,17 +421,11 @@ uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx)
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
+    if(!item || !item->protocol) {
         FURI_LOG_E(TAG, "Missing Item");
-        furi_string_reset(instance->tmp_string);
-        return furi_string_get_cstr(instance->tmp_string);
-    }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
+        return "";
     }
-    return furi_string_get_cstr(instance->tmp_string);
+    return item->protocol->name;
 }
 
 DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx) {
@@ -183,11 +441,36 @@ DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx) {
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
+    FlipperFormat* result = NULL;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_history_store_raw_data(instance);
+    Stream* stream = flipper_format_get_raw_stream(instance->raw_data);
+    stream_clean(stream);
+
+    if(item->data) {
+        if(stream_write(stream, item->data, item->data_size) == item->data_size) {
+            result = instance->raw_data;
+        }
+    } else if(instance->spill_file) {
+        uint8_t* data = malloc(item->data_size);
+        if(storage_file_seek(instance->spill_file, item->data_offset, true) &&
+           storage_file_read(instance->spill_file, data, item->data_size) == item->data_size &&
+           stream_write(stream, data, item->data_size) == item->data_size) {
+            result = instance->raw_data;
+        } else {
+            FURI_LOG_E(TAG, "Spill read error");
+        }
+        free(data);
+    }
+
+    if(result) {
+        flipper_format_rewind(result);
+        instance->raw_data_serial = item->serial;
     }
+    furi_mutex_release(instance->mutex);
+
+    return result;
 }
 bool subghz_history_get_text_space_left(
     SubGhzHistory* instance,
@@ -233,96 +516,50 @@ void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* outp
     furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
 }
 
-bool subghz_history_add_to_history(
+static void subghz_history_get_text_item(
     SubGhzHistory* instance,
-    void* context,
-    SubGhzRadioPreset* preset) {
-    furi_assert(instance);
-    furi_assert(context);
-
-    if(subghz_history_full(instance)) return false;
-
-    SubGhzProtocolDecoderBase* decoder_base = context;
-    uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
-    if((instance->code_last_hash_data == hash_data) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 600)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
-    }
-
-    uint16_t repeats = 0;
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* search = SubGhzHistoryItemArray_ref(it);
-        if(search->hash_data == hash_data && search->protocol == decoder_base->protocol) {
-            repeats = search->repeats + 1;
-            break;
-        }
-        SubGhzHistoryItemArray_previous(it);
-    }
-
-    instance->code_last_hash_data = hash_data;
-    instance->last_update_timestamp = furi_get_tick();
-
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-    furi_hal_rtc_get_datetime(&item->datetime);
-    item->hash_data = hash_data;
-    item->protocol = decoder_base->protocol;
-    item->repeats = repeats;
-    item->latitude = preset->latitude;
-    item->longitude = preset->longitude;
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    SubGhzProtocolDecoderBase* decoder_base,
+    FuriString* output) {
+    FlipperFormat* flipper_string = instance->serialize_data;
 
     if(decoder_base->protocol && decoder_base->protocol->decoder &&
        decoder_base->protocol->decoder->get_string_brief) {
-        decoder_base->protocol->decoder->get_string_brief(decoder_base, item->item_str);
-        instance->last_index_write++;
-        return true;
+        decoder_base->protocol->decoder->get_string_brief(decoder_base, output);
+        return;
     }
 
-    FuriString* text = furi_string_alloc();
+    FuriString* text = furi_string_scratch_alloc();
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_string)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
+        if(!flipper_format_read_string(flipper_string, "Protocol", instance->tmp_string)) {
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
         if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
             furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_string, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
             furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_string, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_string)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
         uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        if(!flipper_format_read_hex(flipper_string, "Key", key_data, sizeof(uint64_t))) {
             FURI_LOG_D(TAG, "No Key");
         }
         uint64_t data = 0;
@@ -332,50 +569,128 @@ bool subghz_history_add_to_history(
         if(data != 0) {
             if(!(uint32_t)(data >> 32)) {
                 furi_string_printf(
-                    item->item_str,
+                    output,
                     "%s %lX",
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data & 0xFFFFFFFF));
             } else {
                 furi_string_printf(
-                    item->item_str,
+                    output,
                     "%s %lX%08lX",
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data >> 32),
                     (uint32_t)(data & 0xFFFFFFFF));
             }
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            furi_string_printf(output, "%s", furi_string_get_cstr(instance->tmp_string));
         }
 
     } while(false);
 
-    furi_string_free(text);
+    furi_string_scratch_free(text);
+}
+
+bool subghz_history_add_to_history(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset) {
+    furi_assert(instance);
+    furi_assert(context);
+
+    if(subghz_history_full(instance)) return false;
+
+    SubGhzProtocolDecoderBase* decoder_base = context;
+    uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
+    if((instance->code_last_hash_data == hash_data) &&
+       ((furi_get_tick() - instance->last_update_timestamp) < 600)) {
+        instance->last_update_timestamp = furi_get_tick();
+        return false;
+    }
+
+    instance->code_last_hash_data = hash_data;
+    instance->last_update_timestamp = furi_get_tick();
+
+    // Serialize and build the menu text before taking the lock, this is the slow part
+    Stream* stream = flipper_format_get_raw_stream(instance->serialize_data);
+    stream_clean(stream);
+    subghz_protocol_decoder_base_serialize(decoder_base, instance->serialize_data, preset);
+    FuriString* item_str = furi_string_scratch_alloc();
+    subghz_history_get_text_item(instance, decoder_base, item_str);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    const uint32_t serial = ++instance->last_serial;
+    const uint64_t key = subghz_history_get_key(decoder_base->protocol, hash_data);
+    uint16_t repeats = 0;
+    uint32_t prev_serial = 0;
+    uint32_t* latest_serial = SubGhzHistoryKeyDict_get(instance->history->keys, key);
+    if(latest_serial) {
+        SubGhzHistoryItem* latest = subghz_history_find_serial(instance, *latest_serial, NULL);
+        if(latest) {
+            latest->next_serial = serial;
+            prev_serial = latest->serial;
+            repeats = latest->repeats + 1;
+        }
+    }
+    SubGhzHistoryKeyDict_set_at(instance->history->keys, key, serial);
+
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
+    item->serial = serial;
+    item->prev_serial = prev_serial;
+    item->next_serial = 0;
+    item->type = decoder_base->protocol->type;
+    item->frequency = preset->frequency;
+    item->preset_id = subghz_history_intern_preset(instance, preset);
+    furi_hal_rtc_get_datetime(&item->datetime);
+    item->hash_data = hash_data;
+    item->protocol = decoder_base->protocol;
+    item->repeats = repeats;
+    item->latitude = preset->latitude;
+    item->longitude = preset->longitude;
+    item->item_str = strdup(furi_string_get_cstr(item_str));
+
+    item->data_offset = 0;
+    item->data_size = stream_size(stream);
+    item->data = malloc(item->data_size);
+    stream_rewind(stream);
+    stream_read(stream, item->data, item->data_size);
+    instance->resident_count++;
+
     instance->last_index_write++;
+    subghz_history_spill(instance);
+
+    furi_mutex_release(instance->mutex);
+    furi_string_scratch_free(item_str);
+
     return true;
 }
 
 void subghz_history_remove_duplicates(SubGhzHistory* instance) {
     furi_assert(instance);
 
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* i = SubGhzHistoryItemArray_ref(it);
-
-        SubGhzHistoryItemArray_it_t jt;
-        SubGhzHistoryItemArray_it_set(jt, it);
-        SubGhzHistoryItemArray_previous(jt);
-        while(!SubGhzHistoryItemArray_end_p(jt)) {
-            SubGhzHistoryItem* j = SubGhzHistoryItemArray_ref(jt);
-
-            if(j->hash_data == i->hash_data && j->protocol == i->protocol) {
-                subghz_history_delete_item(instance, jt->index);
-            }
-            SubGhzHistoryItemArray_previous(jt);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Keep only the latest item of every chain, compacting the array in one pass
+    const size_t count = SubGhzHistoryItemArray_size(instance->history->data);
+    const size_t spill_pos = instance->spill_pos;
+    size_t kept = 0;
+    for(size_t i = 0; i < count; i++) {
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, i);
+        if(item->next_serial) {
+            subghz_history_item_free(instance, item);
+            if(i < spill_pos) instance->spill_pos--;
+            continue;
         }
-        SubGhzHistoryItemArray_previous(it);
+        item->prev_serial = 0;
+        if(kept != i) {
+            *SubGhzHistoryItemArray_get(instance->history->data, kept) = *item;
+        }
+        kept++;
     }
+    SubGhzHistoryItemArray_resize(instance->history->data, kept);
+    instance->last_index_write = kept;
+
+    furi_mutex_release(instance->mutex);
 }
 
 bool subghz_history_full(SubGhzHistory* instance) {
@@ -29,6 +29,18 @@ void subghz_history_reset(SubGhzHistory* instance);
 
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t idx);
 
+/** Find the previous record with the same hash data and protocol as history[idx]
+ * 
+ * @param instance      - SubGhzHistory instance
+ * @param idx           - record index
+ * @param duplicate_idx - index of the found record
+ * @return bool         - true if found
+ */
+bool subghz_history_get_previous_duplicate(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    uint16_t* duplicate_idx);
+
 /** Get hash data to history[idx]
  * 
  * @param instance - SubGhzHistory instance
@@ -152,6 +164,9 @@ bool subghz_history_add_to_history(
     SubGhzRadioPreset* preset);
 
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+ * 
+ * Data is loaded into a buffer shared by all records, it is valid until the next call.
+ * Changes made to it, e.g. by transmitting, are saved back to the record on the next call.
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
@@ -24,6 +24,7 @@
 #define SUBGHZ_LAST_SETTING_FIELD_ENABLE_SOUND "Sound"
 #define SUBGHZ_LAST_SETTING_FIELD_AUTOSAVE "Autosave"
 #define SUBGHZ_LAST_SETTING_FIELD_HOPPING_THRESHOLD "HoppingThreshold"
+#define SUBGHZ_LAST_SETTING_FIELD_RAW_BINARY "RawBinary"
 
 SubGhzLastSettings* subghz_last_settings_alloc(void) {
     SubGhzLastSettings* instance = malloc(sizeof(SubGhzLastSettings));
@@ -162,6 +163,10 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
                    1)) {
                 flipper_format_rewind(fff_data_file);
             }
+            if(!flipper_format_read_bool(
+                   fff_data_file, SUBGHZ_LAST_SETTING_FIELD_RAW_BINARY, &instance->raw_binary, 1)) {
+                flipper_format_rewind(fff_data_file);
+            }
         } while(0);
     } else {
         FURI_LOG_E(TAG, "Error open file %s", SUBGHZ_LAST_SETTINGS_PATH);
@@ -281,6 +286,10 @@ bool subghz_last_settings_save(SubGhzLastSettings* instance) {
                1)) {
             break;
         }
+        if(!flipper_format_write_bool(
+               file, SUBGHZ_LAST_SETTING_FIELD_RAW_BINARY, &instance->raw_binary, 1)) {
+            break;
+        }
         saved = true;
     } while(0);
 
@@ -285,7 +285,7 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
     }
 
     bool scrollbar = model->history_item > 4;
-    FuriString* str_buff = furi_string_alloc();
+    FuriString* str_buff = furi_string_scratch_alloc();
 
     if(!model->nodraw) {
         SubGhzReceiverMenuItem* item_menu;
@@ -320,13 +320,12 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
             elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 7 : MAX_LEN_PX);
             canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[item_menu->type]);
             canvas_draw_str(canvas, 15, 9 + i * FRAME_HEIGHT, furi_string_get_cstr(str_buff));
-            furi_string_reset(str_buff);
         }
         if(scrollbar) {
             elements_scrollbar_pos(canvas, 128, 0, 49, model->idx, model->history_item);
         }
     }
-    furi_string_free(str_buff);
+    furi_string_scratch_free(str_buff);
 
     canvas_set_color(canvas, ColorBlack);
 
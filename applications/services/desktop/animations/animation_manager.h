@@ -22,6 +22,22 @@ typedef struct FrameBubble {
     const struct FrameBubble* next_bubble;
 } FrameBubble;
 
+/** Frame data callback for animations streamed from storage, doesn't access storage
+ *
+ * @param context   callback context
+ * @param frame     frame index
+ * @return          frame bitmap, valid until the next load. NULL if not loaded.
+ */
+typedef const uint8_t* (*BubbleAnimationFrameCallback)(void* context, uint8_t frame);
+
+/** Frame load callback for animations streamed from storage
+ * Reads the frame into RAM, evicting the least recently loaded one.
+ *
+ * @param context   callback context
+ * @param frame     frame index
+ */
+typedef void (*BubbleAnimationFrameLoadCallback)(void* context, uint8_t frame);
+
 typedef struct {
     const FrameBubble* const* frame_bubble_sequences;
     uint8_t frame_bubble_sequences_count;
@@ -32,6 +48,10 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    /* Used instead of icon_animation frames if set */
+    BubbleAnimationFrameCallback frame_callback;
+    BubbleAnimationFrameLoadCallback frame_load_callback;
+    void* frame_context;
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
@@ -1,6 +1,8 @@
 
 #include <stdint.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/stream.h>
 #include <furi.h>
 #include <core/dangerous_defines.h>
 #include <storage/storage.h>
@@ -13,6 +15,38 @@
 #include <momentum/momentum.h>
 #define ANIMATION_META_FILE "meta.txt"
 #define TAG "AnimationStorage"
+
+/* Packed animation: header, frame offset table, meta.txt content and frames in one file */
+#define ANIMATION_PACKED_EXT ".bma"
+#define ANIMATION_PACKED_MAGIC 0x31414D42
+#define ANIMATION_PACKED_MAX_SUPPORTED_VERSION 1
+/* Frames kept in RAM when streaming */
+#define ANIMATION_STREAM_WINDOW 4
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t width;
+    uint8_t height;
+    uint8_t frame_count;
+    uint16_t meta_size;
+} AnimationPackedHeader;
+_Static_assert(sizeof(AnimationPackedHeader) == 10, "Incorrect AnimationPackedHeader size");
+
+#pragma pack(pop)
+
+typedef struct {
+    File* file;
+    AnimationPackedHeader header;
+    /* frame_count + 1 absolute offsets, frame i ends where frame i + 1 starts */
+    uint32_t* offsets;
+    uint8_t* window[ANIMATION_STREAM_WINDOW];
+    int16_t window_frame[ANIMATION_STREAM_WINDOW];
+    uint32_t window_used[ANIMATION_STREAM_WINDOW];
+    uint32_t window_tick;
+} AnimationPacked;
 char ANIMATION_DIR[23 /* /ext/asset_packs//Anims */ + ASSET_PACKS_NAME_LEN + 1];
 char ANIMATION_MANIFEST_FILE[sizeof(ANIMATION_DIR) + 13 /*"/manifest.txt"*/];
 
@@ -278,10 +312,28 @@ static bool animation_storage_cast_align(FuriString* align_str, Align* align) {
     return true;
 }
 
+static void animation_storage_packed_close(AnimationPacked* packed) {
+    for(size_t i = 0; i < ANIMATION_STREAM_WINDOW; i++) {
+        free(packed->window[i]);
+    }
+    free(packed->offsets);
+    storage_file_free(packed->file);
+    free(packed);
+}
+
 static void animation_storage_free_frames(BubbleAnimation* animation) {
     furi_assert(animation);
 
-    const Icon* icon = &animation->icon_animation;
+    if(animation->frame_context) {
+        animation_storage_packed_close(animation->frame_context);
+        animation->frame_context = NULL;
+        animation->frame_callback = NULL;
+        animation->frame_load_callback = NULL;
+    }
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    if(!icon->frames) return;
+
     for(int i = 0; i < icon->frame_count; ++i) {
         if(icon->frames[i]) {
             free((void*)icon->frames[i]);
@@ -289,6 +341,7 @@ static void animation_storage_free_frames(BubbleAnimation* animation) {
     }
 
     free((void*)icon->frames);
+    icon->frames = NULL;
 }
 
 static bool animation_storage_load_frames(
@@ -377,6 +430,155 @@ static bool animation_storage_load_frames(
     return frames_ok;
 }
 
+static AnimationPacked* animation_storage_packed_open(Storage* storage, const char* name) {
+    AnimationPacked* packed = malloc(sizeof(AnimationPacked));
+    packed->file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc_printf("%s/%s" ANIMATION_PACKED_EXT, ANIMATION_DIR, name);
+
+    if(!storage_file_open(
+           packed->file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        animation_storage_packed_close(packed);
+        packed = NULL;
+    }
+
+    furi_string_free(path);
+    return packed;
+}
+
+static bool animation_storage_packed_read_meta(AnimationPacked* packed, FlipperFormat* ff) {
+    AnimationPackedHeader* header = &packed->header;
+    if((storage_file_read(packed->file, header, sizeof(*header)) != sizeof(*header)) ||
+       (header->magic != ANIMATION_PACKED_MAGIC) ||
+       (header->version > ANIMATION_PACKED_MAX_SUPPORTED_VERSION) ||
+       (header->frame_count == 0) || (header->meta_size == 0)) {
+        FURI_LOG_E(TAG, "Invalid packed animation header");
+        return false;
+    }
+
+    size_t offsets_size = sizeof(uint32_t) * (header->frame_count + 1);
+    packed->offsets = malloc(offsets_size);
+    if(storage_file_read(packed->file, packed->offsets, offsets_size) != offsets_size) {
+        return false;
+    }
+
+    char* meta = malloc(header->meta_size);
+    bool result = false;
+    if(storage_file_read(packed->file, meta, header->meta_size) == header->meta_size) {
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        result = stream_write(stream, (uint8_t*)meta, header->meta_size) == header->meta_size &&
+                 stream_rewind(stream);
+    }
+    free(meta);
+
+    return result;
+}
+
+static int8_t animation_storage_packed_find_frame(AnimationPacked* packed, uint8_t frame) {
+    for(size_t i = 0; i < ANIMATION_STREAM_WINDOW; i++) {
+        if(packed->window_frame[i] == frame) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Called by the view with its model locked, from the draw callback */
+static const uint8_t* animation_storage_packed_get_frame(void* context, uint8_t frame) {
+    AnimationPacked* packed = context;
+    int8_t slot = animation_storage_packed_find_frame(packed, frame);
+    return (slot < 0) ? NULL : packed->window[slot];
+}
+
+/* Called by the view with its model locked, ahead of drawing the frame */
+static void animation_storage_packed_load_frame(void* context, uint8_t frame) {
+    AnimationPacked* packed = context;
+    if(frame >= packed->header.frame_count) return;
+
+    int8_t slot = animation_storage_packed_find_frame(packed, frame);
+    if(slot < 0) {
+        slot = 0;
+        for(size_t i = 1; i < ANIMATION_STREAM_WINDOW; i++) {
+            if(packed->window_used[i] < packed->window_used[slot]) slot = i;
+        }
+        packed->window_frame[slot] = -1;
+
+        uint32_t size = packed->offsets[frame + 1] - packed->offsets[frame];
+        if(!storage_file_seek(packed->file, packed->offsets[frame], true) ||
+           storage_file_read(packed->file, packed->window[slot], size) != size) {
+            FURI_LOG_E(TAG, "Failed to stream frame %u", frame);
+            return;
+        }
+        packed->window_frame[slot] = frame;
+    }
+
+    packed->window_used[slot] = ++packed->window_tick;
+}
+
+/* Small animations are loaded at once, bigger ones are streamed through the frame window.
+ * Streaming animation takes ownership of the packed file. */
+static bool animation_storage_load_packed_frames(
+    AnimationPacked* packed,
+    BubbleAnimation* animation,
+    uint32_t* frame_order,
+    uint8_t width,
+    uint8_t height) {
+    uint16_t frame_order_count = animation->passive_frames + animation->active_frames;
+    const AnimationPackedHeader* header = &packed->header;
+
+    for(int i = 0; i < frame_order_count; ++i) {
+        if(frame_order[i] >= header->frame_count) return false;
+    }
+    if((header->width != width) || (header->height != height)) return false;
+
+    size_t max_filesize = ROUND_UP_TO(width, 8) * height + 1;
+    uint32_t data_start = sizeof(AnimationPackedHeader) +
+                          sizeof(uint32_t) * (header->frame_count + 1) + header->meta_size;
+    if(packed->offsets[0] != data_start) return false;
+    for(int i = 0; i < header->frame_count; ++i) {
+        if((packed->offsets[i + 1] < packed->offsets[i]) ||
+           (packed->offsets[i + 1] - packed->offsets[i] > max_filesize)) {
+            FURI_LOG_E(TAG, "Invalid packed frame %d", i);
+            return false;
+        }
+    }
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    FURI_CONST_ASSIGN(icon->frame_count, header->frame_count);
+    FURI_CONST_ASSIGN(icon->frame_rate, 0);
+    FURI_CONST_ASSIGN(icon->height, height);
+    FURI_CONST_ASSIGN(icon->width, width);
+
+    uint32_t frames_size = packed->offsets[header->frame_count] - data_start;
+    if(frames_size > ANIMATION_STREAM_WINDOW * max_filesize) {
+        for(size_t i = 0; i < ANIMATION_STREAM_WINDOW; i++) {
+            packed->window[i] = malloc(max_filesize);
+            packed->window_frame[i] = -1;
+        }
+        animation->frame_callback = animation_storage_packed_get_frame;
+        animation->frame_load_callback = animation_storage_packed_load_frame;
+        animation->frame_context = packed;
+        return true;
+    }
+
+    icon->frames = malloc(sizeof(const uint8_t*) * icon->frame_count);
+    bool frames_ok = true;
+    for(int i = 0; i < icon->frame_count; ++i) {
+        size_t size = packed->offsets[i + 1] - packed->offsets[i];
+        FURI_CONST_ASSIGN_PTR(icon->frames[i], malloc(size));
+        if(storage_file_read(packed->file, (void*)icon->frames[i], size) != size) {
+            frames_ok = false;
+            break;
+        }
+    }
+
+    if(!frames_ok) {
+        FURI_LOG_E(TAG, "Failed to read packed frames");
+        animation_storage_free_frames(animation);
+    }
+
+    return frames_ok;
+}
+
 static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFormat* ff) {
     uint32_t u32value;
     FuriString* str;
@@ -461,13 +663,14 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     furi_assert(name);
     BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
 
+    uint32_t load_start = furi_get_tick();
+    size_t load_free_heap = memmgr_get_free_heap();
     uint32_t height = 0;
     uint32_t width = 0;
     uint32_t* u32array = NULL;
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_file_alloc(storage);
-    /* Forbid skipping fields */
-    flipper_format_set_strict_mode(ff, true);
+    FlipperFormat* ff = NULL;
+    AnimationPacked* packed = NULL;
     FuriString* str;
     str = furi_string_alloc();
     animation->frame_bubble_sequences = NULL;
@@ -478,8 +681,19 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
 
         if(FSE_OK != storage_sd_status(storage)) break;
 
-        furi_string_printf(str, "%s/%s/" ANIMATION_META_FILE, ANIMATION_DIR, name);
-        if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(str))) break;
+        /* Packed animation carries its meta.txt inside */
+        packed = animation_storage_packed_open(storage, name);
+        if(packed) {
+            ff = flipper_format_string_alloc();
+            if(!animation_storage_packed_read_meta(packed, ff)) break;
+        } else {
+            ff = flipper_format_file_alloc(storage);
+            furi_string_printf(str, "%s/%s/" ANIMATION_META_FILE, ANIMATION_DIR, name);
+            if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(str))) break;
+        }
+        /* Forbid skipping fields */
+        flipper_format_set_strict_mode(ff, true);
+
         if(!flipper_format_read_header(ff, str, &u32value)) break;
         if(furi_string_cmp_str(str, "Flipper Animation")) break;
 
@@ -506,8 +720,13 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         }
 
         /* passive and active frames must be loaded up to this point */
-        if(!animation_storage_load_frames(storage, name, animation, u32array, width, height))
-            break;
+        if(packed) {
+            if(!animation_storage_load_packed_frames(packed, animation, u32array, width, height))
+                break;
+        } else {
+            if(!animation_storage_load_frames(storage, name, animation, u32array, width, height))
+                break;
+        }
 
         if(!flipper_format_read_uint32(ff, "Active cycles", &u32value, 1)) break; //-V779
         animation->active_cycles = u32value;
@@ -525,12 +744,21 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     } while(0);
 
     furi_string_free(str);
-    flipper_format_free(ff);
+    if(ff) {
+        flipper_format_free(ff);
+    }
     if(u32array) {
         free(u32array);
     }
 
+    /* Streaming animation owns the packed file */
+    bool streamed = packed && (animation->frame_context == packed);
+    if(packed && !streamed) {
+        animation_storage_packed_close(packed);
+    }
+
     if(!success) { //-V547
+        animation_storage_free_frames(animation);
         if(animation->frame_order) {
             free((void*)animation->frame_order);
         }
@@ -538,6 +766,20 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         animation = NULL;
     }
 
+    if(animation) {
+        size_t free_heap = memmgr_get_free_heap();
+        FURI_LOG_I(
+            TAG,
+            "Loaded \'%s\' (%s) in %lu ms, %u files opened, %zu bytes resident",
+            name,
+            streamed ? "streamed" : (packed ? "packed" : "frames"),
+            furi_get_tick() - load_start,
+            packed ? 1 : animation->icon_animation.frame_count + 1,
+            load_free_heap > free_heap ? load_free_heap - free_heap : 0);
+    }
+
+    furi_record_close(RECORD_STORAGE);
+
     return animation;
 }
 
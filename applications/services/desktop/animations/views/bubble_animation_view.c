@@ -53,6 +53,34 @@ static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model)
     return animation->frame_order[icon_index];
 }
 
+static const uint8_t*
+    bubble_animation_get_frame_data(const BubbleAnimation* animation, uint8_t index) {
+    if(animation->frame_callback) {
+        return animation->frame_callback(animation->frame_context, index);
+    }
+    return animation->icon_animation.frames[index];
+}
+
+static void bubble_animation_next_frame(BubbleAnimationViewModel* model);
+
+/* Streamed frames are read here, with the model locked, so that drawing only reads RAM.
+ * Current frame is usually loaded already, the next one is read ahead for the timer tick.
+ */
+static void bubble_animation_load_frames(BubbleAnimationViewModel* model) {
+    const BubbleAnimation* animation = model->current;
+    if(!animation || !animation->frame_load_callback || model->freeze_frame) {
+        return;
+    }
+
+    BubbleAnimationViewModel next = *model;
+    bubble_animation_next_frame(&next);
+
+    animation->frame_load_callback(
+        animation->frame_context, bubble_animation_get_frame_index(model));
+    animation->frame_load_callback(
+        animation->frame_context, bubble_animation_get_frame_index(&next));
+}
+
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     furi_assert(model_);
     furi_assert(canvas);
@@ -76,8 +104,10 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    const uint8_t* frame = bubble_animation_get_frame_data(animation, index);
+    if(frame) {
+        canvas_draw_bitmap(canvas, 0, y_offset, width, height, frame);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -187,6 +217,7 @@ static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
         model->current_frame = model->current->passive_frames;
         model->current_bubble = bubble_animation_pick_bubble(model, true);
         frame_rate = model->current->icon_animation.frame_rate;
+        bubble_animation_load_frames(model);
     }
     view_commit_model(view->view, true);
 
@@ -238,6 +269,7 @@ static void bubble_animation_timer_callback(void* context) {
 
     if(!model->freeze_frame && !activate) {
         bubble_animation_next_frame(model);
+        bubble_animation_load_frames(model);
     }
 
     view_commit_model(view->view, !activate);
@@ -251,10 +283,13 @@ static void bubble_animation_timer_callback(void* context) {
  * animation is always activated at unfreezing and played
  * passive frame first, and 2 frames after - active
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
-    furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
+static Icon* bubble_animation_clone_first_frame(const BubbleAnimation* animation) {
+    furi_assert(animation);
+    const Icon* icon_orig = &animation->icon_animation;
+    if(animation->frame_load_callback) {
+        animation->frame_load_callback(animation->frame_context, 0);
+    }
+    const uint8_t* frame = bubble_animation_get_frame_data(animation, 0);
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -267,7 +302,10 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
     FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    /* streamed frame may fail to load, keep blank uncompressed bitmap then */
+    if(frame) {
+        memcpy((void*)icon_clone->frames[0], frame, max_bitmap_size);
+    }
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -369,6 +407,7 @@ void bubble_animation_view_set_animation(
     model->current_bubble = bubble_animation_pick_bubble(model, false);
     model->current_frame = 0;
     model->active_cycle = 0;
+    bubble_animation_load_frames(model);
     view_commit_model(view->view, true);
 
     furi_timer_start(view->timer, 1000 / new_animation->icon_animation.frame_rate);
@@ -380,7 +419,7 @@ void bubble_animation_freeze(BubbleAnimationView* view) {
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model->current);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    model->freeze_frame = bubble_animation_clone_first_frame(model->current);
     model->current = NULL;
     view_commit_model(view->view, false);
     furi_timer_stop(view->timer);
@@ -395,6 +434,7 @@ void bubble_animation_unfreeze(BubbleAnimationView* view) {
     bubble_animation_release_frame(&model->freeze_frame);
     furi_assert(model->current);
     frame_rate = model->current->icon_animation.frame_rate;
+    bubble_animation_load_frames(model);
     view_commit_model(view->view, true);
 
     furi_timer_start(view->timer, 1000 / frame_rate);
@@ -47,7 +47,7 @@ static void one_shot_view_draw(Canvas* canvas, void* model_) {
         y_offset,
         model->icon->width,
         model->icon->height,
-        model->icon->frames[model->index]);
+        icon_get_frame_data(model->icon, model->index));
 }
 
 static bool one_shot_view_input(InputEvent* event, void* context) {
@@ -1,5 +1,6 @@
 #include "canvas_i.h"
 #include "icon_animation_i.h"
+#include "icon_i.h"
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -18,6 +19,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init(void) {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc(ICON_DECOMPRESSOR_BUFFER_SIZE);
+    canvas->icon_cache.budget = CANVAS_ICON_CACHE_BUDGET;
 
     // Initialize mutex
     canvas->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
@@ -42,6 +44,7 @@ Canvas* canvas_init(void) {
 
 void canvas_free(Canvas* canvas) {
     furi_check(canvas);
+    canvas_icon_cache_reset(canvas);
     compress_icon_free(canvas->compress_icon);
     CanvasCallbackPairArray_clear(canvas->canvas_callback_pair);
     furi_mutex_free(canvas->mutex);
@@ -58,6 +61,137 @@ static void canvas_unlock(Canvas* canvas) {
     furi_check(furi_mutex_release(canvas->mutex) == FuriStatusOk);
 }
 
+static void canvas_icon_cache_evict(CanvasIconCache* cache, CanvasIconCacheEntry* entry) {
+    cache->used -= entry->size;
+    free(entry->decoded);
+    memset(entry, 0, sizeof(CanvasIconCacheEntry));
+}
+
+static CanvasIconCacheEntry* canvas_icon_cache_get_lru(CanvasIconCache* cache) {
+    CanvasIconCacheEntry* lru = NULL;
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ENTRIES; i++) {
+        CanvasIconCacheEntry* entry = &cache->entries[i];
+        if(!entry->data) continue;
+        if(!lru || (int32_t)(entry->last_used - lru->last_used) < 0) lru = entry;
+    }
+    return lru;
+}
+
+static void canvas_icon_cache_shrink(CanvasIconCache* cache, size_t budget) {
+    while(cache->used > budget) {
+        canvas_icon_cache_evict(cache, canvas_icon_cache_get_lru(cache));
+        cache->evictions++;
+    }
+}
+
+static uint32_t canvas_icon_cache_checksum(const uint8_t* data, size_t size) {
+    // FNV-1a
+    uint32_t checksum = 2166136261UL;
+    for(size_t i = 0; i < size; i++) {
+        checksum = (checksum ^ data[i]) * 16777619UL;
+    }
+    return checksum;
+}
+
+/* Decode icon frame data, reusing a previously decoded copy when possible.
+ *
+ * Frames in flash are identified by their pointer alone. Frames in RAM, like
+ * animations loaded from SD, may be freed and the memory reused for other
+ * data, so their compressed data is checksummed too.
+ */
+static const uint8_t* canvas_icon_decode(
+    Canvas* canvas,
+    const uint8_t* data,
+    size_t width,
+    size_t height) {
+    CanvasIconCache* cache = &canvas->icon_cache;
+    uint8_t* decoded = NULL;
+
+    const size_t compressed_size = compress_icon_get_compressed_size(data);
+    const size_t size = ((width + 7) / 8) * height;
+    if(!compressed_size || !cache->budget || size > cache->budget) {
+        compress_icon_decode(canvas->compress_icon, data, &decoded);
+        return decoded;
+    }
+
+    const uintptr_t address = (uintptr_t)data;
+    const bool in_flash = address >= FLASH_BASE && address < FLASH_BASE + FLASH_SIZE;
+    const uint32_t checksum = in_flash ? 0 : canvas_icon_cache_checksum(data, compressed_size);
+
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ENTRIES; i++) {
+        CanvasIconCacheEntry* entry = &cache->entries[i];
+        if(entry->data != data) continue;
+        if(entry->checksum == checksum && entry->size == size) {
+            entry->last_used = ++cache->tick;
+            cache->hits++;
+            return entry->decoded;
+        }
+        // Stale frame, the memory was reused
+        canvas_icon_cache_evict(cache, entry);
+    }
+
+    cache->misses++;
+    compress_icon_decode(canvas->compress_icon, data, &decoded);
+
+    canvas_icon_cache_shrink(cache, cache->budget - size);
+    CanvasIconCacheEntry* free_entry = NULL;
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ENTRIES && !free_entry; i++) {
+        if(!cache->entries[i].data) free_entry = &cache->entries[i];
+    }
+    if(!free_entry) {
+        free_entry = canvas_icon_cache_get_lru(cache);
+        canvas_icon_cache_evict(cache, free_entry);
+        cache->evictions++;
+    }
+
+    free_entry->data = data;
+    free_entry->checksum = checksum;
+    free_entry->decoded = malloc(size);
+    free_entry->size = size;
+    free_entry->last_used = ++cache->tick;
+    memcpy(free_entry->decoded, decoded, size);
+    cache->used += size;
+
+    return free_entry->decoded;
+}
+
+void canvas_icon_cache_get_stats(Canvas* canvas, CanvasIconCacheStats* stats) {
+    furi_check(canvas);
+    furi_check(stats);
+    CanvasIconCache* cache = &canvas->icon_cache;
+
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->entries = 0;
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ENTRIES; i++) {
+        if(cache->entries[i].data) stats->entries++;
+    }
+    stats->used = cache->used;
+    stats->budget = cache->budget;
+}
+
+void canvas_icon_cache_set_budget(Canvas* canvas, size_t budget) {
+    furi_check(canvas);
+    CanvasIconCache* cache = &canvas->icon_cache;
+
+    canvas_icon_cache_shrink(cache, budget);
+    cache->budget = budget;
+}
+
+void canvas_icon_cache_reset(Canvas* canvas) {
+    furi_check(canvas);
+    CanvasIconCache* cache = &canvas->icon_cache;
+
+    for(size_t i = 0; i < CANVAS_ICON_CACHE_ENTRIES; i++) {
+        if(cache->entries[i].data) canvas_icon_cache_evict(cache, &cache->entries[i]);
+    }
+    cache->tick = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
+
 void canvas_reset(Canvas* canvas) {
     furi_check(canvas);
 
@@ -137,8 +271,9 @@ size_t canvas_current_font_width(const Canvas* canvas) {
 const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font font) {
     furi_check(canvas);
     furi_check(font < FontTotalNumber);
-    if(asset_packs.font_params[font]) {
-        return asset_packs.font_params[font];
+    const CanvasFontParameters* params = asset_packs_get_font_params(font);
+    if(params) {
+        return params;
     }
     return &canvas_font_params[font];
 }
@@ -176,8 +311,9 @@ void canvas_invert_color(Canvas* canvas) {
 void canvas_set_font(Canvas* canvas, Font font) {
     furi_check(canvas);
     u8g2_SetFontMode(&canvas->fb, 1);
-    if(asset_packs.fonts[font]) {
-        u8g2_SetFont(&canvas->fb, asset_packs.fonts[font]);
+    const uint8_t* pack_font = asset_packs_get_font(font);
+    if(pack_font) {
+        u8g2_SetFont(&canvas->fb, pack_font);
         return;
     }
     switch(font) {
@@ -281,8 +417,8 @@ void canvas_draw_bitmap(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* bitmap_data = NULL;
-    compress_icon_decode(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
+    const uint8_t* bitmap_data =
+        canvas_icon_decode(canvas, compressed_bitmap_data, width, height);
     canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, bitmap_data, IconRotation0);
 }
 
@@ -296,9 +432,12 @@ void canvas_draw_icon_animation(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(
-        canvas->compress_icon, icon_animation_get_data(icon_animation), &icon_data);
+    const Icon* icon = icon_animation->icon;
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas,
+        icon_acquire_frame_data(icon, icon_animation->frame),
+        icon_animation_get_width(icon_animation),
+        icon_animation_get_height(icon_animation));
     canvas_draw_u8g2_bitmap(
         &canvas->fb,
         x,
@@ -307,6 +446,7 @@ void canvas_draw_icon_animation(
         icon_animation_get_height(icon_animation),
         icon_data,
         IconRotation0);
+    icon_release_frame_data(icon);
 }
 
 static void canvas_draw_u8g2_bitmap_int(
@@ -423,10 +563,11 @@ void canvas_draw_icon_ex(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_frame_data(icon, 0), &icon_data);
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas, icon_acquire_frame_data(icon, 0), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, rotation);
+    icon_release_frame_data(icon);
 }
 
 void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
@@ -435,10 +576,11 @@ void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_frame_data(icon, 0), &icon_data);
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas, icon_acquire_frame_data(icon, 0), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, IconRotation0);
+    icon_release_frame_data(icon);
 }
 
 void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y) {
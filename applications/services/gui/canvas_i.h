@@ -14,6 +14,14 @@
 
 #define ICON_DECOMPRESSOR_BUFFER_SIZE (128u * 64 / 8)
 
+/** Maximum number of decoded frames kept by the icon cache */
+#define CANVAS_ICON_CACHE_ENTRIES (24u)
+
+/** Default memory budget of the icon cache in bytes, 0 disables it */
+#ifndef CANVAS_ICON_CACHE_BUDGET
+#define CANVAS_ICON_CACHE_BUDGET (4096u)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,6 +43,37 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+/** Decoded icon frame, keyed by its compressed data pointer
+ */
+typedef struct {
+    const uint8_t* data;
+    uint32_t checksum;
+    uint8_t* decoded;
+    size_t size;
+    uint32_t last_used;
+} CanvasIconCacheEntry;
+
+/** Decoded icon cache statistics
+ */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    size_t entries;
+    size_t used;
+    size_t budget;
+} CanvasIconCacheStats;
+
+typedef struct {
+    CanvasIconCacheEntry entries[CANVAS_ICON_CACHE_ENTRIES];
+    size_t used;
+    size_t budget;
+    uint32_t tick;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} CanvasIconCache;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -45,6 +84,7 @@ struct Canvas {
     size_t width;
     size_t height;
     CompressIcon* compress_icon;
+    CanvasIconCache icon_cache;
     CanvasCallbackPairArray_t canvas_callback_pair;
     FuriMutex* mutex;
 };
@@ -126,6 +166,26 @@ void canvas_draw_u8g2_bitmap(
     const uint8_t* bitmap,
     IconRotation rotation);
 
+/** Get decoded icon cache statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   CanvasIconCacheStats to fill
+ */
+void canvas_icon_cache_get_stats(Canvas* canvas, CanvasIconCacheStats* stats);
+
+/** Set decoded icon cache memory budget, evicting frames that do not fit
+ *
+ * @param      canvas  Canvas instance
+ * @param      budget  budget in bytes, 0 disables the cache
+ */
+void canvas_icon_cache_set_budget(Canvas* canvas, size_t budget);
+
+/** Drop all decoded icon cache frames and reset its statistics
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_icon_cache_reset(Canvas* canvas);
+
 /** Add canvas commit callback.
  *
  * This callback will be called upon Canvas commit.
@@ -3,6 +3,8 @@
 #include <assets_icons.h>
 #include <storage/storage.h>
 #include <storage/storage_i.h>
+#include <cli/cli.h>
+#include <toolbox/args.h>
 
 #define TAG "GuiSrv"
 
@@ -638,12 +640,64 @@ Gui* gui_alloc(void) {
     return gui;
 }
 
+static void gui_cli_icon_cache(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    Gui* gui = context;
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            CanvasIconCacheStats stats;
+            gui_lock(gui);
+            canvas_icon_cache_get_stats(gui->canvas, &stats);
+            gui_unlock(gui);
+
+            const uint32_t total = stats.hits + stats.misses;
+            printf(
+                "Hits: %lu\r\nMisses: %lu\r\nHit rate: %lu%%\r\nEvictions: %lu\r\n"
+                "Entries: %zu\r\nUsed: %zu/%zu bytes\r\n",
+                stats.hits,
+                stats.misses,
+                total ? (uint32_t)((uint64_t)stats.hits * 100 / total) : 0,
+                stats.evictions,
+                stats.entries,
+                stats.used,
+                stats.budget);
+        } else if(furi_string_cmp_str(cmd, "reset") == 0) {
+            gui_lock(gui);
+            canvas_icon_cache_reset(gui->canvas);
+            gui_unlock(gui);
+        } else if(furi_string_cmp_str(cmd, "budget") == 0) {
+            int budget;
+            if(!args_read_int_and_trim(args, &budget) || budget < 0) {
+                printf("Usage: icon_cache budget <bytes>\r\n");
+                break;
+            }
+            gui_lock(gui);
+            canvas_icon_cache_set_budget(gui->canvas, budget);
+            gui_unlock(gui);
+        } else {
+            printf("Usage: icon_cache [reset|budget <bytes>]\r\n");
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 int32_t gui_srv(void* p) {
     UNUSED(p);
     Gui* gui = gui_alloc();
 
     furi_record_create(RECORD_GUI, gui);
 
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_add_command(cli, "icon_cache", CliCommandFlagParallelSafe, gui_cli_icon_cache, gui);
+    furi_record_close(RECORD_CLI);
+#else
+    UNUSED(gui_cli_icon_cache);
+#endif
+
     while(1) {
         uint32_t flags =
             furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
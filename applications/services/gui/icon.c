@@ -3,6 +3,7 @@
 #include <furi.h>
 
 #include <furi.h>
+#include <momentum/momentum.h>
 
 uint16_t icon_get_width(const Icon* instance) {
     furi_check(instance);
@@ -28,5 +29,22 @@ uint32_t icon_get_frame_count(const Icon* instance) {
 
 const uint8_t* icon_get_frame_data(const Icon* instance, uint32_t frame) {
     furi_check(frame < instance->frame_count);
+    if(instance->original) {
+        return asset_packs_get_icon_frame(instance, frame);
+    }
     return instance->frames[frame];
 }
+
+const uint8_t* icon_acquire_frame_data(const Icon* instance, uint32_t frame) {
+    furi_check(frame < instance->frame_count);
+    if(instance->original) {
+        return asset_packs_pin_icon_frame(instance, frame);
+    }
+    return instance->frames[frame];
+}
+
+void icon_release_frame_data(const Icon* instance) {
+    if(instance->original) {
+        asset_packs_unpin_icon_frame(instance);
+    }
+}
@@ -34,7 +34,7 @@ void icon_animation_set_update_callback(
 }
 
 const uint8_t* icon_animation_get_data(const IconAnimation* instance) {
-    return instance->icon->frames[instance->frame];
+    return icon_get_frame_data(instance->icon, instance->frame);
 }
 
 void icon_animation_next_frame(IconAnimation* instance) {
@@ -17,3 +17,20 @@ struct Icon {
 
     Icon* original;
 };
+
+/** Get frame data that stays valid until icon_release_frame_data()
+ *
+ * Asset pack icons may be unloaded when heap runs low, use while drawing.
+ *
+ * @param      instance  pointer to Icon data
+ * @param      frame     frame index
+ *
+ * @return     pointer to compressed frame data
+ */
+const uint8_t* icon_acquire_frame_data(const Icon* instance, uint32_t frame);
+
+/** Release frame data acquired with icon_acquire_frame_data()
+ *
+ * @param      instance  pointer to Icon data
+ */
+void icon_release_frame_data(const Icon* instance);
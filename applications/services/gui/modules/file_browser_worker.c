@@ -8,6 +8,9 @@
 #include <core/common_defines.h>
 #include <furi.h>
 
+#include <furi_hal_rtc.h>
+#include <momentum/momentum.h>
+
 #include <m-array.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -18,6 +21,17 @@
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
 #define FILE_NAME_LEN_MAX 254
 #define LONG_LOAD_THRESHOLD 100
+#define DIR_READ_BATCH 8
+
+#define BROWSER_CACHE_FOLDER EXT_PATH(".cache/browser")
+#define BROWSER_CACHE_MAGIC (0x32434442UL) // "BDC2"
+#define BROWSER_CACHE_MAX_FILES (32U)
+#define BROWSER_CACHE_MIN_ITEMS LONG_LOAD_THRESHOLD
+#define BROWSER_CACHE_SORT_MAX (1024U)
+#define BROWSER_CACHE_SORT_ITEM (sizeof(void*) + sizeof(StorageIoVec) + sizeof(uint32_t))
+#define BROWSER_CACHE_IO_SIZE (512U)
+#define BROWSER_CACHE_TABLE_CHUNK (32U)
+#define BROWSER_CACHE_TIMESTAMP_WINDOW (3U) // FAT timestamps have 2 second resolution
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -57,6 +71,10 @@ struct BrowserWorker {
 
     bool keep_selection;
     FuriString* passed_ext_filter;
+
+    FuriString* cache_key;
+    FuriString* cache_path;
+    bool cache_ready;
 };
 
 static bool browser_path_is_file(FuriString* path) {
@@ -170,6 +188,520 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+typedef struct {
+    File* directory;
+    FileInfo file_info[DIR_READ_BATCH];
+    char name[DIR_READ_BATCH][FILE_NAME_LEN_MAX];
+    size_t count;
+    size_t pos;
+} BrowserDirReader;
+
+static BrowserDirReader* browser_dir_reader_alloc(File* directory) {
+    BrowserDirReader* reader = malloc(sizeof(BrowserDirReader));
+    reader->directory = directory;
+    return reader;
+}
+
+static void browser_dir_reader_free(BrowserDirReader* reader) {
+    free(reader);
+}
+
+// Fetch directory entries in batches, one storage call per DIR_READ_BATCH entries
+static bool
+    browser_dir_reader_next(BrowserDirReader* reader, FileInfo** file_info, const char** name) {
+    if(reader->pos == reader->count) {
+        reader->pos = 0;
+        reader->count = storage_dir_read_batch(
+            reader->directory,
+            reader->file_info,
+            &reader->name[0][0],
+            FILE_NAME_LEN_MAX,
+            DIR_READ_BATCH);
+        if(reader->count == 0) {
+            return false;
+        }
+    }
+
+    *file_info = &reader->file_info[reader->pos];
+    *name = reader->name[reader->pos];
+    reader->pos++;
+    return true;
+}
+
+static bool browser_dir_reader_rewind(BrowserDirReader* reader) {
+    reader->pos = 0;
+    reader->count = 0;
+    return storage_dir_rewind(reader->directory);
+}
+
+/*
+ * Listing cache
+ *
+ * Filtered listings of big SD card folders are saved to BROWSER_CACHE_FOLDER, one file
+ * per folder and filter, so that entering the folder again only reads the requested page.
+ * The cache is valid for as long as the folder timestamp stays the same, storage service
+ * updates it whenever folder contents change. Changes made on a PC don't always touch the
+ * folder timestamp, so the raw entry count and size are compared as well, which only costs
+ * an unfiltered directory read. The cache folder keeps BROWSER_CACHE_MAX_FILES newest files,
+ * files of removed folders eventually get evicted.
+ *
+ * Layout: header, key, records, table of record offsets
+ */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t timestamp;
+    uint32_t key_size;
+    uint32_t count;
+    uint32_t records_size;
+    uint32_t entries;
+    uint64_t entries_size;
+    uint8_t sorted;
+} FURI_PACKED BrowserCacheHeader;
+
+typedef struct {
+    uint32_t size;
+    uint8_t is_dir;
+    uint8_t name_size; // Including terminator
+} FURI_PACKED BrowserCacheRecord;
+
+ARRAY_DEF(BrowserCacheSizeArray, uint16_t, M_POD_OPLIST)
+
+typedef struct {
+    File* file;
+    uint8_t buffer[BROWSER_CACHE_IO_SIZE];
+    size_t size;
+    size_t pos;
+} BrowserCacheReader;
+
+typedef struct {
+    File* file;
+    BrowserCacheSizeArray_t sizes;
+    uint32_t records_size;
+    uint32_t entries;
+    uint64_t entries_size;
+    uint8_t buffer[BROWSER_CACHE_IO_SIZE];
+    size_t size;
+    bool error;
+} BrowserCacheWriter;
+
+static bool browser_cache_prepare(BrowserWorker* browser, FuriString* path) {
+    browser->cache_ready = false;
+
+    if(!furi_string_start_with_str(path, STORAGE_EXT_PATH_PREFIX "/") &&
+       !furi_string_start_with_str(path, STORAGE_ANY_PATH_PREFIX "/")) {
+        return false;
+    }
+    if(furi_string_start_with_str(path, BROWSER_CACHE_FOLDER)) {
+        return false;
+    }
+
+    furi_string_printf(
+        browser->cache_key,
+        "%s\n%s\n%d%d%d",
+        furi_string_get_cstr(path),
+        furi_string_get_cstr(browser->passed_ext_filter),
+        browser->skip_assets,
+        browser->hide_dot_files,
+        momentum_settings.sort_dirs_first);
+
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    const char* key = furi_string_get_cstr(browser->cache_key);
+    for(size_t i = 0; key[i]; i++) {
+        hash = (hash ^ (uint8_t)key[i]) * 16777619UL;
+    }
+    furi_string_printf(browser->cache_path, "%s/%08lX.bdc", BROWSER_CACHE_FOLDER, hash);
+
+    return true;
+}
+
+static bool browser_cache_open(BrowserWorker* browser, File* file, BrowserCacheHeader* header) {
+    bool success = false;
+    const size_t key_size = furi_string_size(browser->cache_key);
+    char* key = malloc(key_size);
+
+    do {
+        const char* cache_path = furi_string_get_cstr(browser->cache_path);
+        if(!storage_file_open(file, cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, header, sizeof(*header)) != sizeof(*header)) break;
+        if(header->magic != BROWSER_CACHE_MAGIC || header->key_size != key_size) break;
+        if(storage_file_read(file, key, key_size) != key_size) break;
+        if(memcmp(key, furi_string_get_cstr(browser->cache_key), key_size) != 0) break;
+        success = true;
+    } while(false);
+
+    free(key);
+    return success;
+}
+
+static bool browser_cache_seek(File* file, const BrowserCacheHeader* header, uint32_t index) {
+    const uint32_t records_start = sizeof(BrowserCacheHeader) + header->key_size;
+    const uint32_t table_start = records_start + header->records_size;
+    uint32_t offset;
+
+    if(index >= header->count) return false;
+    if(!storage_file_seek(file, table_start + index * sizeof(uint32_t), true)) return false;
+    if(storage_file_read(file, &offset, sizeof(offset)) != sizeof(offset)) return false;
+    return storage_file_seek(file, records_start + offset, true);
+}
+
+static bool browser_cache_reader_fill(BrowserCacheReader* reader, size_t need) {
+    if(reader->size - reader->pos >= need) {
+        return true;
+    }
+
+    memmove(reader->buffer, reader->buffer + reader->pos, reader->size - reader->pos);
+    reader->size -= reader->pos;
+    reader->pos = 0;
+    reader->size += storage_file_read(
+        reader->file, reader->buffer + reader->size, BROWSER_CACHE_IO_SIZE - reader->size);
+
+    return reader->size >= need;
+}
+
+// Read next record from the current file position
+static bool browser_cache_reader_next(BrowserCacheReader* reader, bool* is_dir, char** name) {
+    BrowserCacheRecord record;
+
+    if(!browser_cache_reader_fill(reader, sizeof(record))) return false;
+    memcpy(&record, reader->buffer + reader->pos, sizeof(record));
+    if(record.name_size == 0 || record.name_size > FILE_NAME_LEN_MAX) return false;
+    if(!browser_cache_reader_fill(reader, sizeof(record) + record.name_size)) return false;
+
+    *is_dir = record.is_dir;
+    *name = (char*)reader->buffer + reader->pos + sizeof(record);
+    (*name)[record.name_size - 1] = '\0';
+    reader->pos += sizeof(record) + record.name_size;
+
+    return true;
+}
+
+// Compare raw folder contents with the ones the cache was made from
+static bool browser_cache_check(BrowserDirReader* dir_reader, const BrowserCacheHeader* header) {
+    FileInfo* file_info;
+    const char* name;
+    uint32_t entries = 0;
+    uint64_t entries_size = 0;
+
+    while(browser_dir_reader_next(dir_reader, &file_info, &name)) {
+        if(name[0] != '\0') {
+            entries++;
+            entries_size += file_info->size;
+        }
+    }
+
+    return entries == header->entries && entries_size == header->entries_size;
+}
+
+static bool browser_cache_lookup(
+    BrowserWorker* browser,
+    Storage* storage,
+    BrowserDirReader* dir_reader,
+    uint32_t timestamp,
+    FuriString* filename,
+    uint32_t* item_cnt,
+    int32_t* file_idx) {
+    BrowserCacheHeader header;
+    BrowserCacheReader* reader = malloc(sizeof(BrowserCacheReader));
+    reader->file = storage_file_alloc(storage);
+    bool success = false;
+
+    if(browser_cache_open(browser, reader->file, &header) && header.timestamp == timestamp &&
+       browser_cache_check(dir_reader, &header)) {
+        *item_cnt = header.count;
+        if(!furi_string_empty(filename)) {
+            bool is_dir;
+            char* name;
+            for(uint32_t i = 0; i < header.count; i++) {
+                if(!browser_cache_reader_next(reader, &is_dir, &name)) break;
+                if(furi_string_cmp_str(filename, name) == 0) {
+                    *file_idx = i;
+                    break;
+                }
+            }
+        }
+        success = true;
+    }
+
+    storage_file_free(reader->file);
+    free(reader);
+    return success;
+}
+
+static bool browser_cache_load(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    BrowserCacheHeader header;
+    BrowserCacheReader* reader = malloc(sizeof(BrowserCacheReader));
+    reader->file = storage_file_alloc(storage);
+    FuriString* name_str = furi_string_alloc();
+    bool success = false;
+
+    do {
+        if(!browser_cache_open(browser, reader->file, &header)) break;
+        if(offset < header.count && !browser_cache_seek(reader->file, &header, offset)) break;
+        success = true;
+
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+
+        bool is_dir;
+        char* name;
+        for(uint32_t i = offset; (i < header.count) && (i - offset < count); i++) {
+            if(!browser_cache_reader_next(reader, &is_dir, &name)) break;
+            furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name);
+            if(browser->list_item_cb) {
+                browser->list_item_cb(browser->cb_ctx, name_str, is_dir, false);
+            }
+        }
+
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+        }
+    } while(false);
+
+    furi_string_free(name_str);
+    storage_file_free(reader->file);
+    free(reader);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!success) {
+        browser->cache_ready = false;
+    }
+    return success;
+}
+
+// Make room for one more cache file by removing the oldest one
+static void browser_cache_prune(Storage* storage) {
+    File* directory = storage_file_alloc(storage);
+    FuriString* file_path = furi_string_alloc();
+    FuriString* oldest_path = furi_string_alloc();
+    char name[FILE_NAME_LEN_MAX];
+    FileInfo file_info;
+    uint32_t oldest_timestamp = UINT32_MAX;
+    size_t count = 0;
+
+    if(storage_dir_open(directory, BROWSER_CACHE_FOLDER)) {
+        while(storage_dir_read(directory, &file_info, name, sizeof(name))) {
+            if(file_info_is_dir(&file_info)) continue;
+            count++;
+
+            uint32_t timestamp = 0;
+            furi_string_printf(file_path, "%s/%s", BROWSER_CACHE_FOLDER, name);
+            storage_common_timestamp(storage, furi_string_get_cstr(file_path), &timestamp);
+            if(timestamp < oldest_timestamp) {
+                oldest_timestamp = timestamp;
+                furi_string_set(oldest_path, file_path);
+            }
+        }
+    }
+    storage_dir_close(directory);
+    storage_file_free(directory);
+
+    if(count >= BROWSER_CACHE_MAX_FILES) {
+        storage_simply_remove(storage, furi_string_get_cstr(oldest_path));
+    }
+
+    furi_string_free(oldest_path);
+    furi_string_free(file_path);
+}
+
+static BrowserCacheWriter* browser_cache_writer_alloc(BrowserWorker* browser, Storage* storage) {
+    storage_simply_mkdir(storage, EXT_PATH(".cache"));
+    storage_simply_mkdir(storage, BROWSER_CACHE_FOLDER);
+    browser_cache_prune(storage);
+
+    File* file = storage_file_alloc(storage);
+    // Magic is written on completion
+    BrowserCacheHeader header = {0};
+    const char* cache_path = furi_string_get_cstr(browser->cache_path);
+    const size_t key_size = furi_string_size(browser->cache_key);
+
+    if(!storage_file_open(file, cache_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS) ||
+       storage_file_write(file, &header, sizeof(header)) != sizeof(header) ||
+       storage_file_write(file, furi_string_get_cstr(browser->cache_key), key_size) !=
+           key_size) {
+        storage_file_free(file);
+        storage_simply_remove(storage, cache_path);
+        return NULL;
+    }
+
+    BrowserCacheWriter* writer = malloc(sizeof(BrowserCacheWriter));
+    writer->file = file;
+    BrowserCacheSizeArray_init(writer->sizes);
+    return writer;
+}
+
+static void browser_cache_writer_flush(BrowserCacheWriter* writer) {
+    if(!writer->error && writer->size) {
+        writer->error = storage_file_write(writer->file, writer->buffer, writer->size) !=
+                        writer->size;
+    }
+    writer->size = 0;
+}
+
+static void browser_cache_writer_append(
+    BrowserCacheWriter* writer,
+    const FileInfo* file_info,
+    const char* name) {
+    const size_t name_size = strlen(name) + 1;
+    const BrowserCacheRecord record = {
+        .size = MIN(file_info->size, UINT32_MAX),
+        .is_dir = file_info_is_dir(file_info),
+        .name_size = name_size,
+    };
+    const size_t record_size = sizeof(record) + name_size;
+
+    if(writer->size + record_size > BROWSER_CACHE_IO_SIZE) {
+        browser_cache_writer_flush(writer);
+    }
+    memcpy(writer->buffer + writer->size, &record, sizeof(record));
+    memcpy(writer->buffer + writer->size + sizeof(record), name, name_size);
+    writer->size += record_size;
+    writer->records_size += record_size;
+    BrowserCacheSizeArray_push_back(writer->sizes, record_size);
+}
+
+static int browser_cache_record_cmp(const void* a, const void* b) {
+    const BrowserCacheRecord* record_a = *(const BrowserCacheRecord* const*)a;
+    const BrowserCacheRecord* record_b = *(const BrowserCacheRecord* const*)b;
+
+    if(momentum_settings.sort_dirs_first && (record_a->is_dir != record_b->is_dir)) {
+        return record_a->is_dir ? -1 : 1;
+    }
+    return strcasecmp((const char*)(record_a + 1), (const char*)(record_b + 1));
+}
+
+// Rewrite records in sorted order, same as the browser views sort them
+static bool browser_cache_writer_sort(
+    BrowserCacheWriter* writer,
+    const BrowserCacheHeader* header,
+    int32_t* file_idx) {
+    const uint32_t records_start = sizeof(BrowserCacheHeader) + header->key_size;
+    uint8_t* records = malloc(header->records_size);
+    const BrowserCacheRecord** items = malloc(header->count * sizeof(BrowserCacheRecord*));
+    StorageIoVec* iov = malloc(header->count * sizeof(StorageIoVec));
+    uint32_t* table = malloc(header->count * sizeof(uint32_t));
+    bool success = false;
+
+    do {
+        if(!storage_file_seek(writer->file, records_start, true)) break;
+        if(storage_file_read(writer->file, records, header->records_size) !=
+           header->records_size)
+            break;
+
+        uint32_t offset = 0;
+        for(uint32_t i = 0; i < header->count; i++) {
+            items[i] = (const BrowserCacheRecord*)(records + offset);
+            offset += *BrowserCacheSizeArray_get(writer->sizes, i);
+        }
+
+        const BrowserCacheRecord* selected = (*file_idx >= 0) ? items[*file_idx] : NULL;
+        qsort(items, header->count, sizeof(items[0]), browser_cache_record_cmp);
+
+        offset = 0;
+        for(uint32_t i = 0; i < header->count; i++) {
+            const size_t record_size = sizeof(BrowserCacheRecord) + items[i]->name_size;
+            iov[i] = (StorageIoVec){.buff = (void*)items[i], .size = record_size};
+            table[i] = offset;
+            offset += record_size;
+            if(items[i] == selected) {
+                *file_idx = i;
+            }
+        }
+
+        if(!storage_file_seek(writer->file, records_start, true)) break;
+        if(storage_file_writev(writer->file, iov, header->count) != header->records_size) break;
+        const size_t table_size = header->count * sizeof(uint32_t);
+        if(storage_file_write(writer->file, table, table_size) != table_size) break;
+
+        success = true;
+    } while(false);
+
+    free(table);
+    free(iov);
+    free(items);
+    free(records);
+    return success;
+}
+
+static bool browser_cache_writer_table(BrowserCacheWriter* writer) {
+    uint32_t table[BROWSER_CACHE_TABLE_CHUNK];
+    uint32_t offset = 0;
+    size_t count = BrowserCacheSizeArray_size(writer->sizes);
+
+    for(size_t i = 0; i < count; i += BROWSER_CACHE_TABLE_CHUNK) {
+        size_t chunk = MIN(count - i, BROWSER_CACHE_TABLE_CHUNK);
+        for(size_t j = 0; j < chunk; j++) {
+            table[j] = offset;
+            offset += *BrowserCacheSizeArray_get(writer->sizes, i + j);
+        }
+        if(storage_file_write(writer->file, table, chunk * sizeof(uint32_t)) !=
+           chunk * sizeof(uint32_t)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Complete the cache file, or remove it if the listing is not worth caching
+static bool browser_cache_writer_finish(
+    BrowserWorker* browser,
+    Storage* storage,
+    BrowserCacheWriter* writer,
+    uint32_t timestamp,
+    int32_t* file_idx) {
+    BrowserCacheHeader header = {
+        .magic = BROWSER_CACHE_MAGIC,
+        .timestamp = timestamp,
+        .key_size = furi_string_size(browser->cache_key),
+        .count = BrowserCacheSizeArray_size(writer->sizes),
+        .records_size = writer->records_size,
+        .entries = writer->entries,
+        .entries_size = writer->entries_size,
+        .sorted = false,
+    };
+    bool success = false;
+
+    browser_cache_writer_flush(writer);
+
+    do {
+        if(writer->error) break;
+        if(header.count < BROWSER_CACHE_MIN_ITEMS) break;
+        // A change within the same timestamp tick would go unnoticed
+        if(furi_hal_rtc_get_timestamp() - timestamp < BROWSER_CACHE_TIMESTAMP_WINDOW) break;
+
+        const size_t sort_memory = header.records_size + header.count * BROWSER_CACHE_SORT_ITEM;
+        if(header.count <= BROWSER_CACHE_SORT_MAX &&
+           sort_memory * 2 < memmgr_heap_get_max_free_block()) {
+            if(!browser_cache_writer_sort(writer, &header, file_idx)) break;
+            header.sorted = true;
+        } else {
+            if(!browser_cache_writer_table(writer)) break;
+        }
+
+        if(!storage_file_seek(writer->file, 0, true)) break;
+        if(storage_file_write(writer->file, &header, sizeof(header)) != sizeof(header)) break;
+
+        success = true;
+    } while(false);
+
+    storage_file_free(writer->file);
+    BrowserCacheSizeArray_clear(writer->sizes);
+    free(writer);
+
+    if(!success) {
+        storage_simply_remove(storage, furi_string_get_cstr(browser->cache_path));
+    }
+    return success;
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -177,36 +709,68 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
+    FileInfo* file_info;
+    const char* name_temp;
     uint32_t total_files_cnt = 0;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(directory);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
     *item_cnt = 0;
     *file_idx = -1;
 
-    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+    uint32_t timestamp = 0;
+    BrowserCacheWriter* cache = NULL;
+    bool use_cache = browser_cache_prepare(browser, path) &&
+                     storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp) ==
+                         FSE_OK;
+    bool dir_open = storage_dir_open(directory, furi_string_get_cstr(path));
+    if(dir_open && use_cache) {
+        browser->cache_ready = browser_cache_lookup(
+            browser, storage, reader, timestamp, filename, item_cnt, file_idx);
+        dir_open = browser->cache_ready || browser_dir_reader_rewind(reader);
+    }
+
+    if(browser->cache_ready) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
+    } else if(dir_open) {
+        state = true;
+        while(browser_dir_reader_next(reader, &file_info, &name_temp)) {
+            if(name_temp[0] != '\0') {
                 total_files_cnt++;
+                if(cache) {
+                    cache->entries++;
+                    cache->entries_size += file_info->size;
+                }
                 furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                if(browser_filter_by_name(browser, name_str, file_info_is_dir(file_info))) {
                     if(!furi_string_empty(filename)) {
                         if(furi_string_cmp(name_str, filename) == 0) {
                             *file_idx = *item_cnt;
                         }
                     }
+                    if(cache) {
+                        browser_cache_writer_append(cache, file_info, name_temp);
+                    }
                     (*item_cnt)++;
                 }
+                if(use_cache && *item_cnt == BROWSER_CACHE_MIN_ITEMS) {
+                    // Folder is big enough to be cached, list it again into the cache
+                    use_cache = false;
+                    cache = browser_cache_writer_alloc(browser, storage);
+                    if(cache && browser_dir_reader_rewind(reader)) {
+                        *item_cnt = 0;
+                        *file_idx = -1;
+                    } else if(cache) {
+                        // Removes the empty cache file
+                        browser_cache_writer_finish(browser, storage, cache, timestamp, file_idx);
+                        cache = NULL;
+                    }
+                }
                 if(total_files_cnt == LONG_LOAD_THRESHOLD) {
                     // There are too many files in folder and counting them will take some time - send callback to app
                     if(browser->long_load_cb) {
@@ -215,10 +779,15 @@ static bool browser_folder_init(
                 }
             }
         }
+        if(cache) {
+            browser->cache_ready =
+                browser_cache_writer_finish(browser, storage, cache, timestamp, file_idx);
+        }
     }
 
     furi_string_free(name_str);
 
+    browser_dir_reader_free(reader);
     storage_dir_close(directory);
     storage_file_free(directory);
 
@@ -233,12 +802,13 @@ static bool browser_folder_load_chunked(
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
-    FileInfo file_info;
+    FileInfo* file_info;
+    const char* name_temp;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(directory);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -251,16 +821,12 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!browser_dir_reader_next(reader, &file_info, &name_temp)) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_set(name_str, name_temp);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(file_info))) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -273,21 +839,17 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!browser_dir_reader_next(reader, &file_info, &name_temp)) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
-                    }
-                    items_cnt++;
+            furi_string_set(name_str, name_temp);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(file_info))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx, name_str, file_info_is_dir(file_info), false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -297,6 +859,7 @@ static bool browser_folder_load_chunked(
 
     furi_string_free(name_str);
 
+    browser_dir_reader_free(reader);
     storage_dir_close(directory);
     storage_file_free(directory);
 
@@ -307,12 +870,13 @@ static bool browser_folder_load_chunked(
 
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
-    FileInfo file_info;
+    FileInfo* file_info;
+    const char* name_temp;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(directory);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -326,14 +890,13 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
+        while(browser_dir_reader_next(reader, &file_info, &name_temp)) {
             furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(file_info))) {
                 furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
                 if(browser->list_item_cb) {
                     browser->list_item_cb(
-                        browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
+                        browser->cb_ctx, name_str, file_info_is_dir(file_info), false);
                 }
                 items_cnt++;
             }
@@ -346,6 +909,7 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
 
     furi_string_free(name_str);
 
+    browser_dir_reader_free(reader);
     storage_dir_close(directory);
     storage_file_free(directory);
 
@@ -474,10 +1038,15 @@ static int32_t browser_worker(void* context) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
             if(items_cnt > BROWSER_SORT_THRESHOLD) {
-                browser_folder_load_chunked(
-                    browser, path, browser->load_offset, browser->load_count);
+                if(!browser->cache_ready ||
+                   !browser_cache_load(browser, path, browser->load_offset, browser->load_count)) {
+                    browser_folder_load_chunked(
+                        browser, path, browser->load_offset, browser->load_count);
+                }
             } else {
-                browser_folder_load_full(browser, path);
+                if(!browser->cache_ready || !browser_cache_load(browser, path, 0, UINT32_MAX)) {
+                    browser_folder_load_full(browser, path);
+                }
             }
         }
 
@@ -511,6 +1080,9 @@ BrowserWorker* file_browser_worker_alloc(
     browser->path_current = furi_string_alloc_set(path);
     browser->path_next = furi_string_alloc_set(path);
 
+    browser->cache_key = furi_string_alloc();
+    browser->cache_path = furi_string_alloc();
+
     browser->path_start = furi_string_alloc();
     if(base_path) {
         furi_string_set_str(browser->path_start, base_path);
@@ -533,6 +1105,8 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_current);
     furi_string_free(browser->path_start);
     furi_string_free(browser->passed_ext_filter);
+    furi_string_free(browser->cache_key);
+    furi_string_free(browser->cache_path);
 
     ExtFilterArray_clear(browser->ext_filter);
 
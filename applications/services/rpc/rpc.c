@@ -84,6 +84,7 @@ struct RpcSession {
     RpcSessionClosedCallback closed_callback;
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
+    size_t max_data_size;
     void* context;
 };
 
@@ -180,6 +181,17 @@ size_t rpc_session_feed(
     return bytes_sent;
 }
 
+void rpc_session_set_max_data_size(RpcSession* session, size_t size) {
+    furi_check(session);
+    furi_check(size && size <= UINT16_MAX);
+    session->max_data_size = size;
+}
+
+size_t rpc_session_get_max_data_size(RpcSession* session) {
+    furi_check(session);
+    return session->max_data_size;
+}
+
 size_t rpc_session_get_available_size(RpcSession* session) {
     furi_check(session);
     return furi_stream_buffer_spaces_available(session->stream);
@@ -396,6 +408,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
+    session->max_data_size = RPC_DATA_SIZE_DEFAULT;
     RpcHandlerDict_init(session->handlers);
 
     session->decoded_message = malloc(sizeof(PB_Main));
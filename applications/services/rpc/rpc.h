@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 #define RPC_BUFFER_SIZE (1024)
+#define RPC_DATA_SIZE_DEFAULT (512)
 
 #define RECORD_RPC "rpc"
 
@@ -52,6 +52,8 @@ typedef enum {
 #define RpcGuiWorkerFlagAny (RpcGuiWorkerFlagTransmit | RpcGuiWorkerFlagExit)
 
 #define RPC_GUI_INPUT_RESET (0u)
+// Unchanged frames are skipped, but still sent this often to refresh the remote screen
+#define RPC_GUI_KEYFRAME_INTERVAL_MS (1000u)
 
 typedef struct {
     RpcSession* session;
@@ -66,6 +68,7 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    uint32_t keyframe_tick;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -83,6 +86,18 @@ static const PB_Gui_ScreenOrientation rpc_system_gui_screen_orientation_map[] =
     [CanvasOrientationVerticalFlip] = PB_Gui_ScreenOrientation_VERTICAL_FLIP,
 };
 
+static uint32_t rpc_system_gui_screen_color(ScreenFrameColor color) {
+    if(color.mode == ScreenColorModeRgbBacklight) {
+        if(rgb_backlight_get_rainbow_mode() == RGBBacklightRainbowModeOff) {
+            color.mode = ScreenColorModeCustom;
+            rgb_backlight_get_color(0, &color.rgb);
+        } else {
+            color.mode = ScreenColorModeRainbow;
+        }
+    }
+    return color.value;
+}
+
 static void rpc_system_gui_screen_stream_frame_callback(
     uint8_t* data,
     size_t size,
@@ -92,41 +107,27 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    furi_assert(size == frame->data->size);
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+    PB_Gui_ScreenOrientation frame_orientation = rpc_system_gui_screen_orientation_map[orientation];
+    uint32_t fg_color_value = rpc_system_gui_screen_color(momentum_settings.rpc_color_fg);
+    uint32_t bg_color_value = rpc_system_gui_screen_color(momentum_settings.rpc_color_bg);
 
-    if(momentum_settings.rpc_color_fg.mode == ScreenColorModeRgbBacklight) {
-        ScreenFrameColor fg_color;
-        if(rgb_backlight_get_rainbow_mode() == RGBBacklightRainbowModeOff) {
-            fg_color.mode = ScreenColorModeCustom;
-            rgb_backlight_get_color(0, &fg_color.rgb);
-        } else {
-            fg_color.mode = ScreenColorModeRainbow;
-        }
-        rpc_gui->transmit_frame->content.gui_screen_frame.fg_color = fg_color.value;
-    } else {
-        rpc_gui->transmit_frame->content.gui_screen_frame.fg_color =
-            momentum_settings.rpc_color_fg.value;
+    // Canvas is committed on every redraw, most of them don't change the screen
+    uint32_t tick = furi_get_tick();
+    if(tick - rpc_gui->keyframe_tick < furi_ms_to_ticks(RPC_GUI_KEYFRAME_INTERVAL_MS) &&
+       frame->orientation == frame_orientation && frame->fg_color == fg_color_value &&
+       frame->bg_color == bg_color_value && memcmp(frame->data->bytes, data, size) == 0) {
+        return;
     }
+    rpc_gui->keyframe_tick = tick;
 
-    if(momentum_settings.rpc_color_bg.mode == ScreenColorModeRgbBacklight) {
-        ScreenFrameColor bg_color;
-        if(rgb_backlight_get_rainbow_mode() == RGBBacklightRainbowModeOff) {
-            bg_color.mode = ScreenColorModeCustom;
-            rgb_backlight_get_color(0, &bg_color.rgb);
-        } else {
-            bg_color.mode = ScreenColorModeRainbow;
-        }
-        rpc_gui->transmit_frame->content.gui_screen_frame.bg_color = bg_color.value;
-    } else {
-        rpc_gui->transmit_frame->content.gui_screen_frame.bg_color =
-            momentum_settings.rpc_color_bg.value;
-    }
+    memcpy(frame->data->bytes, data, size);
+    frame->orientation = frame_orientation;
+    frame->fg_color = fg_color_value;
+    frame->bg_color = bg_color_value;
 
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
@@ -185,6 +186,8 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
             malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+        // First frame is always sent
+        rpc_gui->keyframe_tick = furi_get_tick() - furi_ms_to_ticks(RPC_GUI_KEYFRAME_INTERVAL_MS);
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
@@ -50,6 +50,10 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context);
 
 PB_CommandStatus rpc_system_storage_get_error(FS_Error fs_error);
 
+// Max size of data chunk in responses, RPC_DATA_SIZE_DEFAULT unless changed by tests
+void rpc_session_set_max_data_size(RpcSession* session, size_t size);
+size_t rpc_session_get_max_data_size(RpcSession* session);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
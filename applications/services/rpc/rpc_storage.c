@@ -1,11 +1,13 @@
 #include <core/common_defines.h>
 #include <core/memmgr.h>
 #include <core/record.h>
+#include <furi_hal_rtc.h>
 #include <rpc/rpc.h>
 #include <rpc/rpc_i.h>
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
 #include <lib/toolbox/md5_calc.h>
+#include <lib/toolbox/crc32_calc.h>
 #include <lib/toolbox/path.h>
 #include <update_util/lfs_backup.h>
 #include <toolbox/tar/tar_archive.h>
@@ -17,22 +19,121 @@
 #define TAG "RpcStorage"
 
 #define MAX_NAME_LENGTH 254
-
-static const size_t MAX_DATA_SIZE = 512;
+#define DIR_READ_BATCH 8
+#define READ_BUFFERS_COUNT 2
+#define READ_WORKER_STACK_SIZE 2048
+#define WRITE_BUFFER_SIZE 4096
+#define MD5_HASH_SIZE 16
+#define MD5_CACHE_SIZE 64
+#define MD5_CACHE_TIMESTAMP_WINDOW (3U) // FAT timestamps have 2 second resolution
 
 typedef enum {
     RpcStorageStateIdle = 0,
     RpcStorageStateWriting,
 } RpcStorageState;
 
+typedef struct {
+    char* path;
+    uint32_t timestamp;
+    uint64_t size;
+    uint8_t md5[MD5_HASH_SIZE];
+} RpcStorageMd5CacheEntry;
+
 typedef struct {
     RpcSession* session;
     Storage* api;
     File* file;
+    RpcStorageMd5CacheEntry* md5_cache;
+    uint8_t* write_buffer;
+    size_t write_buffer_used;
     RpcStorageState state;
     uint32_t current_command_id;
 } RpcStorageSystem;
 
+typedef struct {
+    File* file;
+    size_t size;
+    size_t data_size;
+    pb_bytes_array_t* buffers[READ_BUFFERS_COUNT];
+    FuriMessageQueue* free_queue;
+    FuriMessageQueue* filled_queue;
+} RpcStorageReader;
+
+static RpcStorageMd5CacheEntry*
+    rpc_system_storage_md5_cache_get(RpcStorageSystem* rpc_storage, const char* path) {
+    if(!rpc_storage->md5_cache) {
+        rpc_storage->md5_cache = malloc(sizeof(RpcStorageMd5CacheEntry) * MD5_CACHE_SIZE);
+    }
+
+    uint32_t hash = crc32_calc_buffer(0, path, strlen(path));
+    return &rpc_storage->md5_cache[hash % MD5_CACHE_SIZE];
+}
+
+/* Drop cached MD5 of path, or of all files if path is NULL */
+static void
+    rpc_system_storage_md5_cache_invalidate(RpcStorageSystem* rpc_storage, const char* path) {
+    if(!rpc_storage->md5_cache) return;
+
+    if(path) {
+        RpcStorageMd5CacheEntry* entry = rpc_system_storage_md5_cache_get(rpc_storage, path);
+        if(entry->path && !strcmp(entry->path, path)) {
+            free(entry->path);
+            entry->path = NULL;
+        }
+    } else {
+        for(size_t i = 0; i < MD5_CACHE_SIZE; i++) {
+            free(rpc_storage->md5_cache[i].path);
+            rpc_storage->md5_cache[i].path = NULL;
+        }
+    }
+}
+
+/* Files with the same size and timestamp are considered unchanged. Timestamp
+ * resolution is 2 seconds on SD card, so files changed by this session are
+ * invalidated explicitly and recently modified files are not cached. */
+static bool rpc_system_storage_md5_calc(
+    RpcStorageSystem* rpc_storage,
+    File* file,
+    const char* path,
+    uint64_t size,
+    char* md5sum,
+    size_t md5sum_size,
+    FS_Error* file_error) {
+    uint32_t timestamp = 0;
+    bool cacheable = (storage_common_timestamp(rpc_storage->api, path, &timestamp) == FSE_OK);
+    RpcStorageMd5CacheEntry* entry = rpc_system_storage_md5_cache_get(rpc_storage, path);
+    uint8_t md5[MD5_HASH_SIZE];
+
+    if(cacheable && entry->path && !strcmp(entry->path, path) &&
+       entry->timestamp == timestamp && entry->size == size) {
+        memcpy(md5, entry->md5, MD5_HASH_SIZE);
+    } else {
+        if(!md5_calc_file(file, path, md5, file_error)) return false;
+
+        if(cacheable &&
+           furi_hal_rtc_get_timestamp() - timestamp >= MD5_CACHE_TIMESTAMP_WINDOW) {
+            free(entry->path);
+            entry->path = strdup(path);
+            entry->timestamp = timestamp;
+            entry->size = size;
+            memcpy(entry->md5, md5, MD5_HASH_SIZE);
+        }
+    }
+
+    for(size_t i = 0; i < MD5_HASH_SIZE; i++) {
+        snprintf(&md5sum[i * 2], md5sum_size - i * 2, "%02x", md5[i]);
+    }
+    return true;
+}
+
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    size_t size = rpc_storage->write_buffer_used;
+    rpc_storage->write_buffer_used = 0;
+    if(!size) return true;
+
+    return storage_file_write(rpc_storage->file, rpc_storage->write_buffer, size) == size;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -49,8 +150,12 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            // Keep data received before interruption, as unbuffered writes did
+            rpc_system_storage_write_flush(rpc_storage);
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
+            free(rpc_storage->write_buffer);
+            rpc_storage->write_buffer = NULL;
         }
 
         rpc_storage->state = RpcStorageStateIdle;
@@ -282,7 +387,6 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     PB_Storage_ListResponse* list = &response.content.storage_list_response;
 
     bool include_md5 = list_request->include_md5;
-    FuriString* md5 = furi_string_alloc();
     FuriString* md5_path = furi_string_alloc();
     File* file = storage_file_alloc(rpc_storage->api);
 
@@ -295,54 +399,161 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
         finish = true;
     }
 
+    FileInfo* fileinfos = malloc(sizeof(FileInfo) * DIR_READ_BATCH);
+    char* names = malloc(MAX_NAME_LENGTH * DIR_READ_BATCH);
+
     while(!finish) {
-        FileInfo fileinfo;
-        char* name = malloc(MAX_NAME_LENGTH);
-        if(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(rpc_system_storage_list_filter(list_request, &fileinfo, name)) {
-                if(i == COUNT_OF(list->file)) {
-                    list->file_count = i;
-                    response.has_next = true;
-                    rpc_send_and_release(session, &response);
-                    i = 0;
-                }
-                list->file[i].type = file_info_is_dir(&fileinfo) ? PB_Storage_File_FileType_DIR :
-                                                                   PB_Storage_File_FileType_FILE;
-                list->file[i].size = fileinfo.size;
-                list->file[i].data = NULL;
-                list->file[i].name = name;
-
-                if(include_md5 && !file_info_is_dir(&fileinfo)) {
-                    furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
-
-                    if(md5_string_calc_file(file, furi_string_get_cstr(md5_path), md5, NULL)) {
-                        char* md5sum = list->file[i].md5sum;
-                        size_t md5sum_size = sizeof(list->file[i].md5sum);
-                        snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
-                    }
-                }
+        size_t read =
+            storage_dir_read_batch(dir, fileinfos, names, MAX_NAME_LENGTH, DIR_READ_BATCH);
+        for(size_t j = 0; j < read; j++) {
+            const FileInfo* fileinfo = &fileinfos[j];
+            const char* name = &names[j * MAX_NAME_LENGTH];
+            if(!rpc_system_storage_list_filter(list_request, fileinfo, name)) {
+                continue;
+            }
 
-                ++i;
-            } else {
-                free(name);
+            if(i == COUNT_OF(list->file)) {
+                list->file_count = i;
+                response.has_next = true;
+                rpc_send_and_release(session, &response);
+                i = 0;
             }
-        } else {
+            list->file[i].type = file_info_is_dir(fileinfo) ? PB_Storage_File_FileType_DIR :
+                                                              PB_Storage_File_FileType_FILE;
+            list->file[i].size = fileinfo->size;
+            list->file[i].data = NULL;
+            list->file[i].name = strdup(name);
+
+            if(include_md5 && !file_info_is_dir(fileinfo)) {
+                furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
+
+                rpc_system_storage_md5_calc(
+                    rpc_storage,
+                    file,
+                    furi_string_get_cstr(md5_path),
+                    fileinfo->size,
+                    list->file[i].md5sum,
+                    sizeof(list->file[i].md5sum),
+                    NULL);
+            }
+
+            ++i;
+        }
+
+        if(read < DIR_READ_BATCH) {
             list->file_count = i;
             finish = true;
-            free(name);
         }
     }
 
+    free(fileinfos);
+    free(names);
+
     response.has_next = false;
     rpc_send_and_release(session, &response);
 
-    furi_string_free(md5);
     furi_string_free(md5_path);
     storage_dir_close(dir);
     storage_file_free(dir);
     storage_file_free(file);
 }
 
+static void rpc_system_storage_read_send(
+    RpcSession* session,
+    PB_Main* response,
+    uint32_t command_id,
+    pb_bytes_array_t* data,
+    bool has_next) {
+    response->command_id = command_id;
+    response->which_content = PB_Main_storage_read_response_tag;
+    response->command_status = PB_CommandStatus_OK;
+    response->has_next = has_next;
+    response->content.storage_read_response.has_file = true;
+    response->content.storage_read_response.file.data = data;
+
+    /* data buffers are reused by caller, don't release them */
+    rpc_send(session, response);
+    response->content.storage_read_response.file.data = NULL;
+}
+
+static int32_t rpc_system_storage_read_worker(void* context) {
+    RpcStorageReader* reader = context;
+
+    size_t size_left = reader->size;
+    while(size_left) {
+        uint8_t index;
+        furi_check(
+            furi_message_queue_get(reader->free_queue, &index, FuriWaitForever) == FuriStatusOk);
+
+        pb_bytes_array_t* data = reader->buffers[index];
+        size_t read_size = MIN(size_left, reader->data_size);
+        size_t size_read = storage_file_read(reader->file, data->bytes, read_size);
+        data->size = size_read;
+        furi_check(
+            furi_message_queue_put(reader->filled_queue, &index, FuriWaitForever) ==
+            FuriStatusOk);
+
+        if(size_read != read_size) break;
+        size_left -= read_size;
+    }
+
+    return 0;
+}
+
+/* Read next chunk from SD card while previous one is being sent */
+static bool rpc_system_storage_read_pipelined(
+    RpcSession* session,
+    PB_Main* response,
+    uint32_t command_id,
+    File* file,
+    size_t size,
+    size_t data_size) {
+    RpcStorageReader reader = {
+        .file = file,
+        .size = size,
+        .data_size = data_size,
+        .free_queue = furi_message_queue_alloc(READ_BUFFERS_COUNT, sizeof(uint8_t)),
+        .filled_queue = furi_message_queue_alloc(READ_BUFFERS_COUNT, sizeof(uint8_t)),
+    };
+    for(uint8_t i = 0; i < READ_BUFFERS_COUNT; i++) {
+        reader.buffers[i] = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(data_size));
+        furi_message_queue_put(reader.free_queue, &i, 0);
+    }
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "RpcStorageReader", READ_WORKER_STACK_SIZE, rpc_system_storage_read_worker, &reader);
+    furi_thread_start(thread);
+
+    bool success = true;
+    size_t size_left = size;
+    while(size_left && success) {
+        uint8_t index;
+        furi_check(
+            furi_message_queue_get(reader.filled_queue, &index, FuriWaitForever) == FuriStatusOk);
+
+        pb_bytes_array_t* data = reader.buffers[index];
+        size_t read_size = MIN(size_left, data_size);
+        success = (data->size == read_size);
+        if(success) {
+            size_left -= read_size;
+            rpc_system_storage_read_send(session, response, command_id, data, size_left > 0);
+        }
+
+        furi_message_queue_put(reader.free_queue, &index, FuriWaitForever);
+    }
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    for(uint8_t i = 0; i < READ_BUFFERS_COUNT; i++) {
+        free(reader.buffers[i]);
+    }
+    furi_message_queue_free(reader.filled_queue);
+    furi_message_queue_free(reader.free_queue);
+
+    return success;
+}
+
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -363,41 +574,24 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(fs_operation_success) {
-        size_t size_left = storage_file_size(file);
-        do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
+        size_t size = storage_file_size(file);
+        size_t data_size = rpc_session_get_max_data_size(session);
+
+        if(size > data_size) {
+            fs_operation_success = rpc_system_storage_read_pipelined(
+                session, response, request->command_id, file, size, data_size);
+        } else {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Warray-bounds"
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
+            pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+            data->size = size ? storage_file_read(file, data->bytes, size) : 0;
 #pragma GCC diagnostic pop
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
-            }
-
+            fs_operation_success = (data->size == size);
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_system_storage_read_send(session, response, request->command_id, data, false);
             }
-        } while((size_left != 0) && fs_operation_success);
+            free(data);
+        }
     }
 
     if(!fs_operation_success) {
@@ -410,6 +604,29 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     storage_file_free(file);
 }
 
+/* Collect small chunks to write SD card in bigger blocks */
+static bool rpc_system_storage_write_buffered(
+    RpcStorageSystem* rpc_storage,
+    const uint8_t* data,
+    size_t size) {
+    bool success = true;
+
+    if(rpc_storage->write_buffer_used + size > WRITE_BUFFER_SIZE) {
+        success = rpc_system_storage_write_flush(rpc_storage);
+    }
+
+    if(success) {
+        if(size > WRITE_BUFFER_SIZE) {
+            success = (storage_file_write(rpc_storage->file, data, size) == size);
+        } else {
+            memcpy(&rpc_storage->write_buffer[rpc_storage->write_buffer_used], data, size);
+            rpc_storage->write_buffer_used += size;
+        }
+    }
+
+    return success;
+}
+
 static void rpc_system_storage_write_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -438,9 +655,12 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
 
     if(rpc_storage->state != RpcStorageStateWriting) {
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
+        rpc_storage->write_buffer = malloc(WRITE_BUFFER_SIZE);
+        rpc_storage->write_buffer_used = 0;
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
+        rpc_system_storage_md5_cache_invalidate(rpc_storage, path);
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
     }
@@ -454,8 +674,12 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            size_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            fs_operation_success = rpc_system_storage_write_buffered(
+                rpc_storage, buffer, buffer_size);
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
@@ -517,6 +741,9 @@ static void rpc_system_storage_delete_process(const PB_Main* request, void* cont
     PB_CommandStatus status = PB_CommandStatus_ERROR;
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
+    // Recursive delete may remove any number of cached files
+    rpc_system_storage_md5_cache_invalidate(rpc_storage, NULL);
+
     char* path = request->content.storage_delete_request.path;
     if(!path) {
         status = PB_CommandStatus_ERROR_INVALID_PARAMETERS;
@@ -591,28 +818,26 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
     }
 
     File* file = storage_file_alloc(rpc_storage->api);
-    FuriString* md5 = furi_string_alloc();
-    FS_Error file_error;
-
-    if(md5_string_calc_file(file, filename, md5, &file_error)) {
-        PB_Main response = {
-            .command_id = request->command_id,
-            .command_status = PB_CommandStatus_OK,
-            .which_content = PB_Main_storage_md5sum_response_tag,
-            .has_next = false,
-        };
-
-        char* md5sum = response.content.storage_md5sum_response.md5sum;
-        size_t md5sum_size = sizeof(response.content.storage_md5sum_response.md5sum);
-        snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
+    PB_Main response = {
+        .command_id = request->command_id,
+        .command_status = PB_CommandStatus_OK,
+        .which_content = PB_Main_storage_md5sum_response_tag,
+        .has_next = false,
+    };
+    char* md5sum = response.content.storage_md5sum_response.md5sum;
+    size_t md5sum_size = sizeof(response.content.storage_md5sum_response.md5sum);
 
+    FileInfo fileinfo;
+    FS_Error file_error = storage_common_stat(rpc_storage->api, filename, &fileinfo);
+    if(file_error == FSE_OK &&
+       rpc_system_storage_md5_calc(
+           rpc_storage, file, filename, fileinfo.size, md5sum, md5sum_size, &file_error)) {
         rpc_send_and_release(session, &response);
     } else {
         rpc_send_and_release_empty(
             session, request->command_id, rpc_system_storage_get_error(file_error));
     }
 
-    furi_string_free(md5);
     storage_file_free(file);
 }
 
@@ -630,6 +855,8 @@ static void rpc_system_storage_rename_process(const PB_Main* request, void* cont
     PB_CommandStatus status;
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
+    rpc_system_storage_md5_cache_invalidate(rpc_storage, NULL);
+
     if(path_contains_only_ascii(request->content.storage_rename_request.new_path)) {
         FS_Error error = storage_common_rename_safe(
             rpc_storage->api,
@@ -676,6 +903,8 @@ static void rpc_system_storage_backup_restore_process(const PB_Main* request, vo
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
+    rpc_system_storage_md5_cache_invalidate(rpc_storage, NULL);
+
     bool backup_ok = lfs_backup_unpack(
         rpc_storage->api, request->content.storage_backup_restore_request.archive_path);
 
@@ -697,6 +926,8 @@ static void rpc_system_storage_tar_extract_process(const PB_Main* request, void*
     PB_CommandStatus status;
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
+    rpc_system_storage_md5_cache_invalidate(rpc_storage, NULL);
+
     TarArchive* archive = tar_archive_alloc(rpc_storage->api);
 
     do {
@@ -790,6 +1021,9 @@ void rpc_system_storage_free(void* context) {
 
     rpc_system_storage_reset_state(rpc_storage, session, false);
 
+    rpc_system_storage_md5_cache_invalidate(rpc_storage, NULL);
+    free(rpc_storage->md5_cache);
+
     furi_record_close(RECORD_STORAGE);
     rpc_storage->api = NULL;
     free(rpc_storage);
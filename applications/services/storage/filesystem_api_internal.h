@@ -180,6 +180,12 @@ typedef struct {
  *      @param path2 second path to be compared
  *      @param truncate if set to true, compare only up to the path1's length
  *      @return true if path1 and path2 are considered equivalent
+ *
+ *  @var FS_Common_Api::timestamp
+ *      @brief Get file/directory modification time, optional
+ *      @param path path to file/directory
+ *      @param timestamp pointer to UNIX timestamp value
+ *      @return FS_Error error info
  */
 typedef struct {
     FS_Error (*const stat)(void* context, const char* path, FileInfo* fileinfo);
@@ -193,6 +199,7 @@ typedef struct {
     bool (*const equivalent_path)(const char* path1, const char* path2);
 
     FS_Error (*const rename)(void* context, const char* old, const char* new);
+    FS_Error (*const timestamp)(void* context, const char* path, uint32_t* timestamp);
 } FS_Common_Api;
 
 /** Full filesystem api structure */
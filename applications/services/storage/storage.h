@@ -279,7 +279,11 @@ bool storage_dir_exists(Storage* storage, const char* path);
 /******************* Common Functions *******************/
 
 /**
- * @brief Get the last access time in UNIX format.
+ * @brief Get the last modification time in UNIX format.
+ *
+ * On the SD card this is the modification time of the item itself, directories
+ * are updated whenever their contents change. Elsewhere, and for items without
+ * a timestamp, this is the time of the last change on the whole storage.
  *
  * @param storage pointer to a storage API instance.
  * @param path pointer to a zero-terminated string containing the path of the item in question.
@@ -446,6 +450,156 @@ bool storage_common_equivalent_path(
     const char* path2,
     bool truncate);
 
+/******************* Batched Functions *******************/
+
+/**
+ * @brief Buffer descriptor for scatter/gather file operations.
+ */
+typedef struct {
+    void* buff; /**< Pointer to the buffer. */
+    size_t size; /**< Size of the buffer, in bytes. */
+} StorageIoVec;
+
+/**
+ * @brief Read multiple directory items at once.
+ *
+ * Equivalent to calling storage_dir_read() up to count times, but takes
+ * a single round trip to the storage service.
+ *
+ * @param file pointer to a file instance representing the directory in question.
+ * @param fileinfos pointer to an array of count FileInfo structures (may be NULL).
+ * @param names pointer to a buffer of count * name_length bytes, item i name is stored at names + i * name_length (may be NULL).
+ * @param name_length maximum capacity of a single name, in bytes.
+ * @param count maximum number of items to read.
+ * @return number of items read, less than count if the end of the directory was reached or an error occurred.
+ */
+size_t storage_dir_read_batch(
+    File* file,
+    FileInfo* fileinfos,
+    char* names,
+    uint16_t name_length,
+    size_t count);
+
+/**
+ * @brief Get information about multiple files or directories at once.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param paths pointer to an array of count zero-terminated paths.
+ * @param fileinfos pointer to an array of count FileInfo structures (may be NULL).
+ * @param errors pointer to an array of count error codes, one per path (may be NULL).
+ * @param count number of paths.
+ * @return number of paths that were successfully stat'ed.
+ */
+size_t storage_common_stat_batch(
+    Storage* storage,
+    const char* const* paths,
+    FileInfo* fileinfos,
+    FS_Error* errors,
+    size_t count);
+
+/**
+ * @brief Read data from a file into several buffers.
+ *
+ * @param file pointer to the file instance to read from.
+ * @param iov pointer to an array of buffer descriptors, filled in order.
+ * @param iov_count number of buffer descriptors.
+ * @return total number of bytes read, less than requested on end of file or error.
+ */
+size_t storage_file_readv(File* file, const StorageIoVec* iov, size_t iov_count);
+
+/**
+ * @brief Write data from several buffers to a file.
+ *
+ * @param file pointer to the file instance to write to.
+ * @param iov pointer to an array of buffer descriptors, written in order.
+ * @param iov_count number of buffer descriptors.
+ * @return total number of bytes written, less than requested on error.
+ */
+size_t storage_file_writev(File* file, const StorageIoVec* iov, size_t iov_count);
+
+/******************* Asynchronous Requests *******************/
+
+/**
+ * @brief Asynchronous request types.
+ */
+typedef enum {
+    StorageRequestTypeDirRead, /**< Read directory items, see storage_dir_read_batch(). */
+    StorageRequestTypeStat, /**< Stat paths, see storage_common_stat_batch(). */
+    StorageRequestTypeFileRead, /**< Scatter read, see storage_file_readv(). */
+    StorageRequestTypeFileWrite, /**< Gather write, see storage_file_writev(). */
+} StorageRequestType;
+
+typedef struct StorageRequest StorageRequest;
+
+/**
+ * @brief Asynchronous request completion callback.
+ *
+ * Called from the storage service thread, must not call any storage API
+ * and must return quickly.
+ *
+ * @param request pointer to the completed request.
+ * @param context pointer to the user-defined context.
+ */
+typedef void (*StorageRequestCallback)(StorageRequest* request, void* context);
+
+/**
+ * @brief StorageRequestTypeDirRead parameters.
+ */
+typedef struct {
+    File* file;
+    FileInfo* fileinfos;
+    char* names;
+    uint16_t name_length;
+    size_t count;
+} StorageRequestDirRead;
+
+/**
+ * @brief StorageRequestTypeStat parameters.
+ */
+typedef struct {
+    const char* const* paths;
+    FileInfo* fileinfos;
+    FS_Error* errors;
+    size_t count;
+} StorageRequestStat;
+
+/**
+ * @brief StorageRequestTypeFileRead and StorageRequestTypeFileWrite parameters.
+ */
+typedef struct {
+    File* file;
+    const StorageIoVec* iov;
+    size_t iov_count;
+} StorageRequestIo;
+
+/**
+ * @brief Asynchronous request, must stay valid until its callback is called.
+ */
+struct StorageRequest {
+    StorageRequestType type; /**< Request type. */
+    union {
+        StorageRequestDirRead dir_read;
+        StorageRequestStat stat;
+        StorageRequestIo io;
+    };
+    size_t result; /**< Request result, same as the return value of the batched function. */
+    StorageRequestCallback callback; /**< Completion callback (may be NULL). */
+    void* context; /**< Completion callback context. */
+    FuriThreadId thread_id; /**< Submitter thread, set by storage_request_submit(). */
+};
+
+/**
+ * @brief Submit a request to the storage service without waiting for it.
+ *
+ * Requests are processed in submission order together with regular
+ * storage calls, so several requests can be queued while the caller
+ * works on the results of previous ones.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param request pointer to the request, must stay valid until its callback is called.
+ */
+void storage_request_submit(Storage* storage, StorageRequest* request);
+
 /******************* Error Functions *******************/
 
 /**
@@ -4,6 +4,7 @@
 #include <cli/cli.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/md5_calc.h>
+#include <lib/toolbox/delta_sync.h>
 #include <lib/toolbox/dir_walk.h>
 #include <lib/toolbox/tar/tar_archive.h>
 #include <storage/storage.h>
@@ -68,6 +69,39 @@ static void storage_cli_info(Cli* cli, FuriString* path, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_cache(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+
+    if(furi_string_cmp_str(path, STORAGE_EXT_PATH_PREFIX) != 0) {
+        storage_cli_print_usage();
+        return;
+    }
+
+    FuriHalSdCacheStats stats;
+    furi_hal_sd_cache_get_stats(&stats);
+
+    const uint32_t lookups = stats.hits + stats.misses;
+    printf(
+        "Hits: %lu\r\nMisses: %lu\r\nHit rate: %lu%%\r\nBypassed: %lu\r\n"
+        "Read ahead: %lu, used %lu\r\nEvictions: %lu\r\nWrites deferred: %lu, flushed %lu\r\n",
+        stats.hits,
+        stats.misses,
+        lookups ? (uint32_t)((uint64_t)stats.hits * 100 / lookups) : 0,
+        stats.bypass,
+        stats.read_ahead,
+        stats.read_ahead_hits,
+        stats.evictions,
+        stats.writes_deferred,
+        stats.writes_flushed);
+
+    FuriString* command = furi_string_alloc();
+    if(args_read_string_and_trim(args, command) && furi_string_cmp_str(command, "reset") == 0) {
+        furi_hal_sd_cache_reset_stats();
+        printf("Statistics reset\r\n");
+    }
+    furi_string_free(command);
+}
+
 static void storage_cli_format(Cli* cli, FuriString* path, FuriString* args) {
     UNUSED(args);
     if(furi_string_cmp_str(path, STORAGE_INT_PATH_PREFIX) == 0) {
@@ -507,6 +541,65 @@ static void storage_cli_md5(Cli* cli, FuriString* path, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_signature_callback(uint32_t checksum, const uint8_t* md5, void* context) {
+    UNUSED(context);
+    printf("%08lx ", checksum);
+    for(size_t i = 0; i < DELTA_SYNC_MD5_SIZE; i++) {
+        printf("%02x", md5[i]);
+    }
+    printf("\r\n");
+}
+
+static void storage_cli_signature(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+
+    uint32_t block_size;
+    int parsed_count = sscanf(furi_string_get_cstr(args), "%lu", &block_size);
+
+    if(parsed_count != 1 || !block_size || block_size > DELTA_SYNC_BLOCK_SIZE_MAX) {
+        storage_cli_print_usage();
+        return;
+    }
+
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(api);
+    FS_Error file_error;
+
+    if(!delta_sync_signature_file(
+           file,
+           furi_string_get_cstr(path),
+           block_size,
+           storage_cli_signature_callback,
+           NULL,
+           &file_error)) {
+        storage_cli_print_error(file_error);
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_cli_patch(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    FuriString* delta_path = furi_string_alloc();
+
+    if(!args_read_probably_quoted_string_and_trim(args, delta_path)) {
+        storage_cli_print_usage();
+    } else {
+        Storage* api = furi_record_open(RECORD_STORAGE);
+        FS_Error file_error;
+
+        if(!delta_sync_patch_file(
+               api, furi_string_get_cstr(path), furi_string_get_cstr(delta_path), &file_error)) {
+            storage_cli_print_error(file_error);
+        }
+
+        furi_record_close(RECORD_STORAGE);
+    }
+
+    furi_string_free(delta_path);
+}
+
 static bool tar_extract_file_callback(const char* name, bool is_directory, void* context) {
     UNUSED(context);
     printf("\t%s %s\r\n", is_directory ? "D" : "F", name);
@@ -577,6 +670,16 @@ static const StorageCliCommand storage_cli_commands[] = {
         "md5 hash of the file",
         &storage_cli_md5,
     },
+    {
+        "signature",
+        "rolling checksum and md5 of every block of the file, <args> must contain block size",
+        &storage_cli_signature,
+    },
+    {
+        "patch",
+        "apply delta made against block signature to the file, <args> must contain delta path",
+        &storage_cli_patch,
+    },
     {
         "stat",
         "info about file or dir",
@@ -587,6 +690,11 @@ static const StorageCliCommand storage_cli_commands[] = {
         "get FS info",
         &storage_cli_info,
     },
+    {
+        "cache",
+        "SD sector cache statistics, <args> can be reset",
+        &storage_cli_cache,
+    },
     {
         "tree",
         "list files and dirs, recursive",
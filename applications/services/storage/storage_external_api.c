@@ -950,6 +950,112 @@ bool storage_common_equivalent_path(
     return S_RETURN_BOOL;
 }
 
+/****************** BATCH ******************/
+
+static size_t storage_request_execute(Storage* storage, StorageRequest* request) {
+    S_API_PROLOGUE;
+
+    request->callback = NULL;
+    request->thread_id = furi_thread_get_current_id();
+
+    StorageMessage message = {
+        .lock = lock,
+        .command = StorageCommandRequest,
+        .request = request,
+    };
+
+    S_API_EPILOGUE;
+    return request->result;
+}
+
+size_t storage_dir_read_batch(
+    File* file,
+    FileInfo* fileinfos,
+    char* names,
+    uint16_t name_length,
+    size_t count) {
+    S_FILE_API_PROLOGUE;
+
+    StorageRequest request = {
+        .type = StorageRequestTypeDirRead,
+        .dir_read =
+            {
+                .file = file,
+                .fileinfos = fileinfos,
+                .names = names,
+                .name_length = name_length,
+                .count = count,
+            },
+    };
+
+    return storage_request_execute(storage, &request);
+}
+
+size_t storage_common_stat_batch(
+    Storage* storage,
+    const char* const* paths,
+    FileInfo* fileinfos,
+    FS_Error* errors,
+    size_t count) {
+    furi_check(storage);
+    furi_check(paths || !count);
+
+    StorageRequest request = {
+        .type = StorageRequestTypeStat,
+        .stat =
+            {
+                .paths = paths,
+                .fileinfos = fileinfos,
+                .errors = errors,
+                .count = count,
+            },
+    };
+
+    return storage_request_execute(storage, &request);
+}
+
+size_t storage_file_readv(File* file, const StorageIoVec* iov, size_t iov_count) {
+    S_FILE_API_PROLOGUE;
+    furi_check(iov || !iov_count);
+
+    StorageRequest request = {
+        .type = StorageRequestTypeFileRead,
+        .io = {.file = file, .iov = iov, .iov_count = iov_count},
+    };
+
+    return storage_request_execute(storage, &request);
+}
+
+size_t storage_file_writev(File* file, const StorageIoVec* iov, size_t iov_count) {
+    S_FILE_API_PROLOGUE;
+    furi_check(iov || !iov_count);
+
+    StorageRequest request = {
+        .type = StorageRequestTypeFileWrite,
+        .io = {.file = file, .iov = iov, .iov_count = iov_count},
+    };
+
+    return storage_request_execute(storage, &request);
+}
+
+void storage_request_submit(Storage* storage, StorageRequest* request) {
+    furi_check(storage);
+    furi_check(request);
+
+    request->result = 0;
+    request->thread_id = furi_thread_get_current_id();
+
+    StorageMessage message = {
+        .lock = NULL,
+        .command = StorageCommandRequest,
+        .request = request,
+    };
+
+    furi_check(
+        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) ==
+        FuriStatusOk);
+}
+
 /****************** ERROR ******************/
 
 const char* storage_error_get_desc(FS_Error error_id) {
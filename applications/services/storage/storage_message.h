@@ -178,6 +178,7 @@ typedef enum {
     StorageCommandVirtualMount,
     StorageCommandVirtualUnmount,
     StorageCommandVirtualQuit,
+    StorageCommandRequest,
 } StorageCommand;
 
 typedef struct {
@@ -185,6 +186,7 @@ typedef struct {
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    StorageRequest* request;
 } StorageMessage;
 
 #ifdef __cplusplus
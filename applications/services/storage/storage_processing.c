@@ -355,7 +355,12 @@ static FS_Error
     FS_Error ret = storage_get_data(app, path, &storage);
 
     if(ret == FSE_OK) {
-        *timestamp = storage_data_get_timestamp(storage);
+        // Fall back to the last change of the whole storage if the item has no own timestamp
+        const char* path_cstr = cstr_path_without_vfs_prefix(path);
+        if(!storage->fs_api->common.timestamp ||
+           storage->fs_api->common.timestamp(storage, path_cstr, timestamp) != FSE_OK) {
+            *timestamp = storage_data_get_timestamp(storage);
+        }
     }
 
     return ret;
@@ -617,6 +622,89 @@ void storage_process_alias(
     }
 }
 
+/******************* Batched requests processing *******************/
+
+static size_t storage_process_request_dir_read(Storage* app, StorageRequestDirRead* dir_read) {
+    size_t done = 0;
+
+    for(; done < dir_read->count; done++) {
+        FileInfo* fileinfo = dir_read->fileinfos ? &dir_read->fileinfos[done] : NULL;
+        char* name = dir_read->names ? &dir_read->names[done * dir_read->name_length] : NULL;
+        if(!storage_process_dir_read(app, dir_read->file, fileinfo, name, dir_read->name_length)) {
+            break;
+        }
+    }
+
+    return done;
+}
+
+static size_t storage_process_request_stat(
+    Storage* app,
+    StorageRequestStat* request,
+    FuriThreadId thread_id) {
+    size_t done = 0;
+    FuriString* path = furi_string_alloc();
+
+    for(size_t i = 0; i < request->count; i++) {
+        FileInfo* fileinfo = request->fileinfos ? &request->fileinfos[i] : NULL;
+        furi_string_set(path, request->paths[i]);
+        storage_process_alias(app, path, thread_id, false);
+        FS_Error error = storage_process_common_stat(app, path, fileinfo);
+        if(request->errors) request->errors[i] = error;
+        if(error == FSE_OK) done++;
+    }
+
+    furi_string_free(path);
+    return done;
+}
+
+static size_t storage_process_request_io(Storage* app, StorageRequestIo* io, bool is_write) {
+    size_t total = 0;
+
+    for(size_t i = 0; i < io->iov_count; i++) {
+        uint8_t* buff = io->iov[i].buff;
+        size_t left = io->iov[i].size;
+
+        while(left) {
+            const uint16_t chunk = MIN(left, UINT16_MAX);
+            uint16_t done = is_write ? storage_process_file_write(app, io->file, buff, chunk) :
+                                       storage_process_file_read(app, io->file, buff, chunk);
+            total += done;
+            if(io->file->error_id != FSE_OK || done != chunk) {
+                return total;
+            }
+            buff += chunk;
+            left -= chunk;
+        }
+    }
+
+    return total;
+}
+
+static void storage_process_request(Storage* app, StorageRequest* request) {
+    switch(request->type) {
+    case StorageRequestTypeDirRead:
+        request->result = storage_process_request_dir_read(app, &request->dir_read);
+        break;
+    case StorageRequestTypeStat:
+        request->result = storage_process_request_stat(app, &request->stat, request->thread_id);
+        break;
+    case StorageRequestTypeFileRead:
+        request->result = storage_process_request_io(app, &request->io, false);
+        break;
+    case StorageRequestTypeFileWrite:
+        request->result = storage_process_request_io(app, &request->io, true);
+        break;
+    default:
+        request->result = 0;
+        break;
+    }
+
+    if(request->callback) {
+        request->callback(request, request->context);
+    }
+}
+
 /****************** API calls processing ******************/
 
 void storage_process_message_internal(Storage* app, StorageMessage* message) {
@@ -808,13 +896,21 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     case StorageCommandVirtualQuit:
         message->return_data->error_value = storage_process_virtual_quit(&app->storage[ST_MNT]);
         break;
+
+    // Batched and asynchronous requests
+    case StorageCommandRequest:
+        storage_process_request(app, message->request);
+        break;
     }
 
     if(path != NULL) { //-V547
         furi_string_free(path);
     }
 
-    api_lock_unlock(message->lock);
+    // Asynchronous requests have no lock, completion is reported by the callback
+    if(message->lock) {
+        api_lock_unlock(message->lock);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
@@ -1,4 +1,5 @@
 #include "fatfs.h"
+#include "sector_cache.h"
 #include "../filesystem_api_internal.h"
 #include "storage_ext.h"
 #include <furi_hal.h>
@@ -6,7 +7,10 @@
 #include <furi_hal_sd.h>
 #include <toolbox/path.h>
 
-typedef FIL SDFile;
+typedef struct {
+    FIL fil;
+    bool modified; // Written, truncated, expanded or created since open
+} SDFile;
 typedef DIR SDDir;
 typedef FILINFO SDFileInfo;
 typedef FRESULT SDError;
@@ -25,6 +29,12 @@ static FS_Error storage_ext_parse_error(SDError error);
 
 /******************* Core Functions *******************/
 
+// FAT sectors are rewritten on every cluster allocation, so they are kept in cache until sync
+static void storage_ext_fat_range(FATFS* fs, uint32_t* start_sector, uint32_t* end_sector) {
+    *start_sector = fs->fatbase;
+    *end_sector = fs->fatbase + fs->fsize * fs->n_fats;
+}
+
 static bool sd_mount_card_internal(StorageData* storage, bool notify) {
     bool result = false;
     uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -64,6 +74,9 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
                 }
 
                 if(status == FR_OK) {
+                    uint32_t start_sector, end_sector;
+                    storage_ext_fat_range(sd_data->fs, &start_sector, &end_sector);
+                    furi_hal_sd_cache_set_write_back(start_sector, end_sector);
                     storage->status = StorageStatusOK;
                 } else if(status == FR_NO_FILESYSTEM) {
                     storage->status = StorageStatusNoFS;
@@ -102,6 +115,8 @@ FS_Error sd_unmount_card(StorageData* storage) {
     error = FR_DISK_ERR;
 
     // TODO FL-3522: do i need to close the files?
+    furi_hal_sd_sync();
+    furi_hal_sd_cache_set_write_back(0, 0);
     f_mount(0, sd_data->path, 0);
 
     return storage_ext_parse_error(error);
@@ -326,6 +341,30 @@ static char* storage_ext_drive_path(StorageData* storage, const char* path) {
     return path_drv;
 }
 
+#ifndef FURI_RAM_EXEC
+/* FatFs doesn't update directory timestamps when directory contents change.
+ * Do it here, so that the timestamp can be used to validate directory listing caches.
+ */
+static void storage_ext_touch_parent(StorageData* storage, const char* path) {
+    FuriString* parent = furi_string_alloc();
+    path_extract_dirname(path, parent);
+
+    // Root directory has no timestamp
+    if(!furi_string_empty(parent) && furi_string_cmp_str(parent, "/") != 0) {
+        DWORD fattime = get_fattime();
+        SDFileInfo _fileinfo = {
+            .fdate = fattime >> 16,
+            .ftime = fattime & 0xFFFF,
+        };
+        char* drive_path = storage_ext_drive_path(storage, furi_string_get_cstr(parent));
+        f_utime(drive_path, &_fileinfo);
+        free(drive_path);
+    }
+
+    furi_string_free(parent);
+}
+#endif
+
 /******************* File Functions *******************/
 
 static bool storage_ext_file_open(
@@ -349,19 +388,36 @@ static bool storage_ext_file_open(
     storage_set_storage_file_data(file, file_data, storage);
 
     char* drive_path = storage_ext_drive_path(storage, path);
-    file->internal_error_id = f_open(file_data, drive_path, _mode);
+    file->internal_error_id = f_open(&file_data->fil, drive_path, _mode);
     free(drive_path);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+
+    if(file->error_id == FSE_OK) {
+        // Empty file opened with a creating mode may just have been created
+        file_data->modified = (open_mode & (FSOM_CREATE_NEW | FSOM_CREATE_ALWAYS)) ||
+                              ((open_mode & (FSOM_OPEN_ALWAYS | FSOM_OPEN_APPEND)) &&
+                               f_size(&file_data->fil) == 0);
+    }
     return (file->error_id == FSE_OK);
 }
 
 static bool storage_ext_file_close(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    file->internal_error_id = f_close(file_data);
+#ifndef FURI_RAM_EXEC
+    bool modified = file_data->modified;
+#endif
+    file->internal_error_id = f_close(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     free(file_data);
     storage_set_storage_file_data(file, NULL, storage);
+#ifndef FURI_RAM_EXEC
+    if(modified) {
+        // Stored path has the VFS prefix
+        const char* path = storage_file_get_path(file, storage);
+        storage_ext_touch_parent(storage, path + strlen(STORAGE_EXT_PATH_PREFIX));
+    }
+#endif
     return (file->error_id == FSE_OK);
 }
 
@@ -370,7 +426,7 @@ static uint16_t
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
     uint16_t bytes_read = 0;
-    file->internal_error_id = f_read(file_data, buff, bytes_to_read, &bytes_read);
+    file->internal_error_id = f_read(&file_data->fil, buff, bytes_to_read, &bytes_read);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_read;
 }
@@ -387,8 +443,9 @@ static uint16_t
 #else
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    file->internal_error_id = f_write(file_data, buff, bytes_to_write, &bytes_written);
+    file->internal_error_id = f_write(&file_data->fil, buff, bytes_to_write, &bytes_written);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    if(bytes_written) file_data->modified = true;
 #endif
     return bytes_written;
 }
@@ -399,11 +456,11 @@ static bool
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     if(from_start) {
-        file->internal_error_id = f_lseek(file_data, offset);
+        file->internal_error_id = f_lseek(&file_data->fil, offset);
     } else {
-        uint64_t position = f_tell(file_data);
+        uint64_t position = f_tell(&file_data->fil);
         position += offset;
-        file->internal_error_id = f_lseek(file_data, position);
+        file->internal_error_id = f_lseek(&file_data->fil, position);
     }
 
     file->error_id = storage_ext_parse_error(file->internal_error_id);
@@ -415,7 +472,7 @@ static uint64_t storage_ext_file_tell(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     uint64_t position = 0;
-    position = f_tell(file_data);
+    position = f_tell(&file_data->fil);
     file->error_id = FSE_OK;
     return position;
 }
@@ -430,8 +487,9 @@ static bool storage_ext_file_expand(void* ctx, File* file, const uint64_t size)
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_expand(file_data, size, 1);
+    file->internal_error_id = f_expand(&file_data->fil, size, 1);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    if(file->error_id == FSE_OK) file_data->modified = true;
 #endif
     return (file->error_id == FSE_OK);
 }
@@ -445,8 +503,9 @@ static bool storage_ext_file_truncate(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_truncate(file_data);
+    file->internal_error_id = f_truncate(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    if(file->error_id == FSE_OK) file_data->modified = true;
 #endif
     return (file->error_id == FSE_OK);
 }
@@ -460,7 +519,7 @@ static bool storage_ext_file_sync(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_sync(file_data);
+    file->internal_error_id = f_sync(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
 #endif
     return (file->error_id == FSE_OK);
@@ -471,7 +530,7 @@ static uint64_t storage_ext_file_size(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     uint64_t size = 0;
-    size = f_size(file_data);
+    size = f_size(&file_data->fil);
     file->error_id = FSE_OK;
     return size;
 }
@@ -480,7 +539,7 @@ static bool storage_ext_file_eof(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    bool eof = f_eof(file_data);
+    bool eof = f_eof(&file_data->fil);
     file->internal_error_id = 0;
     file->error_id = FSE_OK;
     return eof;
@@ -568,6 +627,33 @@ static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* f
     return storage_ext_parse_error(result);
 }
 
+static FS_Error storage_ext_common_timestamp(void* ctx, const char* path, uint32_t* timestamp) {
+    StorageData* storage = ctx;
+    SDFileInfo _fileinfo;
+    char* drive_path = storage_ext_drive_path(storage, path);
+    SDError result = f_stat(drive_path, &_fileinfo);
+    free(drive_path);
+
+    if(result == FR_OK) {
+        if(_fileinfo.fdate == 0) {
+            // Item was never timestamped
+            result = FR_NO_FILE;
+        } else {
+            DateTime datetime = {
+                .year = 1980 + (_fileinfo.fdate >> 9),
+                .month = (_fileinfo.fdate >> 5) & 0x0F,
+                .day = _fileinfo.fdate & 0x1F,
+                .hour = _fileinfo.ftime >> 11,
+                .minute = (_fileinfo.ftime >> 5) & 0x3F,
+                .second = (_fileinfo.ftime & 0x1F) * 2,
+            };
+            *timestamp = datetime_datetime_to_timestamp(&datetime);
+        }
+    }
+
+    return storage_ext_parse_error(result);
+}
+
 static FS_Error storage_ext_common_remove(void* ctx, const char* path) {
     StorageData* storage = ctx;
 #ifdef FURI_RAM_EXEC
@@ -578,6 +664,7 @@ static FS_Error storage_ext_common_remove(void* ctx, const char* path) {
     char* drive_path = storage_ext_drive_path(storage, path);
     SDError result = f_unlink(drive_path);
     free(drive_path);
+    if(result == FR_OK) storage_ext_touch_parent(storage, path);
     return storage_ext_parse_error(result);
 #endif
 }
@@ -595,6 +682,10 @@ static FS_Error storage_ext_common_rename(void* ctx, const char* old, const char
     SDError result = f_rename(drive_old, drive_new);
     free(drive_old);
     free(drive_new);
+    if(result == FR_OK) {
+        storage_ext_touch_parent(storage, old);
+        storage_ext_touch_parent(storage, new);
+    }
     return storage_ext_parse_error(result);
 #endif
 }
@@ -609,6 +700,7 @@ static FS_Error storage_ext_common_mkdir(void* ctx, const char* path) {
     char* drive_path = storage_ext_drive_path(storage, path);
     SDError result = f_mkdir(drive_path);
     free(drive_path);
+    if(result == FR_OK) storage_ext_touch_parent(storage, path);
     return storage_ext_parse_error(result);
 #endif
 }
@@ -695,6 +787,7 @@ static const FS_Api fs_api = {
             .rename = storage_ext_common_rename,
             .fs_info = storage_ext_common_fs_info,
             .equivalent_path = storage_ext_common_equivalent_path,
+            .timestamp = storage_ext_common_timestamp,
         },
 };
 
@@ -719,15 +812,50 @@ void storage_ext_init(StorageData* storage) {
 #include "fatfs/ff_gen_drv.h"
 
 #define SCSI_BLOCK_SIZE (0x200UL)
+#define MNT_CACHE_SECTORS (8)
+#define MNT_CACHE_READ_AHEAD (4)
 static File* mnt_image = NULL;
 static StorageData* mnt_image_storage = NULL;
+static SectorCache* mnt_cache = NULL;
 bool mnt_mounted = false;
 ;
 
+static bool
+    mnt_cache_read_callback(void* context, uint8_t* data, uint32_t sector, uint32_t count) {
+    UNUSED(context);
+    if(!storage_ext_file_seek(mnt_image_storage, mnt_image, sector * SCSI_BLOCK_SIZE, true)) {
+        return false;
+    }
+    size_t size = count * SCSI_BLOCK_SIZE;
+    size_t read = storage_ext_file_read(mnt_image_storage, mnt_image, data, size);
+    return read == size;
+}
+
+static bool mnt_cache_write_callback(
+    void* context,
+    const uint8_t* data,
+    uint32_t sector,
+    uint32_t count) {
+    UNUSED(context);
+    if(!storage_ext_file_seek(mnt_image_storage, mnt_image, sector * SCSI_BLOCK_SIZE, true)) {
+        return false;
+    }
+    size_t size = count * SCSI_BLOCK_SIZE;
+    size_t wrote = storage_ext_file_write(mnt_image_storage, mnt_image, data, size);
+    return wrote == size;
+}
+
 FS_Error storage_process_virtual_init(StorageData* image_storage, File* image) {
     if(mnt_image) return FSE_ALREADY_OPEN;
     mnt_image = image;
     mnt_image_storage = image_storage;
+
+    const SectorCacheConfig config = {
+        .sectors = MNT_CACHE_SECTORS,
+        .read_ahead = MNT_CACHE_READ_AHEAD,
+    };
+    mnt_cache =
+        sector_cache_alloc(&config, mnt_cache_read_callback, mnt_cache_write_callback, NULL);
     return FSE_OK;
 }
 
@@ -766,6 +894,9 @@ FS_Error storage_process_virtual_mount(StorageData* storage) {
     SDError error = f_mount(sd_data->fs, sd_data->path, 1);
     if(error == FR_NO_FILESYSTEM) return FSE_INVALID_PARAMETER;
     if(error != FR_OK) return FSE_INTERNAL;
+    uint32_t start_sector, end_sector;
+    storage_ext_fat_range(sd_data->fs, &start_sector, &end_sector);
+    sector_cache_set_write_back_range(mnt_cache, start_sector, end_sector);
     mnt_mounted = true;
     return FSE_OK;
 }
@@ -773,6 +904,8 @@ FS_Error storage_process_virtual_mount(StorageData* storage) {
 FS_Error storage_process_virtual_unmount(StorageData* storage) {
     if(!mnt_image) return FSE_NOT_READY;
     SDData* sd_data = storage->data;
+    sector_cache_sync(mnt_cache);
+    sector_cache_set_write_back_range(mnt_cache, 0, 0);
     SDError error = f_mount(0, sd_data->path, 0);
     if(error != FR_OK) return FSE_INTERNAL;
     mnt_mounted = false;
@@ -782,6 +915,8 @@ FS_Error storage_process_virtual_unmount(StorageData* storage) {
 FS_Error storage_process_virtual_quit(StorageData* storage) {
     if(!mnt_image) return FSE_NOT_READY;
     if(mnt_mounted) storage_process_virtual_unmount(storage);
+    sector_cache_free(mnt_cache);
+    mnt_cache = NULL;
     mnt_image = NULL;
     mnt_image_storage = NULL;
     return FSE_OK;
@@ -818,12 +953,8 @@ static DSTATUS mnt_driver_status(BYTE pdrv) {
   */
 static DRESULT mnt_driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
-    if(!storage_ext_file_seek(mnt_image_storage, mnt_image, sector * SCSI_BLOCK_SIZE, true)) {
-        return RES_ERROR;
-    }
-    size_t size = count * SCSI_BLOCK_SIZE;
-    size_t read = storage_ext_file_read(mnt_image_storage, mnt_image, buff, size);
-    return read == size ? RES_OK : RES_ERROR;
+    if(!mnt_cache) return RES_NOTRDY;
+    return sector_cache_read(mnt_cache, buff, sector, count) ? RES_OK : RES_ERROR;
 }
 
 /**
@@ -836,12 +967,8 @@ static DRESULT mnt_driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
   */
 static DRESULT mnt_driver_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
-    if(!storage_ext_file_seek(mnt_image_storage, mnt_image, sector * SCSI_BLOCK_SIZE, true)) {
-        return RES_ERROR;
-    }
-    size_t size = count * SCSI_BLOCK_SIZE;
-    size_t wrote = storage_ext_file_write(mnt_image_storage, mnt_image, buff, size);
-    return wrote == size ? RES_OK : RES_ERROR;
+    if(!mnt_cache) return RES_NOTRDY;
+    return sector_cache_write(mnt_cache, buff, sector, count) ? RES_OK : RES_ERROR;
 }
 
 /**
@@ -860,7 +987,7 @@ static DRESULT mnt_driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
     switch(cmd) {
     /* Make sure that no pending write process */
     case CTRL_SYNC:
-        res = RES_OK;
+        res = sector_cache_sync(mnt_cache) ? RES_OK : RES_ERROR;
         break;
 
     /* Get number of sectors on the disk (DWORD) */
@@ -160,6 +160,7 @@ static void js_cli_callback(JsThreadEvent event, const char* msg, void* context)
         js_cli_exit(ctx); // Exit when an error occurs
         break;
     case JsThreadEventPrint:
+    case JsThreadEventLoaded:
         js_cli_print(ctx, msg);
         js_cli_print(ctx, "\r\n");
         break;
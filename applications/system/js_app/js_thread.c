@@ -19,6 +19,10 @@ struct JsThread {
     JsThreadCallback app_callback;
     void* context;
     JsModules* modules;
+    bool loaded;
+    uint32_t load_start;
+    size_t load_free_heap;
+    size_t load_min_free_heap;
 };
 
 static void js_str_print(FuriString* msg_str, struct mjs* mjs) {
@@ -90,7 +94,33 @@ static void js_console_debug(struct mjs* mjs) {
     mjs_return(mjs, MJS_UNDEFINED);
 }
 
+static void js_report_load_stats(JsThread* worker) {
+    // Poller is first called right after the bytecode started executing
+    worker->loaded = true;
+    uint32_t load_time =
+        (furi_get_tick() - worker->load_start) * 1000 / furi_kernel_get_tick_frequency();
+    size_t free_heap = memmgr_get_free_heap();
+    size_t min_free_heap = memmgr_get_minimum_free_heap();
+    // Watermark is global, so it is only precise when the load has lowered it
+    size_t low_free_heap = min_free_heap < worker->load_min_free_heap ? min_free_heap : free_heap;
+    size_t peak_heap =
+        worker->load_free_heap > low_free_heap ? worker->load_free_heap - low_free_heap : 0;
+
+    FuriString* msg =
+        furi_string_alloc_printf("Loaded in %lu ms, heap peak %zu bytes", load_time, peak_heap);
+    FURI_LOG_I(TAG, "%s", furi_string_get_cstr(msg));
+    if(worker->app_callback) {
+        worker->app_callback(JsThreadEventLoaded, furi_string_get_cstr(msg), worker->context);
+    }
+    furi_string_free(msg);
+}
+
 static void js_exit_flag_poll(struct mjs* mjs) {
+    JsThread* worker = mjs_get_context(mjs);
+    if(!worker->loaded) {
+        js_report_load_stats(worker);
+    }
+
     uint32_t flags = furi_thread_flags_wait(ThreadEventStop, FuriFlagWaitAny, 0);
     if(flags & FuriFlagError) {
         return;
@@ -359,6 +389,12 @@ static int32_t js_thread(void* arg) {
 
     mjs_set_exec_flags_poller(mjs, js_exit_flag_poll);
 
+    // Reuse bytecode cached in /ext/.cache/js when the script is unchanged
+    mjs_set_generate_jsc(mjs, 1);
+
+    worker->load_start = furi_get_tick();
+    worker->load_free_heap = memmgr_get_free_heap();
+    worker->load_min_free_heap = memmgr_get_minimum_free_heap();
     mjs_err_t err = mjs_exec_file(mjs, furi_string_get_cstr(worker->path), NULL);
 
 #ifdef JS_DEBUG
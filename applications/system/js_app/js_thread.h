@@ -7,6 +7,7 @@ typedef enum {
     JsThreadEventError,
     JsThreadEventPrint,
     JsThreadEventErrorTrace,
+    JsThreadEventLoaded,
 } JsThreadEvent;
 
 typedef void (*JsThreadCallback)(JsThreadEvent event, const char* msg, void* context);
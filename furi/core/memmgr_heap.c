@@ -127,6 +127,9 @@ DICT_DEF2( //-V1048
 static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
 static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
 
+/* Number of successful allocations since start */
+static volatile size_t memmgr_heap_alloc_count = 0;
+
 /* Initialize tracing storage on start */
 void memmgr_heap_init(void) {
     MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
@@ -219,6 +222,10 @@ static inline void traceFREE(void* pointer, size_t size) {
     }
 }
 
+size_t memmgr_heap_get_alloc_count(void) {
+    return memmgr_heap_alloc_count;
+}
+
 size_t memmgr_heap_get_max_free_block(void) {
     size_t max_free_size = 0;
     BlockLink_t* pxBlock;
@@ -460,6 +467,10 @@ void* pvPortMalloc(size_t xWantedSize) {
             mtCOVERAGE_TEST_MARKER();
         }
 
+        if(pvReturn != NULL) {
+            memmgr_heap_alloc_count++;
+        }
+
         traceMALLOC(pvReturn, xWantedSize);
     }
     (void)xTaskResumeAll();
@@ -34,6 +34,12 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id);
 
+/** Memmgr heap get number of allocations made since start
+ *
+ * @return     size_t allocation count
+ */
+size_t memmgr_heap_get_alloc_count(void);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
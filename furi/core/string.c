@@ -1,10 +1,24 @@
 #include "string.h"
+#include "string_i.h"
+#include "thread_i.h"
+#include "check.h"
+#include "common_defines.h"
 #include <m-string.h>
 
+#define FURI_STRING_SCRATCH_GROW (4)
+// Bigger buffers are returned to heap on release
+#define FURI_STRING_SCRATCH_CAPACITY_MAX (256)
+
 struct FuriString {
     string_t string;
 };
 
+struct FuriStringScratch {
+    FuriString** strings;
+    size_t count;
+    size_t used;
+};
+
 #undef furi_string_alloc_set
 #undef furi_string_set
 #undef furi_string_cmp
@@ -66,6 +80,93 @@ void furi_string_free(FuriString* s) {
     free(s);
 }
 
+static FuriStringScratch* furi_string_scratch_get(void) {
+    // Thread local storage is not available in ISR and before scheduler start
+    if(FURI_IS_IRQ_MODE() || xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return NULL;
+    }
+
+    FuriThread* thread = furi_thread_get_current();
+    if(!thread) return NULL;
+
+    if(!thread->string_scratch) {
+        thread->string_scratch = malloc(sizeof(FuriStringScratch));
+    }
+    return thread->string_scratch;
+}
+
+static void furi_string_scratch_release(FuriStringScratch* scratch) {
+    furi_check(scratch->used);
+
+    FuriString* string = scratch->strings[--scratch->used];
+    if(string_capacity(string->string) > FURI_STRING_SCRATCH_CAPACITY_MAX) {
+        string_clear(string->string);
+        string_init(string->string);
+    } else {
+        string_reset(string->string);
+    }
+}
+
+FuriString* furi_string_scratch_alloc(void) {
+    FuriStringScratch* scratch = furi_string_scratch_get();
+    if(!scratch) return furi_string_alloc();
+
+    if(scratch->used == scratch->count) {
+        scratch->count += FURI_STRING_SCRATCH_GROW;
+        scratch->strings = realloc(scratch->strings, scratch->count * sizeof(FuriString*)); //-V701
+        for(size_t i = scratch->used; i < scratch->count; i++) {
+            scratch->strings[i] = furi_string_alloc();
+        }
+    }
+
+    return scratch->strings[scratch->used++];
+}
+
+void furi_string_scratch_free(FuriString* s) {
+    furi_check(s);
+
+    FuriStringScratch* scratch = furi_string_scratch_get();
+    if(scratch) {
+        for(size_t i = 0; i < scratch->used; i++) {
+            if(scratch->strings[i] != s) continue;
+
+            furi_check(i == scratch->used - 1, "Scratch strings released out of order");
+            furi_string_scratch_release(scratch);
+            return;
+        }
+    }
+
+    furi_string_free(s);
+}
+
+size_t furi_string_scratch_mark(void) {
+    FuriStringScratch* scratch = furi_string_scratch_get();
+    furi_check(scratch);
+
+    return scratch->used;
+}
+
+void furi_string_scratch_reset(size_t mark) {
+    FuriStringScratch* scratch = furi_string_scratch_get();
+    furi_check(scratch);
+    furi_check(mark <= scratch->used);
+
+    while(scratch->used > mark) {
+        furi_string_scratch_release(scratch);
+    }
+}
+
+void furi_string_scratch_pool_free(FuriStringScratch* scratch) {
+    if(!scratch) return;
+
+    furi_check(scratch->used == 0, "Scratch strings not released");
+    for(size_t i = 0; i < scratch->count; i++) {
+        furi_string_free(scratch->strings[i]);
+    }
+    free(scratch->strings);
+    free(scratch);
+}
+
 void furi_string_reserve(FuriString* s, size_t alloc) {
     string_reserve(s->string, alloc);
 }
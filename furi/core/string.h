@@ -87,6 +87,41 @@ FuriString* furi_string_alloc_move(FuriString* source);
  */
 void furi_string_free(FuriString* string);
 
+//---------------------------------------------------------------------------
+//                             Scratch strings
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Get temporary FuriString from the current thread scratch pool.
+ * Scratch string is empty, but keeps its buffer between uses, so hot paths
+ * can use temporaries without touching heap.
+ * Must be released with furi_string_scratch_free or furi_string_scratch_reset
+ * in the reverse order, never with furi_string_free.
+ * Outside of FuriThread context this is the same as furi_string_alloc.
+ * @return FuriString*
+ */
+FuriString* furi_string_scratch_alloc(void);
+
+/**
+ * @brief Release string taken with furi_string_scratch_alloc.
+ * @param string
+ */
+void furi_string_scratch_free(FuriString* string);
+
+/**
+ * @brief Get current position of the thread scratch pool.
+ * Only available in FuriThread context.
+ * @return size_t mark for furi_string_scratch_reset
+ */
+size_t furi_string_scratch_mark(void);
+
+/**
+ * @brief Release all scratch strings taken after the mark.
+ * Only available in FuriThread context.
+ * @param mark value returned by furi_string_scratch_mark
+ */
+void furi_string_scratch_reset(size_t mark);
+
 //---------------------------------------------------------------------------
 //                         String memory management
 //---------------------------------------------------------------------------
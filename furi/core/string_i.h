@@ -0,0 +1,11 @@
+#pragma once
+
+#include "string.h"
+
+typedef struct FuriStringScratch FuriStringScratch;
+
+/** Free thread scratch pool, all strings must be released
+ *
+ * @param      scratch  FuriStringScratch instance, can be NULL
+ */
+void furi_string_scratch_pool_free(FuriStringScratch* scratch);
@@ -64,6 +64,9 @@ static void furi_thread_body(void* context) {
 
     furi_check(!thread->is_service, "Service threads MUST NOT return");
 
+    furi_string_scratch_pool_free(thread->string_scratch);
+    thread->string_scratch = NULL;
+
     if(thread->heap_trace_enabled == true) {
         furi_delay_ms(33);
         thread->heap_size = memmgr_heap_get_thread_memory(thread);
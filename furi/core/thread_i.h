@@ -1,7 +1,7 @@
 #pragma once
 
 #include "thread.h"
-#include "string.h"
+#include "string_i.h"
 
 #include <FreeRTOS.h>
 #include <task.h>
@@ -37,6 +37,8 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    FuriStringScratch* string_scratch;
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
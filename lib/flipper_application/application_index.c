@@ -0,0 +1,202 @@
+#include "application_index.h"
+#include <furi.h>
+#include <furi_hal_rtc.h>
+
+#define TAG "FapIndex"
+
+#define FAP_INDEX_MAGIC 0x58444946 // "FIDX"
+#define FAP_INDEX_VERSION 2
+#define FAP_INDEX_SLOTS 512
+#define FAP_INDEX_PROBES 8
+// Extra slots after the table, so probing never wraps around
+#define FAP_INDEX_SLOTS_TOTAL (FAP_INDEX_SLOTS + FAP_INDEX_PROBES - 1)
+#define FAP_INDEX_CREATE_CHUNK 16
+// Files modified this recently may change again without a new FAT timestamp
+#define FAP_INDEX_TIMESTAMP_WINDOW 3
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t slot_count;
+} FURI_PACKED FlipperApplicationIndexHeader;
+
+typedef struct {
+    uint32_t path_hash; // 0 for empty slot
+    uint32_t path_check;
+    uint32_t timestamp;
+    uint32_t indexed_at; // RTC time of the update, oldest entry is evicted first
+    uint8_t valid;
+    FlipperApplicationManifest manifest;
+} FURI_PACKED FlipperApplicationIndexEntry;
+
+static void flipper_application_index_hash(const char* path, uint32_t* hash, uint32_t* check) {
+    uint32_t h = 0x1505; // gnu hash
+    uint32_t c = 0x811C9DC5; // fnv-1a
+    for(; *path; path++) {
+        h = (h << 5) + h + (uint8_t)*path;
+        c = (c ^ (uint8_t)*path) * 0x01000193;
+    }
+    *hash = h ? h : 1;
+    *check = c;
+}
+
+static size_t flipper_application_index_slot_offset(size_t slot) {
+    return sizeof(FlipperApplicationIndexHeader) + slot * sizeof(FlipperApplicationIndexEntry);
+}
+
+static bool flipper_application_index_open(File* file, FS_AccessMode access_mode) {
+    FlipperApplicationIndexHeader header;
+    if(storage_file_open(file, FAP_INDEX_PATH, access_mode, FSOM_OPEN_EXISTING) &&
+       storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+       header.magic == FAP_INDEX_MAGIC && header.version == FAP_INDEX_VERSION &&
+       header.entry_size == sizeof(FlipperApplicationIndexEntry) &&
+       header.slot_count == FAP_INDEX_SLOTS_TOTAL) {
+        return true;
+    }
+    storage_file_close(file);
+    return false;
+}
+
+static bool flipper_application_index_create(Storage* storage, File* file) {
+    storage_simply_mkdir(storage, EXT_PATH(".cache"));
+    if(!storage_file_open(file, FAP_INDEX_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        storage_file_close(file);
+        return false;
+    }
+
+    const FlipperApplicationIndexHeader header = {
+        .magic = FAP_INDEX_MAGIC,
+        .version = FAP_INDEX_VERSION,
+        .entry_size = sizeof(FlipperApplicationIndexEntry),
+        .slot_count = FAP_INDEX_SLOTS_TOTAL,
+    };
+    bool result = storage_file_write(file, &header, sizeof(header)) == sizeof(header);
+
+    size_t chunk_size = sizeof(FlipperApplicationIndexEntry) * FAP_INDEX_CREATE_CHUNK;
+    uint8_t* empty = malloc(chunk_size);
+    for(size_t slot = 0; result && slot < FAP_INDEX_SLOTS_TOTAL; slot += FAP_INDEX_CREATE_CHUNK) {
+        size_t size = sizeof(FlipperApplicationIndexEntry) *
+                      MIN((size_t)FAP_INDEX_CREATE_CHUNK, FAP_INDEX_SLOTS_TOTAL - slot);
+        result = storage_file_write(file, empty, size) == size;
+    }
+    free(empty);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Failed to create index");
+        storage_file_close(file);
+        storage_simply_remove(storage, FAP_INDEX_PATH);
+    }
+    return result;
+}
+
+static bool flipper_application_index_read_probes(
+    File* file,
+    uint32_t hash,
+    FlipperApplicationIndexEntry* entries) {
+    size_t size = sizeof(FlipperApplicationIndexEntry) * FAP_INDEX_PROBES;
+    return storage_file_seek(
+               file, flipper_application_index_slot_offset(hash % FAP_INDEX_SLOTS), true) &&
+           storage_file_read(file, entries, size) == size;
+}
+
+bool flipper_application_index_get(
+    Storage* storage,
+    const char* path,
+    uint32_t timestamp,
+    FlipperApplicationManifest* manifest,
+    bool* valid) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(manifest);
+    furi_check(valid);
+
+    uint32_t hash, check;
+    flipper_application_index_hash(path, &hash, &check);
+    File* file = storage_file_alloc(storage);
+    FlipperApplicationIndexEntry* entries =
+        malloc(sizeof(FlipperApplicationIndexEntry) * FAP_INDEX_PROBES);
+    bool result = false;
+
+    if(flipper_application_index_open(file, FSAM_READ) &&
+       flipper_application_index_read_probes(file, hash, entries)) {
+        for(size_t i = 0; i < FAP_INDEX_PROBES; i++) {
+            if(entries[i].path_hash == hash && entries[i].path_check == check &&
+               entries[i].timestamp == timestamp) {
+                memcpy(manifest, &entries[i].manifest, sizeof(FlipperApplicationManifest));
+                *valid = entries[i].valid;
+                result = true;
+                break;
+            }
+        }
+    }
+
+    free(entries);
+    storage_file_free(file);
+    return result;
+}
+
+void flipper_application_index_put(
+    Storage* storage,
+    const char* path,
+    uint32_t timestamp,
+    const FlipperApplicationManifest* manifest,
+    bool valid) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(manifest);
+
+    if(furi_hal_rtc_get_timestamp() - timestamp < FAP_INDEX_TIMESTAMP_WINDOW) {
+        return;
+    }
+
+    uint32_t hash, check;
+    flipper_application_index_hash(path, &hash, &check);
+    File* file = storage_file_alloc(storage);
+    FlipperApplicationIndexEntry* entries =
+        malloc(sizeof(FlipperApplicationIndexEntry) * FAP_INDEX_PROBES);
+
+    if((flipper_application_index_open(file, FSAM_READ_WRITE) ||
+        flipper_application_index_create(storage, file)) &&
+       flipper_application_index_read_probes(file, hash, entries)) {
+        // Same path, else first empty slot, else evict oldest probed entry
+        size_t probe = FAP_INDEX_PROBES;
+        size_t oldest = 0;
+        for(size_t i = 0; i < FAP_INDEX_PROBES; i++) {
+            if(entries[i].path_hash == hash && entries[i].path_check == check) {
+                probe = i;
+                break;
+            }
+            if(entries[i].path_hash == 0 && probe == FAP_INDEX_PROBES) {
+                probe = i;
+            }
+            if(entries[i].indexed_at < entries[oldest].indexed_at) {
+                oldest = i;
+            }
+        }
+        if(probe == FAP_INDEX_PROBES) {
+            probe = oldest;
+        }
+
+        FlipperApplicationIndexEntry* entry = &entries[probe];
+        memset(entry, 0, sizeof(FlipperApplicationIndexEntry));
+        entry->path_hash = hash;
+        entry->path_check = check;
+        entry->timestamp = timestamp;
+        entry->indexed_at = furi_hal_rtc_get_timestamp();
+        entry->valid = valid;
+        if(valid) {
+            memcpy(&entry->manifest, manifest, sizeof(FlipperApplicationManifest));
+        }
+
+        size_t slot = hash % FAP_INDEX_SLOTS + probe;
+        if(!storage_file_seek(file, flipper_application_index_slot_offset(slot), true) ||
+           storage_file_write(file, entry, sizeof(FlipperApplicationIndexEntry)) !=
+               sizeof(FlipperApplicationIndexEntry)) {
+            FURI_LOG_E(TAG, "Failed to update index");
+        }
+    }
+
+    free(entries);
+    storage_file_free(file);
+}
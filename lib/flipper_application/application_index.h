@@ -0,0 +1,55 @@
+/**
+ * @file application_index.h
+ * Flipper application manifest index
+ *
+ * Manifests of application files are kept in a hash table file on SD card,
+ * so menus listing many applications don't have to parse every ELF file.
+ * Entries are keyed by path and refreshed when file modification time changes.
+ */
+#pragma once
+
+#include "application_manifest.h"
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAP_INDEX_PATH EXT_PATH(".cache/fap_index")
+
+/**
+ * @brief Look up application manifest in the index
+ * @param storage Storage instance
+ * @param path Application file path
+ * @param timestamp Application file modification time
+ * @param manifest Indexed manifest
+ * @param valid Whether manifest could be loaded when application was indexed
+ * @return true if application is indexed with the same modification time
+ */
+bool flipper_application_index_get(
+    Storage* storage,
+    const char* path,
+    uint32_t timestamp,
+    FlipperApplicationManifest* manifest,
+    bool* valid);
+
+/**
+ * @brief Add or update application manifest in the index
+ * Files modified in the last few seconds are not indexed, a change within the same
+ * timestamp tick would go unnoticed
+ * @param storage Storage instance
+ * @param path Application file path
+ * @param timestamp Application file modification time
+ * @param manifest Manifest to store, ignored if not valid
+ * @param valid Whether manifest could be loaded
+ */
+void flipper_application_index_put(
+    Storage* storage,
+    const char* path,
+    uint32_t timestamp,
+    const FlipperApplicationManifest* manifest,
+    bool valid);
+
+#ifdef __cplusplus
+}
+#endif
@@ -13,6 +13,8 @@
 #define IS_FLAGS_SET(v, m) (((v) & (m)) == (m))
 #define RESOLVER_THREAD_YIELD_STEP 30
 #define FAST_RELOCATION_VERSION 1
+#define RELOCATION_READ_CHUNK 16
+#define SECTION_TABLE_MAX_SIZE 4096
 
 // #define ELF_DEBUG_LOG 1
 
@@ -59,11 +61,20 @@ static void address_cache_put(AddressCache_t cache, int symEntry, Elf32_Addr sym
 /********************************************** ELF ***********************************************/
 /**************************************************************************************************/
 
+static void elf_file_free_headers(ELFFile* elf) {
+    free(elf->section_headers);
+    elf->section_headers = NULL;
+    free(elf->section_names);
+    elf->section_names = NULL;
+    elf->section_names_size = 0;
+}
+
 static void elf_file_maybe_release_fd(ELFFile* elf) {
     if(elf->fd) {
         storage_file_free(elf->fd);
         elf->fd = NULL;
     }
+    elf_file_free_headers(elf);
 }
 
 static ELFSection* elf_file_get_section(ELFFile* elf, const char* name) {
@@ -119,6 +130,11 @@ static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString*
 }
 
 static bool elf_read_section_name(ELFFile* elf, off_t offset, FuriString* name) {
+    if(elf->section_names) {
+        if((size_t)offset >= elf->section_names_size) return false;
+        furi_string_cat(name, elf->section_names + offset);
+        return true;
+    }
     return elf_read_string_from_offset(elf, elf->section_table_strings + offset, name);
 }
 
@@ -127,6 +143,12 @@ static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
 }
 
 static bool elf_read_section_header(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
+    if(elf->section_headers) {
+        if(section_idx >= elf->sections_count) return false;
+        *section_header = elf->section_headers[section_idx];
+        return true;
+    }
+
     off_t offset = SECTION_OFFSET(elf, section_idx);
     return storage_file_seek(elf->fd, offset, true) &&
            storage_file_read(elf->fd, section_header, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
@@ -358,7 +380,7 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
 
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
-        Elf32_Rel rel;
+        Elf32_Rel rels[RELOCATION_READ_CHUNK];
         size_t relEntries = s->rel_count;
         size_t relCount;
         (void)storage_file_seek(elf->fd, s->rel_offset, true);
@@ -374,11 +396,17 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 furi_delay_tick(1);
             }
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
-                FURI_LOG_E(TAG, "  reloc read fail");
-                furi_string_free(symbol_name);
-                return false;
+            size_t chunk_idx = relCount % RELOCATION_READ_CHUNK;
+            if(chunk_idx == 0) {
+                size_t chunk_size =
+                    MIN(relEntries - relCount, (size_t)RELOCATION_READ_CHUNK) * sizeof(Elf32_Rel);
+                if(storage_file_read(elf->fd, rels, chunk_size) != chunk_size) {
+                    FURI_LOG_E(TAG, "  reloc read fail");
+                    furi_string_free(symbol_name);
+                    return false;
+                }
             }
+            Elf32_Rel rel = rels[chunk_idx];
 
             Elf32_Addr symAddr;
 
@@ -405,6 +433,7 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
 
                 symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
                 address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                elf->load_stats.symbols_read++;
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -416,6 +445,7 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 if(!elf_relocate_symbol(elf, relAddr, relType, symAddr)) {
                     relocate_result = false;
                 }
+                s->relocation_count++;
             } else {
                 FURI_LOG_E(TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
                 relocate_result = false;
@@ -476,6 +506,7 @@ static ELFLoadSectionResult
     }
 
     size_t safe_size = section_header->sh_size + 1024;
+    uint32_t start = furi_get_tick();
 
     furi_kernel_lock();
 
@@ -502,6 +533,7 @@ static ELFLoadSectionResult
         return ELFLoadSectionResultError;
     }
 
+    section->load_time = furi_get_tick() - start;
     FURI_LOG_D(TAG, "0x%p", section->data);
     return ELFLoadSectionResultSuccess;
 }
@@ -761,6 +793,7 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
                 Elf32_Addr relAddr = ((Elf32_Addr)s->data) + offset;
                 elf_relocate_symbol(elf, relAddr, type, address);
             }
+            s->relocation_count += offsets_count;
         }
     }
 
@@ -772,16 +805,19 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
 }
 
 static bool elf_relocate_section(ELFFile* elf, ELFSection* section) {
+    uint32_t start = furi_get_tick();
+    bool result = true;
     if(section->fast_rel) {
         FURI_LOG_D(TAG, "Fast relocating section");
-        return elf_relocate_fast(elf, section);
+        result = elf_relocate_fast(elf, section);
     } else if(section->rel_count) {
         FURI_LOG_D(TAG, "Relocating section");
-        return elf_relocate(elf, section);
+        result = elf_relocate(elf, section);
     } else {
         FURI_LOG_D(TAG, "No relocation index"); /* Not an error */
     }
-    return true;
+    section->relocation_time = furi_get_tick() - start;
+    return result;
 }
 
 static void elf_file_call_section_list(ELFSection* section, bool reverse_order) {
@@ -879,10 +915,34 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+
+    // Section table is scanned several times while loading, keep it in memory
+    elf_file_free_headers(elf);
+    size_t table_size = elf->sections_count * sizeof(Elf32_Shdr);
+    if(h.e_shentsize == sizeof(Elf32_Shdr) && table_size <= SECTION_TABLE_MAX_SIZE &&
+       sH.sh_size <= SECTION_TABLE_MAX_SIZE) {
+        Elf32_Shdr* headers = malloc(table_size);
+        char* names = malloc(sH.sh_size + 1);
+        if(storage_file_seek(elf->fd, elf->section_table, true) &&
+           storage_file_read(elf->fd, headers, table_size) == table_size &&
+           storage_file_seek(elf->fd, sH.sh_offset, true) &&
+           storage_file_read(elf->fd, names, sH.sh_size) == sH.sh_size) {
+            // Keep the last name terminated even if the table isn't
+            names[sH.sh_size] = '\0';
+            elf->section_headers = headers;
+            elf->section_names = names;
+            elf->section_names_size = sH.sh_size;
+        } else {
+            free(headers);
+            free(names);
+        }
+    }
+
     return true;
 }
 
 ElfLoadSectionTableResult elf_file_load_section_table(ELFFile* elf) {
+    uint32_t start = furi_get_tick();
     SectionType loaded_sections = 0;
     FuriString* name = furi_string_alloc();
     ElfLoadSectionTableResult result = ElfLoadSectionTableResultSuccess;
@@ -919,6 +979,7 @@ ElfLoadSectionTableResult elf_file_load_section_table(ELFFile* elf) {
     }
 
     furi_string_free(name);
+    elf->load_stats.section_table_time = furi_get_tick() - start;
 
     if(result != ElfLoadSectionTableResultSuccess) {
         return result;
@@ -977,6 +1038,8 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
 
     AddressCache_init(elf->relocation_cache);
 
+    uint32_t start = furi_get_tick();
+
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
         FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
@@ -986,6 +1049,8 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
         }
     }
 
+    elf->load_stats.relocation_time = furi_get_tick() - start;
+
     /* Fixing up entry point */
     if(status == ELFFileLoadStatusSuccess) {
         ELFSection* text_section = elf_file_get_section(elf, ".text");
@@ -1008,8 +1073,16 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
             ELFSectionDict_next(it)) {
             ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
             total_size += itref->value.size;
+            elf->load_stats.load_time += itref->value.load_time;
         }
         FURI_LOG_I(TAG, "Total size of loaded sections: %zu", total_size);
+        FURI_LOG_I(
+            TAG,
+            "Section table %lu ms, data %lu ms, relocation %lu ms, %lu symbols read",
+            elf->load_stats.section_table_time,
+            elf->load_stats.load_time,
+            elf->load_stats.relocation_time,
+            elf->load_stats.symbols_read);
     }
 
     elf_file_maybe_release_fd(elf);
@@ -1048,6 +1121,7 @@ void elf_file_init_debug_info(ELFFile* elf, ELFDebugInfo* debug_info) {
 
     // copy debug info
     memcpy(&debug_info->debug_link_info, &elf->debug_link_info, sizeof(ELFDebugLinkInfo));
+    debug_info->load_stats = elf->load_stats;
 
     // init mmap
     debug_info->mmap_entry_count = ELFSectionDict_size(elf->sections);
@@ -1063,6 +1137,10 @@ void elf_file_init_debug_info(ELFFile* elf, ELFDebugInfo* debug_info) {
             ELFMemoryMapEntry* entry = &debug_info->mmap_entries[mmap_entry_idx];
             entry->address = (uint32_t)data_ptr;
             entry->name = itref->key;
+            entry->size = itref->value.size;
+            entry->load_time = itref->value.load_time;
+            entry->relocation_time = itref->value.relocation_time;
+            entry->relocation_count = itref->value.relocation_count;
             mmap_entry_idx++;
         }
     }
@@ -1079,4 +1157,5 @@ void elf_file_clear_debug_info(ELFDebugInfo* debug_info) {
     }
 
     debug_info->mmap_entry_count = 0;
+    memset(&debug_info->load_stats, 0, sizeof(ELFLoadStats));
 }
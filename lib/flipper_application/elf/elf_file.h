@@ -16,6 +16,10 @@ typedef struct ELFFile ELFFile;
 typedef struct {
     const char* name;
     uint32_t address;
+    uint32_t size;
+    uint32_t load_time; /**< Section data read time, ms */
+    uint32_t relocation_time; /**< Section relocation time, ms */
+    uint32_t relocation_count;
 } ELFMemoryMapEntry;
 
 typedef struct {
@@ -23,11 +27,19 @@ typedef struct {
     uint8_t* debug_link;
 } ELFDebugLinkInfo;
 
+typedef struct {
+    uint32_t section_table_time; /**< Section table processing time, ms */
+    uint32_t load_time; /**< Total section data read time, ms */
+    uint32_t relocation_time; /**< Total relocation time, ms */
+    uint32_t symbols_read; /**< Symbols read from the file for relocation */
+} ELFLoadStats;
+
 typedef struct {
     uint32_t mmap_entry_count;
     ELFMemoryMapEntry* mmap_entries;
     ELFDebugLinkInfo debug_link_info;
     off_t entry;
+    ELFLoadStats load_stats;
 } ELFDebugInfo;
 
 typedef enum {
@@ -66,6 +78,7 @@ void elf_file_free(ELFFile* elf_file);
 
 /**
  * @brief Open ELF file
+ * Section header table and section names are kept in memory until sections are loaded
  * @param elf_file 
  * @param path 
  * @return bool 
@@ -24,6 +24,10 @@ struct ELFSection {
     ELFSection* fast_rel;
 
     uint16_t sec_idx;
+
+    uint32_t load_time;
+    uint32_t relocation_time;
+    uint32_t relocation_count;
 };
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
@@ -51,6 +55,12 @@ struct ELFFile {
     ELFSection* fini_array;
 
     bool init_array_called;
+
+    Elf32_Shdr* section_headers;
+    char* section_names;
+    size_t section_names_size;
+
+    ELFLoadStats load_stats;
 };
 
 #ifdef __cplusplus
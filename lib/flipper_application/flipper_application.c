@@ -2,6 +2,7 @@
 #include "elf/elf_file.h"
 #include <notification/notification_messages.h>
 #include "application_assets.h"
+#include "application_index.h"
 #include <loader/firmware_api/firmware_api.h>
 #include <storage/storage_processing.h>
 
@@ -345,40 +346,52 @@ bool flipper_application_load_name_and_icon(
     furi_check(icon_ptr);
     furi_check(item_name);
 
-    bool load_success = true;
-
-    StorageData* storage_data;
-    if(storage_get_data(storage, path, &storage_data) == FSE_OK &&
-       storage_path_already_open(path, storage_data)) {
-        load_success = false;
-    }
-
-    if(load_success) {
-        load_success = false;
-
-        FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
-
-        FlipperApplicationPreloadStatus preload_res =
-            flipper_application_preload_manifest(app, furi_string_get_cstr(path));
+    bool load_success = false;
+    FlipperApplicationManifest manifest;
 
-        if(preload_res == FlipperApplicationPreloadStatusSuccess ||
-           preload_res == FlipperApplicationPreloadStatusApiTooOld ||
-           preload_res == FlipperApplicationPreloadStatusApiTooNew) {
-            const FlipperApplicationManifest* manifest = flipper_application_get_manifest(app);
-            if(manifest->has_icon) {
-                memcpy(*icon_ptr, manifest->icon, FAP_MANIFEST_MAX_ICON_SIZE);
-            }
-            furi_string_set(item_name, manifest->name);
-            load_success = true;
+    // Menus list lots of apps, take manifest from the index unless file has changed
+    uint32_t timestamp = 0;
+    if(storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp) != FSE_OK ||
+       !flipper_application_index_get(
+           storage, furi_string_get_cstr(path), timestamp, &manifest, &load_success)) {
+        StorageData* storage_data;
+        if(storage_get_data(storage, path, &storage_data) == FSE_OK &&
+           storage_path_already_open(path, storage_data)) {
+            timestamp = 0;
         } else {
-            FURI_LOG_E(TAG, "Failed to preload %s", furi_string_get_cstr(path));
-            load_success = false;
+            FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
+
+            FlipperApplicationPreloadStatus preload_res =
+                flipper_application_preload_manifest(app, furi_string_get_cstr(path));
+
+            if(preload_res == FlipperApplicationPreloadStatusSuccess ||
+               preload_res == FlipperApplicationPreloadStatusApiTooOld ||
+               preload_res == FlipperApplicationPreloadStatusApiTooNew) {
+                memcpy(&manifest, flipper_application_get_manifest(app), sizeof(manifest));
+                load_success = true;
+            } else {
+                FURI_LOG_E(TAG, "Failed to preload %s", furi_string_get_cstr(path));
+                // Remember files that are not apps, but not errors that may go away
+                if(preload_res == FlipperApplicationPreloadStatusNotEnoughMemory) {
+                    timestamp = 0;
+                }
+            }
+
+            flipper_application_free(app);
         }
 
-        flipper_application_free(app);
+        if(timestamp) {
+            flipper_application_index_put(
+                storage, furi_string_get_cstr(path), timestamp, &manifest, load_success);
+        }
     }
 
-    if(!load_success) {
+    if(load_success) {
+        if(manifest.has_icon) {
+            memcpy(*icon_ptr, manifest.icon, FAP_MANIFEST_MAX_ICON_SIZE);
+        }
+        furi_string_set(item_name, manifest.name);
+    } else {
         size_t offset = furi_string_search_rchar(path, '/');
         if(offset != FURI_STRING_FAILURE) {
             furi_string_set_n(item_name, path, offset + 1, furi_string_size(path) - offset - 1);
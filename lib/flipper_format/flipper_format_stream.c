@@ -1,5 +1,6 @@
 #include <inttypes.h>
 #include <toolbox/hex.h>
+#include <toolbox/stream/string_stream.h>
 #include <core/check.h>
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
@@ -101,7 +102,7 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
     bool found = false;
     FuriString* read_key;
 
-    read_key = furi_string_alloc();
+    read_key = furi_string_scratch_alloc();
 
     while(!stream_eof(stream)) {
         if(flipper_format_stream_read_valid_key(stream, read_key)) {
@@ -116,7 +117,7 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
             }
         }
     }
-    furi_string_free(read_key);
+    furi_string_scratch_free(read_key);
 
     return found;
 }
@@ -268,7 +269,7 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
         result = true;
     } else {
         FuriString* value;
-        value = furi_string_alloc();
+        value = furi_string_scratch_alloc();
 
         do {
             if(!flipper_format_stream_write_key(stream, write_data->key)) break;
@@ -329,7 +330,7 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
             result = true;
         } while(false);
 
-        furi_string_free(value);
+        furi_string_scratch_free(value);
     }
 
     return result;
@@ -356,7 +357,7 @@ bool flipper_format_stream_read_value_line(
         } else {
             result = true;
             FuriString* value;
-            value = furi_string_alloc();
+            value = furi_string_scratch_alloc();
 
             for(size_t i = 0; i < data_size; i++) {
                 bool last = false;
@@ -429,7 +430,7 @@ bool flipper_format_stream_read_value_line(
                 }
             }
 
-            furi_string_free(value);
+            furi_string_scratch_free(value);
         }
     } while(false);
 
@@ -445,7 +446,7 @@ bool flipper_format_stream_get_value_count(
     bool last = false;
 
     FuriString* value;
-    value = furi_string_alloc();
+    value = furi_string_scratch_alloc();
 
     uint32_t position = stream_tell(stream);
     do {
@@ -469,15 +470,45 @@ bool flipper_format_stream_get_value_count(
         result = false;
     }
 
-    furi_string_free(value);
+    furi_string_scratch_free(value);
     return result;
 }
 
+static bool flipper_format_stream_copy_line(Stream* stream, Stream* line) {
+    size_t line_size = stream_size(line);
+    if(!stream_rewind(line)) return false;
+    return stream_copy(line, stream, line_size) == line_size;
+}
+
+// Overwrite the line at the current position, values other than strings can be padded with spaces
+static bool flipper_format_stream_overwrite_line(
+    Stream* stream,
+    Stream* line,
+    FlipperStreamValue type,
+    size_t old_line_size) {
+    size_t line_size = stream_size(line);
+
+    if(line_size == 0 || line_size > old_line_size) return false;
+    if(line_size < old_line_size) {
+        if(type == FlipperStreamValueStr) return false;
+
+        // new line ends with EOL, put padding before it
+        if(!stream_seek(line, -1, StreamOffsetFromEnd)) return false;
+        for(size_t i = line_size; i < old_line_size; i++) {
+            if(!flipper_format_stream_write(line, " ", 1)) return false;
+        }
+        if(!flipper_format_stream_write_eol(line)) return false;
+    }
+
+    return flipper_format_stream_copy_line(stream, line);
+}
+
 bool flipper_format_stream_delete_key_and_write(
     Stream* stream,
     FlipperStreamWriteData* write_data,
     bool strict_mode) {
     bool result = false;
+    Stream* line = string_stream_alloc();
 
     do {
         size_t size = stream_size(stream);
@@ -505,17 +536,29 @@ bool flipper_format_stream_delete_key_and_write(
             end_position += 1;
         }
 
+        if(!flipper_format_stream_write_value_line(line, write_data)) break;
+
+        // Lines that fit are updated in place, others require rewriting the rest of the file
+        if(!stream_seek(stream, start_position, StreamOffsetFromStart)) break;
+        if(flipper_format_stream_overwrite_line(
+               stream, line, write_data->type, end_position - start_position)) {
+            result = true;
+            break;
+        }
+
         if(!stream_seek(stream, start_position, StreamOffsetFromStart)) break;
         if(!stream_delete_and_insert(
                stream,
                end_position - start_position,
-               (StreamWriteCB)flipper_format_stream_write_value_line,
-               write_data))
+               (StreamWriteCB)flipper_format_stream_copy_line,
+               line))
             break;
 
         result = true;
     } while(false);
 
+    stream_free(line);
+
     return result;
 }
 
@@ -70,6 +70,8 @@ bool flipper_format_stream_get_value_count(
 
 /**
  * Removes a key and the corresponding value string from the stream and inserts a new key/value pair.
+ * If the new line fits in the old one it is overwritten in place, non-string values are padded
+ * with spaces. Otherwise the rest of the stream is rewritten.
  * @param stream 
  * @param write_data 
  * @param strict_mode 
@@ -19,9 +19,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef CS_MMAP
+#include <dirent.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #endif
@@ -50,6 +53,68 @@ char* cs_read_file(const char* path, size_t* size) {
     return data;
 }
 
+int cs_stat_file(const char* path, size_t* size, uint32_t* mtime) WEAK;
+int cs_stat_file(const char* path, size_t* size, uint32_t* mtime) {
+    struct stat st;
+    if(stat(path, &st) != 0) return -1;
+    *size = (size_t)st.st_size;
+    *mtime = (uint32_t)st.st_mtime;
+    return 0;
+}
+
+int cs_write_file(
+    const char* path,
+    const void* header,
+    size_t header_size,
+    const void* data,
+    size_t size) WEAK;
+int cs_write_file(
+    const char* path,
+    const void* header,
+    size_t header_size,
+    const void* data,
+    size_t size) {
+    int res = -1;
+    FILE* fp;
+    char* dir = strdup(path);
+    char* slash;
+    for(slash = strchr(dir + 1, '/'); slash != NULL; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+        *slash = '/';
+    }
+    free(dir);
+    fp = fopen(path, "wb");
+    if(fp == NULL) return -1;
+    if(fwrite(header, 1, header_size, fp) == header_size &&
+       fwrite(data, 1, size, fp) == size) {
+        res = 0;
+    }
+    if(fclose(fp) != 0) res = -1;
+    return res;
+}
+
+void cs_prune_dir(const char* path, size_t max_files) WEAK;
+void cs_prune_dir(const char* path, size_t max_files) {
+    char file[PATH_MAX], oldest[PATH_MAX] = "";
+    time_t oldest_mtime = 0;
+    size_t count = 0;
+    struct dirent* entry;
+    struct stat st;
+    DIR* dir = opendir(path);
+    if(dir == NULL) return;
+    while((entry = readdir(dir)) != NULL) {
+        snprintf(file, sizeof(file), "%s/%s", path, entry->d_name);
+        if(stat(file, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        if(count++ == 0 || st.st_mtime < oldest_mtime) {
+            oldest_mtime = st.st_mtime;
+            strcpy(oldest, file);
+        }
+    }
+    closedir(dir);
+    if(count >= max_files) remove(oldest);
+}
+
 char* cs_mmap_file(const char* path, size_t* size) WEAK;
 char* cs_mmap_file(const char* path, size_t* size) {
     char* r;
@@ -33,6 +33,26 @@ extern "C" {
  */
 char *cs_read_file(const char *path, size_t *size);
 
+/*
+ * Get size and modification time of file `path`.
+ * Return: 0 on success, -1 on error.
+ */
+int cs_stat_file(const char *path, size_t *size, uint32_t *mtime);
+
+/*
+ * Create or truncate file `path` and write `header` followed by `data` to it.
+ * Missing parent directories are created. Either buffer may be empty.
+ * Return: 0 on success, -1 on error.
+ */
+int cs_write_file(const char *path, const void *header, size_t header_size,
+                  const void *data, size_t size);
+
+/*
+ * Remove the least recently modified file from directory `path` if it holds
+ * `max_files` or more files. Called before adding a file to a cache directory.
+ */
+void cs_prune_dir(const char *path, size_t max_files);
+
 #ifdef CS_MMAP
 /*
  * Only on platforms which support mmapping: mmap file `path` to the returned
@@ -1,8 +1,13 @@
 #include <furi.h>
+#include <furi_hal_rtc.h>
 #include <toolbox/stream/file_stream.h>
 #include "../cs_dbg.h"
+#include "../cs_file.h"
+#include "../cs_time.h"
 #include "../frozen/frozen.h"
 
+#define CS_DIR_NAME_SIZE 256
+
 char* cs_read_file(const char* path, size_t* size) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     Stream* stream = file_stream_alloc(storage);
@@ -29,6 +34,82 @@ char* cs_read_file(const char* path, size_t* size) {
     return data;
 }
 
+int cs_stat_file(const char* path, size_t* size, uint32_t* mtime) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FileInfo info;
+    int res = -1;
+    if(storage_common_stat(storage, path, &info) == FSE_OK &&
+       storage_common_timestamp(storage, path, mtime) == FSE_OK) {
+        *size = info.size;
+        res = 0;
+    }
+    furi_record_close(RECORD_STORAGE);
+    return res;
+}
+
+int cs_write_file(
+    const char* path,
+    const void* header,
+    size_t header_size,
+    const void* data,
+    size_t size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* dir = furi_string_alloc();
+    for(const char* slash = strchr(path + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        furi_string_set_strn(dir, path, slash - path);
+        storage_simply_mkdir(storage, furi_string_get_cstr(dir));
+    }
+    furi_string_free(dir);
+
+    File* file = storage_file_alloc(storage);
+    int res = -1;
+    if(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+       storage_file_write(file, header, header_size) == header_size &&
+       storage_file_write(file, data, size) == size) {
+        res = 0;
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    if(res != 0) storage_common_remove(storage, path);
+    furi_record_close(RECORD_STORAGE);
+    return res;
+}
+
+void cs_prune_dir(const char* path, size_t max_files) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    FuriString* file = furi_string_alloc();
+    FuriString* oldest = furi_string_alloc();
+    uint32_t oldest_mtime = 0;
+    size_t count = 0;
+    FileInfo info;
+    char name[CS_DIR_NAME_SIZE];
+
+    if(storage_dir_open(dir, path)) {
+        while(storage_dir_read(dir, &info, name, sizeof(name))) {
+            if(file_info_is_dir(&info)) continue;
+            uint32_t mtime = 0;
+            furi_string_printf(file, "%s/%s", path, name);
+            storage_common_timestamp(storage, furi_string_get_cstr(file), &mtime);
+            if(count++ == 0 || mtime < oldest_mtime) {
+                oldest_mtime = mtime;
+                furi_string_set(oldest, file);
+            }
+        }
+    }
+    storage_dir_close(dir);
+    if(count >= max_files) storage_common_remove(storage, furi_string_get_cstr(oldest));
+
+    furi_string_free(oldest);
+    furi_string_free(file);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+}
+
+double cs_time(void) {
+    return furi_hal_rtc_get_timestamp();
+}
+
 char* json_fread(const char* path) {
     UNUSED(path);
     return NULL;
@@ -3,6 +3,8 @@
  * All rights reserved
  */
 
+#include "common/cs_file.h"
+#include "common/cs_time.h"
 #include "common/cs_varint.h"
 
 #include "mjs_internal.h"
@@ -10,6 +12,23 @@
 #include "mjs_core.h"
 #include "mjs_tok.h"
 
+#define MJS_JSC_MAGIC 0x43534a4d /* "MJSC" */
+#define MJS_JSC_VERSION 1
+/* FAT timestamps have 2 second resolution */
+#define MJS_JSC_MTIME_WINDOW 3
+
+/*
+ * Header of the .jsc bytecode cache file, followed by the bcode part data.
+ * Source size and mtime are used to detect stale caches.
+ */
+struct mjs_jsc_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t src_size;
+    uint32_t src_mtime;
+    uint32_t bcode_len;
+};
+
 static void add_lineno_map_item(struct pstate* pstate) {
     if(pstate->last_emitted_line_no < pstate->line_no) {
         int offset = pstate->cur_idx - pstate->start_bcode_idx;
@@ -145,3 +164,129 @@ MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs) {
 
     mjs->bcode_len += bp.data.len;
 }
+
+/*
+ * Returns malloc-ed name of the .jsc file for the given .js `path`, or NULL if
+ * the source file does not have a .js extension. The name is a FNV-1a hash of
+ * the path, collisions are caught by the path stored in the bcode header.
+ */
+static char* mjs_bcode_jsc_path(const char* path) {
+    const char* jsext = ".js";
+    size_t path_len = strlen(path);
+    uint32_t hash = 2166136261u;
+    char* jsc_path;
+    size_t i;
+
+    if(path_len <= strlen(jsext) || strcmp(path + path_len - strlen(jsext), jsext) != 0) {
+        return NULL;
+    }
+
+    for(i = 0; i < path_len; i++) {
+        hash = (hash ^ (uint8_t)path[i]) * 16777619u;
+    }
+
+    jsc_path = (char*)malloc(sizeof(MJS_JSC_CACHE_DIR "/00000000.jsc"));
+    snprintf(
+        jsc_path,
+        sizeof(MJS_JSC_CACHE_DIR "/00000000.jsc"),
+        MJS_JSC_CACHE_DIR "/%08lx.jsc",
+        (unsigned long)hash);
+    return jsc_path;
+}
+
+static int mjs_bcode_jsc_is_valid(
+    const char* data,
+    size_t size,
+    const char* path,
+    size_t src_size,
+    uint32_t src_mtime) {
+    struct mjs_jsc_header hdr;
+    const char* bcode = data + sizeof(hdr);
+    const size_t path_off = 1 /* OP_BCODE_HEADER */ +
+                            sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT;
+    mjs_header_item_t total_size;
+
+    if(size < sizeof(hdr)) return 0;
+    memcpy(&hdr, data, sizeof(hdr));
+
+    if(hdr.magic != MJS_JSC_MAGIC || hdr.version != MJS_JSC_VERSION ||
+       hdr.src_size != src_size || hdr.src_mtime != src_mtime ||
+       hdr.bcode_len != size - sizeof(hdr) || hdr.bcode_len <= path_off) {
+        return 0;
+    }
+
+    /* Make sure the bcode is complete and belongs to this very file */
+    memcpy(
+        &total_size,
+        bcode + 1 + sizeof(mjs_header_item_t) * MJS_HDR_ITEM_TOTAL_SIZE,
+        sizeof(total_size));
+    return bcode[0] == OP_BCODE_HEADER && total_size + 1 == hdr.bcode_len &&
+           strncmp(bcode + path_off, path, hdr.bcode_len - path_off) == 0;
+}
+
+MJS_PRIVATE int mjs_bcode_load_jsc(struct mjs* mjs, const char* path) {
+    struct mjs_bcode_part bp;
+    char* jsc_path = mjs_bcode_jsc_path(path);
+    char* data = NULL;
+    size_t src_size, size = 0;
+    uint32_t src_mtime;
+    int loaded = 0;
+
+    if(jsc_path == NULL) return 0;
+
+    if(cs_stat_file(path, &src_size, &src_mtime) == 0) {
+        data = cs_read_file(jsc_path, &size);
+    }
+
+    if(data != NULL && mjs_bcode_jsc_is_valid(data, size, path, src_size, src_mtime)) {
+        memset(&bp, 0, sizeof(bp));
+        bp.data.len = size - sizeof(struct mjs_jsc_header);
+
+        /* Drop the cache header and keep only the bcode in RAM */
+        memmove(data, data + sizeof(struct mjs_jsc_header), bp.data.len);
+        bp.data.p = (char*)realloc(data, bp.data.len);
+        data = NULL;
+
+        bp.start_idx = mjs->bcode_len;
+        bp.exec_res = MJS_ERRS_CNT;
+        mjs_bcode_part_add(mjs, &bp);
+        mjs->bcode_len += bp.data.len;
+        loaded = 1;
+    }
+
+    free(data);
+    free(jsc_path);
+    return loaded;
+}
+
+MJS_PRIVATE void mjs_bcode_save_jsc(struct mjs* mjs, const char* path) {
+    struct mjs_jsc_header hdr;
+    struct mjs_bcode_part* bp;
+    char* jsc_path = mjs_bcode_jsc_path(path);
+    size_t src_size;
+    uint32_t src_mtime;
+
+    if(jsc_path == NULL) return;
+
+    /*
+     * A source edited within the same timestamp tick would keep size and
+     * mtime, so don't cache it until its mtime is safely in the past
+     */
+    if(cs_stat_file(path, &src_size, &src_mtime) == 0 &&
+       cs_time() - src_mtime >= MJS_JSC_MTIME_WINDOW) {
+        bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+
+        hdr.magic = MJS_JSC_MAGIC;
+        hdr.version = MJS_JSC_VERSION;
+        hdr.src_size = src_size;
+        hdr.src_mtime = src_mtime;
+        hdr.bcode_len = bp->data.len;
+
+        cs_prune_dir(MJS_JSC_CACHE_DIR, MJS_JSC_CACHE_MAX_FILES);
+        if(cs_write_file(jsc_path, &hdr, sizeof(hdr), bp->data.p, bp->data.len) != 0) {
+            LOG(LL_WARN, ("Failed to write %s", jsc_path));
+        }
+    }
+
+    free(jsc_path);
+}
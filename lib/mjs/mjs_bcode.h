@@ -98,6 +98,21 @@ MJS_PRIVATE int mjs_bcode_parts_cnt(struct mjs* mjs);
  */
 MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs);
 
+/*
+ * Loads bcode for the .js file `path` from its .jsc cache and adds it as a
+ * next bcode part. The cache is only used if it was generated from the
+ * source file with the same size and modification time.
+ *
+ * Returns 1 if the bcode was loaded, 0 otherwise.
+ */
+MJS_PRIVATE int mjs_bcode_load_jsc(struct mjs* mjs, const char* path);
+
+/*
+ * Writes the last bcode part, generated from the .js file `path`, to its
+ * .jsc cache.
+ */
+MJS_PRIVATE void mjs_bcode_save_jsc(struct mjs* mjs, const char* path);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -113,6 +113,7 @@ struct mjs* mjs_create(void* context) {
         sizeof(struct mjs_ffi_sig),
         MJS_FUNC_FFI_ARENA_SIZE,
         MJS_FUNC_FFI_ARENA_INC_SIZE);
+    mjs->object_arena.destructor = mjs_object_destructor;
     mjs->ffi_sig_arena.destructor = mjs_ffi_sig_destructor;
 
     global_object = mjs_mk_object(mjs);
@@ -417,6 +418,10 @@ MJS_PRIVATE void mjs_push(struct mjs* mjs, mjs_val_t v) {
     push_mjs_val(&mjs->stack, v);
 }
 
+MJS_PRIVATE void mjs_getprop_cache_reset(struct mjs* mjs) {
+    memset(mjs->getprop_cache, 0, sizeof(mjs->getprop_cache));
+}
+
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc) {
     mjs->generate_jsc = generate_jsc;
 }
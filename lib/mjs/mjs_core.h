@@ -60,6 +60,26 @@ struct mjs_bcode_part {
     unsigned in_rom : 1;
 };
 
+/*
+ * Number of entries in the OP_GET inline cache
+ */
+#ifndef MJS_GETPROP_CACHE_SIZE
+#define MJS_GETPROP_CACHE_SIZE 32
+#endif
+
+struct mjs_property;
+
+/*
+ * Inline cache entry of an OP_GET site with a constant key (`obj.name` or
+ * `name`): own property which was found in the object last time. Entries are
+ * reset whenever a property may get freed, i.e. on GC and on deletion.
+ */
+struct mjs_getprop_cache_entry {
+    size_t site; /* Global bcode offset of OP_GET */
+    mjs_val_t obj;
+    struct mjs_property* prop;
+};
+
 struct mjs {
     struct mbuf bcode_gen;
     struct mbuf bcode_parts;
@@ -89,6 +109,8 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    struct mjs_getprop_cache_entry getprop_cache[MJS_GETPROP_CACHE_SIZE];
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
@@ -130,6 +152,11 @@ MJS_PRIVATE mjs_val_t mjs_pop(struct mjs* mjs);
 MJS_PRIVATE void mjs_push(struct mjs* mjs, mjs_val_t v);
 MJS_PRIVATE void mjs_die(struct mjs* mjs);
 
+/*
+ * Invalidates all OP_GET inline cache entries
+ */
+MJS_PRIVATE void mjs_getprop_cache_reset(struct mjs* mjs);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
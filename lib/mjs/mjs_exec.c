@@ -19,10 +19,6 @@
 #include "mjs_util.h"
 #include "mjs_array_buf.h"
 
-#if MJS_GENERATE_JSC && defined(CS_MMAP)
-#include <sys/mman.h>
-#endif
-
 /*
  * Pushes call stack frame. Offset is a global bcode offset. Retval_stack_idx
  * is an index in mjs->stack at which return value should be written later.
@@ -555,6 +551,32 @@ static int getprop_builtin_data_view(
     return 0;
 }
 
+/*
+ * Gets property of an object, looking up the prototype chain. If the property
+ * is found in the object itself and `cache` is given, remembers it there.
+ */
+static mjs_val_t getprop_object(
+    struct mjs* mjs,
+    mjs_val_t obj,
+    mjs_val_t key,
+    struct mjs_getprop_cache_entry* cache,
+    size_t site) {
+    struct mjs_property* p = mjs_get_own_property_v(mjs, obj, key);
+
+    if(p == NULL) {
+        p = mjs_get_own_property(
+            mjs, obj, MJS_PROTO_PROP_NAME, sizeof(MJS_PROTO_PROP_NAME) - 1);
+        return p == NULL ? MJS_UNDEFINED : mjs_get_v_proto(mjs, p->value, key);
+    }
+
+    if(cache != NULL) {
+        cache->site = site;
+        cache->obj = obj;
+        cache->prop = p;
+    }
+    return p->value;
+}
+
 static void mjs_apply_(struct mjs* mjs) {
     mjs_val_t res = MJS_UNDEFINED, *args = NULL;
     mjs_val_t func = mjs->vals.this_obj, v = mjs_arg(mjs, 1);
@@ -604,6 +626,7 @@ static int getprop_builtin(struct mjs* mjs, mjs_val_t val, mjs_val_t name, mjs_v
 
 MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
     size_t i;
+    uint8_t prev2_opcode = OP_MAX;
     uint8_t prev_opcode = OP_MAX;
     uint8_t opcode = OP_MAX;
 
@@ -642,6 +665,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
 #if MJS_ENABLE_DEBUG
         mjs_disasm_single(code, i);
 #endif
+        prev2_opcode = prev_opcode;
         prev_opcode = opcode;
         opcode = code[i];
         switch(opcode) {
@@ -741,10 +765,25 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             mjs_val_t obj = mjs_pop(mjs);
             mjs_val_t key = mjs_pop(mjs);
             mjs_val_t val = MJS_UNDEFINED;
+            size_t site = bp.start_idx + i;
+            struct mjs_getprop_cache_entry* cache = NULL;
 
-            if(!getprop_builtin(mjs, obj, key, &val)) {
+            /*
+             * `obj.name` and `name` push the key with OP_PUSH_STR right before
+             * OP_SWAP or OP_FIND_SCOPE, so the key is the same every time this
+             * site is executed and it can use the inline cache
+             */
+            if(prev2_opcode == OP_PUSH_STR &&
+               (prev_opcode == OP_SWAP || prev_opcode == OP_FIND_SCOPE)) {
+                cache = &mjs->getprop_cache[site % MJS_GETPROP_CACHE_SIZE];
+            }
+
+            if(cache != NULL && cache->prop != NULL && cache->site == site &&
+               cache->obj == obj) {
+                val = cache->prop->value;
+            } else if(!getprop_builtin(mjs, obj, key, &val)) {
                 if(mjs_is_object(obj)) {
-                    val = mjs_get_v_proto(mjs, obj, key);
+                    val = getprop_object(mjs, obj, key, cache, site);
                 } else if((mjs_is_data_view(obj) && (mjs_is_number(key)))) {
                     val = mjs_dataview_get_prop(mjs, obj, key);
                 } else {
@@ -1073,67 +1112,9 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
 #endif
     if(generate_jsc == -1) generate_jsc = mjs->generate_jsc;
     if(mjs->error == MJS_OK) {
-#if MJS_GENERATE_JSC && defined(CS_MMAP)
+#if MJS_GENERATE_JSC
         if(generate_jsc && path != NULL) {
-            const char* jsext = ".js";
-            int basename_len = (int)strlen(path) - strlen(jsext);
-            if(basename_len > 0 && strcmp(path + basename_len, jsext) == 0) {
-                /* source file has a .js extension: create a .jsc counterpart */
-                int rewrite = 1;
-                int read_mmapped = 1;
-
-                /* construct .jsc filename */
-                const char* jscext = ".jsc";
-                char filename_jsc[basename_len + strlen(jscext) + 1 /* nul-term */];
-                memcpy(filename_jsc, path, basename_len);
-                strcpy(filename_jsc + basename_len, jscext);
-
-                /* get last bcode part */
-                struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
-
-                /*
-         * before writing .jsc file, check if it already exists and has the
-         * same contents
-         *
-         * TODO(dfrank): probably store crc32 before the bcode data, and only
-         * compare it.
-         */
-                {
-                    size_t size;
-                    char* data = cs_mmap_file(filename_jsc, &size);
-                    if(data != NULL) {
-                        if(size == bp->data.len) {
-                            if(memcmp(data, bp->data.p, size) == 0) {
-                                /* .jsc file is up to date, so don't rewrite it */
-                                rewrite = 0;
-                            }
-                        }
-                        munmap(data, size);
-                    }
-                }
-
-                /* try to open .jsc file for writing */
-                if(rewrite) {
-                    FILE* fp = fopen(filename_jsc, "wb");
-                    if(fp != NULL) {
-                        /* write last bcode part to .jsc */
-                        fwrite(bp->data.p, bp->data.len, 1, fp);
-                        fclose(fp);
-                    } else {
-                        LOG(LL_WARN, ("Failed to open %s for writing", filename_jsc));
-                        read_mmapped = 0;
-                    }
-                }
-
-                if(read_mmapped) {
-                    /* free RAM buffer with last bcode part */
-                    free((void*)bp->data.p);
-
-                    /* mmap .jsc file and set last bcode part buffer to it */
-                    bp->data.p = cs_mmap_file(filename_jsc, &bp->data.len);
-                    bp->in_rom = 1;
-                }
-            }
+            mjs_bcode_save_jsc(mjs, path);
         }
 #else
         (void)generate_jsc;
@@ -1153,7 +1134,19 @@ mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
     mjs_err_t error = MJS_FILE_READ_ERROR;
     mjs_val_t r = MJS_UNDEFINED;
     size_t size;
-    char* source_code = cs_read_file(path, &size);
+    char* source_code;
+
+#if MJS_GENERATE_JSC
+    if(mjs->generate_jsc && mjs_bcode_load_jsc(mjs, path)) {
+        /* Up to date .jsc cache is available, skip parsing */
+        mjs->error = MJS_OK;
+        mjs_execute(mjs, mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1)->start_idx, &r);
+        error = mjs->error;
+        goto clean;
+    }
+#endif
+
+    source_code = cs_read_file(path, &size);
 
     if(source_code == NULL) {
         error = MJS_FILE_READ_ERROR;
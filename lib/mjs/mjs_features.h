@@ -15,19 +15,32 @@
 #endif
 
 /*
- * MJS_GENERATE_JSC: if enabled, and if mmapping is also enabled (CS_MMAP),
- * then execution of any .js file will result in creation of a .jsc file with
- * precompiled bcode, and this .jsc file will be mmapped, instead of keeping
- * bcode in RAM.
+ * MJS_GENERATE_JSC: if enabled, execution of any .js file with
+ * mjs_set_generate_jsc() turned on will result in creation of a .jsc file
+ * with precompiled bcode in MJS_JSC_CACHE_DIR. On the next execution of the
+ * same, unmodified .js file, the bcode is loaded from the .jsc file and
+ * parsing is skipped.
  *
- * By default it's enabled (provided that CS_MMAP is defined)
+ * By default it's enabled
  */
 #if !defined(MJS_GENERATE_JSC)
-#if defined(CS_MMAP)
 #define MJS_GENERATE_JSC 1
-#else
-#define MJS_GENERATE_JSC 0
 #endif
+
+/*
+ * MJS_JSC_CACHE_DIR: directory for .jsc files, they are named after a hash
+ * of the script path so that nothing is added next to user scripts.
+ */
+#if !defined(MJS_JSC_CACHE_DIR)
+#define MJS_JSC_CACHE_DIR "/ext/.cache/js"
+#endif
+
+/*
+ * MJS_JSC_CACHE_MAX_FILES: number of .jsc files kept in MJS_JSC_CACHE_DIR,
+ * the oldest ones are removed to make room for new ones.
+ */
+#if !defined(MJS_JSC_CACHE_MAX_FILES)
+#define MJS_JSC_CACHE_MAX_FILES 32
 #endif
 
 #endif /* MJS_FEATURES_H_ */
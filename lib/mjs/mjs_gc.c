@@ -485,6 +485,9 @@ static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
 
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
+    /* Cached properties may be freed and their cells reused */
+    mjs_getprop_cache_reset(mjs);
+
     gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
 
     gc_mark_mbuf_pt(mjs, &mjs->owned_values);
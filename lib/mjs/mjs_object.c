@@ -12,6 +12,119 @@
 
 #include "common/mg_str.h"
 
+/*
+ * Minimal number of properties for an object to get a property index
+ */
+#ifndef MJS_OBJECT_INDEX_MIN_PROPS
+#define MJS_OBJECT_INDEX_MIN_PROPS 8
+#endif
+
+/*
+ * Open addressing hash index over the property list of an object. The list
+ * stays the primary storage: the index is built once a lookup has to walk
+ * past MJS_OBJECT_INDEX_MIN_PROPS properties, kept up to date on insertion
+ * and dropped on deletion.
+ */
+struct mjs_property_index_slot {
+    uint32_t hash;
+    struct mjs_property* prop;
+};
+
+struct mjs_property_index {
+    size_t size; /* Number of slots, power of 2 */
+    size_t count; /* Number of used slots */
+    struct mjs_property_index_slot slots[];
+};
+
+static uint32_t mjs_property_hash(const char* name, size_t len) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    while(len--) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void mjs_property_index_insert(
+    struct mjs_property_index* index,
+    uint32_t hash,
+    struct mjs_property* p) {
+    size_t i = hash & (index->size - 1);
+    while(index->slots[i].prop != NULL) {
+        i = (i + 1) & (index->size - 1);
+    }
+    index->slots[i].hash = hash;
+    index->slots[i].prop = p;
+    index->count++;
+}
+
+static void mjs_property_index_build(struct mjs* mjs, struct mjs_object* o) {
+    struct mjs_property* p;
+    size_t count = 0, size = MJS_OBJECT_INDEX_MIN_PROPS;
+
+    for(p = o->properties; p != NULL; p = p->next) {
+        count++;
+    }
+    /* Keep load factor at or below 1/2 */
+    while(size < count * 2) {
+        size <<= 1;
+    }
+
+    free(o->index);
+    o->index = (struct mjs_property_index*)calloc(
+        1, sizeof(struct mjs_property_index) + size * sizeof(struct mjs_property_index_slot));
+    o->index->size = size;
+
+    for(p = o->properties; p != NULL; p = p->next) {
+        size_t n;
+        const char* name = mjs_get_string(mjs, &p->name, &n);
+        mjs_property_index_insert(o->index, mjs_property_hash(name, n), p);
+    }
+}
+
+static struct mjs_property* mjs_property_index_find(
+    struct mjs* mjs,
+    struct mjs_property_index* index,
+    const char* name,
+    size_t len) {
+    uint32_t hash = mjs_property_hash(name, len);
+    size_t i = hash & (index->size - 1);
+
+    for(; index->slots[i].prop != NULL; i = (i + 1) & (index->size - 1)) {
+        struct mjs_property_index_slot* slot = &index->slots[i];
+        if(slot->hash == hash && mjs_strcmp(mjs, &slot->prop->name, name, len) == 0) {
+            return slot->prop;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Adds a property which was just prepended to the object property list
+ */
+static void mjs_property_index_add(struct mjs* mjs, struct mjs_object* o, struct mjs_property* p) {
+    size_t n;
+    const char* name;
+
+    if(o->index == NULL) return;
+
+    if((o->index->count + 1) * 2 > o->index->size) {
+        mjs_property_index_build(mjs, o);
+    } else {
+        name = mjs_get_string(mjs, &p->name, &n);
+        mjs_property_index_insert(o->index, mjs_property_hash(name, n), p);
+    }
+}
+
+MJS_PRIVATE void mjs_object_destructor(struct mjs* mjs, void* cell) {
+    struct mjs_object* o = (struct mjs_object*)cell;
+    (void)mjs;
+    free(o->index);
+    o->index = NULL;
+}
+
 MJS_PRIVATE mjs_val_t mjs_object_to_value(struct mjs_object* o) {
     if(o == NULL) {
         return MJS_NULL;
@@ -54,6 +167,7 @@ MJS_PRIVATE struct mjs_property*
     mjs_get_own_property(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
     struct mjs_property* p;
     struct mjs_object* o;
+    size_t depth = 0;
 
     if(!mjs_is_object_based(obj)) {
         return NULL;
@@ -61,19 +175,30 @@ MJS_PRIVATE struct mjs_property*
 
     o = get_object_struct(obj);
 
+    if(len == (size_t)~0) {
+        len = strlen(name);
+    }
+
+    if(o->index != NULL) {
+        return mjs_property_index_find(mjs, o->index, name, len);
+    }
+
     if(len <= 5) {
         mjs_val_t ss = mjs_mk_string(mjs, name, len, 1);
-        for(p = o->properties; p != NULL; p = p->next) {
-            if(p->name == ss) return p;
+        for(p = o->properties; p != NULL; p = p->next, depth++) {
+            if(p->name == ss) break;
         }
     } else {
-        for(p = o->properties; p != NULL; p = p->next) {
-            if(mjs_strcmp(mjs, &p->name, name, len) == 0) return p;
+        for(p = o->properties; p != NULL; p = p->next, depth++) {
+            if(mjs_strcmp(mjs, &p->name, name, len) == 0) break;
         }
-        return p;
     }
 
-    return NULL;
+    if(depth >= MJS_OBJECT_INDEX_MIN_PROPS) {
+        mjs_property_index_build(mjs, o);
+    }
+
+    return p;
 }
 
 MJS_PRIVATE struct mjs_property*
@@ -199,6 +324,7 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
         o = get_object_struct(obj);
         p->next = o->properties;
         o->properties = p;
+        mjs_property_index_add(mjs, o, p);
     }
 
     p->value = val;
@@ -232,11 +358,16 @@ int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
         size_t n;
         const char* s = mjs_get_string(mjs, &prop->name, &n);
         if(n == len && strncmp(s, name, len) == 0) {
+            struct mjs_object* o = get_object_struct(obj);
             if(prev) {
                 prev->next = prop->next;
             } else {
-                get_object_struct(obj)->properties = prop->next;
+                o->properties = prop->next;
             }
+            /* Rebuilt on next lookup if the object is still large enough */
+            free(o->index);
+            o->index = NULL;
+            mjs_getprop_cache_reset(mjs);
             mjs_destroy_property(&prop);
             return 0;
         }
@@ -21,11 +21,19 @@ struct mjs_property {
     mjs_val_t value; /* Property value */
 };
 
+struct mjs_property_index;
+
 struct mjs_object {
     struct mjs_property* properties;
+    struct mjs_property_index* index; /* Name hash index, for large objects */
 };
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v);
+
+/*
+ * Destructor for the object arena: frees property index of the object
+ */
+MJS_PRIVATE void mjs_object_destructor(struct mjs* mjs, void* cell);
 MJS_PRIVATE struct mjs_property*
     mjs_get_own_property(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len);
 
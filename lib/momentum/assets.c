@@ -9,15 +9,78 @@
 
 #define ICONS_FMT ASSET_PACKS_PATH "/%s/Icons/%s"
 #define FONTS_FMT ASSET_PACKS_PATH "/%s/Fonts/%s.u8f"
+#define ARCHIVE_FMT ASSET_PACKS_PATH "/%s/" ASSET_PACKS_ARCHIVE
+
+// See scripts/asset_packer.py
+#define ARCHIVE_MAGIC 0x314B5041 // "APK1"
+#define ARCHIVE_VERSION 1
+
+// Archived icons not drawn for this long are freed when heap runs low
+#define ARCHIVE_EVICT_MS 5000
+#define ARCHIVE_EVICT_HEAP (16 * 1024)
 
 // See lib/u8g2/u8g2_font.c
 #define U8G2_FONT_DATA_STRUCT_SIZE 23
 
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t entry_count;
+    uint32_t names_size;
+} FURI_PACKED AssetPackArchiveHeader;
+
+typedef struct {
+    uint32_t name_offset;
+    uint32_t data_offset;
+    uint32_t data_size;
+    uint16_t width;
+    uint16_t height;
+    uint8_t frame_count; // 0 for fonts
+    uint8_t frame_rate;
+    uint16_t reserved;
+} FURI_PACKED AssetPackArchiveEntry;
+
+typedef struct {
+    Icon original; // Must be first, replaced icon->original points here
+    uint8_t* data; // All frames of archived icon, NULL until first draw
+    uint32_t data_offset;
+    uint32_t data_size; // 0 for icons loaded from loose files
+    uint32_t last_used;
+    uint16_t pins; // Frames being drawn, data is not evicted
+} AssetPackIcon;
+
+typedef struct {
+    uint32_t data_offset;
+    uint32_t data_size; // 0 when not in archive or already loaded
+} AssetPackFont;
+
 AssetPacks asset_packs = {
     .fonts = {NULL},
     .font_params = {NULL},
 };
 
+static FuriMutex* archive_mutex = NULL;
+static char* archive_path = NULL;
+static AssetPackFont archive_fonts[FontTotalNumber];
+
+static void replace_icon(
+    const Icon* replace,
+    AssetPackIcon* record,
+    uint16_t width,
+    uint16_t height,
+    uint8_t frame_rate,
+    uint8_t frame_count,
+    uint8_t** frames) {
+    memcpy(&record->original, replace, sizeof(Icon));
+    FURI_CONST_ASSIGN_PTR(replace->original, &record->original);
+    FURI_CONST_ASSIGN(replace->width, width);
+    FURI_CONST_ASSIGN(replace->height, height);
+    FURI_CONST_ASSIGN(replace->frame_rate, frame_rate);
+    FURI_CONST_ASSIGN(replace->frame_count, frame_count);
+    FURI_CONST_ASSIGN_PTR(replace->frames, frames);
+}
+
 static void
     load_icon_animated(const Icon* replace, const char* name, FuriString* path, File* file) {
     const char* pack = momentum_settings.asset_pack;
@@ -51,14 +114,9 @@ static void
             }
 
             if(i == frame_count) {
-                Icon* original = malloc(sizeof(Icon));
-                memcpy(original, replace, sizeof(Icon));
-                FURI_CONST_ASSIGN_PTR(replace->original, original);
-                FURI_CONST_ASSIGN(replace->width, icon_width);
-                FURI_CONST_ASSIGN(replace->height, icon_height);
-                FURI_CONST_ASSIGN(replace->frame_rate, frame_rate);
-                FURI_CONST_ASSIGN(replace->frame_count, frame_count);
-                FURI_CONST_ASSIGN_PTR(replace->frames, frames);
+                AssetPackIcon* record = malloc(sizeof(AssetPackIcon));
+                replace_icon(
+                    replace, record, icon_width, icon_height, frame_rate, frame_count, frames);
             } else {
                 for(; i >= 0; i--) {
                     free(frames[i]);
@@ -80,16 +138,10 @@ static void load_icon_static(const Icon* replace, const char* name, FuriString*
         if(storage_file_read(file, &icon_width, 4) == 4 &&
            storage_file_read(file, &icon_height, 4) == 4 &&
            storage_file_read(file, frame, size) == size) {
-            Icon* original = malloc(sizeof(Icon));
-            memcpy(original, replace, sizeof(Icon));
-            FURI_CONST_ASSIGN_PTR(replace->original, original);
+            AssetPackIcon* record = malloc(sizeof(AssetPackIcon));
             uint8_t** frames = malloc(sizeof(const uint8_t*));
             frames[0] = frame;
-            FURI_CONST_ASSIGN(replace->frame_rate, 0);
-            FURI_CONST_ASSIGN(replace->frame_count, 1);
-            FURI_CONST_ASSIGN(replace->width, icon_width);
-            FURI_CONST_ASSIGN(replace->height, icon_height);
-            FURI_CONST_ASSIGN_PTR(replace->frames, frames);
+            replace_icon(replace, record, icon_width, icon_height, 0, 1, frames);
         } else {
             free(frame);
         }
@@ -101,14 +153,30 @@ static void free_icon(const Icon* icon) {
     uint8_t** frames = (void*)icon->frames;
     int32_t frame_count = icon->frame_count;
 
-    Icon* original = icon->original;
-    memcpy((void*)icon, original, sizeof(Icon));
+    AssetPackIcon* record = (AssetPackIcon*)icon->original;
+    memcpy((void*)icon, &record->original, sizeof(Icon));
 
-    free(original);
-    for(int32_t i = 0; i < frame_count; i++) {
-        free(frames[i]);
+    if(record->data_size) {
+        free(record->data);
+    } else {
+        for(int32_t i = 0; i < frame_count; i++) {
+            free(frames[i]);
+        }
     }
     free(frames);
+    free(record);
+}
+
+static void set_font(Font font, uint8_t* swap) {
+    CanvasFontParameters* params = malloc(sizeof(CanvasFontParameters));
+    // See lib/u8g2/u8g2_font.c
+    params->leading_default = swap[10]; // max_char_height
+    params->leading_min = params->leading_default - 2; // good enough
+    params->height = MAX((int8_t)swap[15], 0); // ascent_para
+    params->descender = MAX((int8_t)swap[16], 0); // descent_para
+    // Params first, canvas checks font and reads params without locking
+    asset_packs.font_params[font] = params;
+    asset_packs.fonts[font] = swap;
 }
 
 static void load_font(Font font, const char* name, FuriString* path, File* file) {
@@ -118,14 +186,7 @@ static void load_font(Font font, const char* name, FuriString* path, File* file)
         uint8_t* swap = malloc(size);
 
         if(size > U8G2_FONT_DATA_STRUCT_SIZE && storage_file_read(file, swap, size) == size) {
-            asset_packs.fonts[font] = swap;
-            CanvasFontParameters* params = malloc(sizeof(CanvasFontParameters));
-            // See lib/u8g2/u8g2_font.c
-            params->leading_default = swap[10]; // max_char_height
-            params->leading_min = params->leading_default - 2; // good enough
-            params->height = MAX((int8_t)swap[15], 0); // ascent_para
-            params->descender = MAX((int8_t)swap[16], 0); // descent_para
-            asset_packs.font_params[font] = params;
+            set_font(font, swap);
         } else {
             free(swap);
         }
@@ -148,10 +209,260 @@ static const char* font_names[] = {
     [FontBatteryPercent] = "BatteryPercent",
 };
 
+static uint8_t* archive_read(uint32_t offset, uint32_t size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(size);
+    if(!storage_file_open(file, archive_path, FSAM_READ, FSOM_OPEN_EXISTING) ||
+       !storage_file_seek(file, offset, true) || storage_file_read(file, data, size) != size) {
+        free(data);
+        data = NULL;
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return data;
+}
+
+static void archive_evict_icons(void) {
+    uint32_t now = furi_get_tick();
+    size_t evicted = 0;
+    for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
+        const Icon* icon = ICON_PATHS[i].icon;
+        AssetPackIcon* record = (AssetPackIcon*)icon->original;
+        if(!record || !record->data || record->pins ||
+           now - record->last_used < furi_ms_to_ticks(ARCHIVE_EVICT_MS)) {
+            continue;
+        }
+        memset((void*)icon->frames, 0, sizeof(const uint8_t*) * icon->frame_count);
+        free(record->data);
+        record->data = NULL;
+        evicted++;
+    }
+    FURI_LOG_D(TAG, "Evicted %zu icons, %zu bytes free", evicted, memmgr_get_free_heap());
+}
+
+static void archive_load_icon(const Icon* icon, AssetPackIcon* record) {
+    if(memmgr_get_free_heap() < ARCHIVE_EVICT_HEAP) {
+        archive_evict_icons();
+    }
+
+    uint8_t** frames = (void*)icon->frames;
+    uint8_t frame_count = icon->frame_count;
+    uint32_t table_size = sizeof(uint32_t) * (frame_count + 1);
+    uint8_t* data = archive_read(record->data_offset, record->data_size);
+
+    bool ok = data != NULL;
+    if(ok) {
+        const uint32_t* offsets = (const uint32_t*)data;
+        ok = offsets[0] == table_size && offsets[frame_count] == record->data_size;
+        for(uint8_t i = 0; ok && i < frame_count; i++) {
+            ok = offsets[i] < offsets[i + 1];
+            frames[i] = data + offsets[i];
+        }
+    }
+
+    if(!ok) {
+        // Keep drawing something of the right size, next attempt after eviction
+        FURI_LOG_E(TAG, "Failed to load %ux%u icon", icon->width, icon->height);
+        free(data);
+        data = malloc(ROUND_UP_TO(icon->width, 8) * icon->height + 1);
+        for(uint8_t i = 0; i < frame_count; i++) {
+            frames[i] = data;
+        }
+    }
+    record->data = data;
+}
+
+// Eviction runs on other threads, so archived frames are only looked up under the mutex
+static const uint8_t* archive_get_icon_frame(const Icon* icon, uint32_t frame, bool pin) {
+    AssetPackIcon* record = (AssetPackIcon*)icon->original;
+
+    furi_check(furi_mutex_acquire(archive_mutex, FuriWaitForever) == FuriStatusOk);
+    if(!record->data) {
+        archive_load_icon(icon, record);
+    }
+    record->last_used = furi_get_tick();
+    if(pin) {
+        furi_check(record->pins < UINT16_MAX);
+        record->pins++;
+    }
+    const uint8_t* data = icon->frames[frame];
+    furi_mutex_release(archive_mutex);
+
+    return data;
+}
+
+const uint8_t* asset_packs_get_icon_frame(const Icon* icon, uint32_t frame) {
+    AssetPackIcon* record = (AssetPackIcon*)icon->original;
+    if(!record->data_size) return icon->frames[frame];
+
+    return archive_get_icon_frame(icon, frame, false);
+}
+
+const uint8_t* asset_packs_pin_icon_frame(const Icon* icon, uint32_t frame) {
+    AssetPackIcon* record = (AssetPackIcon*)icon->original;
+    if(!record->data_size) return icon->frames[frame];
+
+    return archive_get_icon_frame(icon, frame, true);
+}
+
+void asset_packs_unpin_icon_frame(const Icon* icon) {
+    AssetPackIcon* record = (AssetPackIcon*)icon->original;
+    if(!record->data_size) return;
+
+    furi_check(furi_mutex_acquire(archive_mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(record->pins);
+    record->pins--;
+    furi_mutex_release(archive_mutex);
+}
+
+const uint8_t* asset_packs_get_font(Font font) {
+    if(!asset_packs.fonts[font] && archive_fonts[font].data_size) {
+        furi_check(furi_mutex_acquire(archive_mutex, FuriWaitForever) == FuriStatusOk);
+        AssetPackFont* entry = &archive_fonts[font];
+        if(!asset_packs.fonts[font] && entry->data_size) {
+            uint8_t* swap = archive_read(entry->data_offset, entry->data_size);
+            if(swap) {
+                set_font(font, swap);
+            } else {
+                FURI_LOG_E(TAG, "Failed to load font %s", font_names[font]);
+            }
+            // Single attempt, built-in font is used on failure
+            entry->data_size = 0;
+        }
+        furi_mutex_release(archive_mutex);
+    }
+    return asset_packs.fonts[font];
+}
+
+const CanvasFontParameters* asset_packs_get_font_params(Font font) {
+    asset_packs_get_font(font);
+    return asset_packs.font_params[font];
+}
+
+static const AssetPackArchiveEntry* archive_find(
+    const AssetPackArchiveEntry* entries,
+    uint16_t entry_count,
+    const char* names,
+    uint32_t names_size,
+    const char* name) {
+    size_t low = 0, high = entry_count;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        if(entries[mid].name_offset >= names_size) return NULL;
+        int cmp = strcmp(names + entries[mid].name_offset, name);
+        if(cmp == 0) return &entries[mid];
+        if(cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
+static bool init_archive(FuriString* path, File* file, size_t* icons, size_t* fonts) {
+    AssetPackArchiveHeader header;
+    AssetPackArchiveEntry* entries = NULL;
+    char* names = NULL;
+    bool ok = false;
+
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != ARCHIVE_MAGIC || header.version != ARCHIVE_VERSION) {
+            FURI_LOG_E(TAG, "Unsupported archive %s", furi_string_get_cstr(path));
+            break;
+        }
+        size_t entries_size = sizeof(AssetPackArchiveEntry) * header.entry_count;
+        entries = malloc(entries_size);
+        names = malloc(header.names_size + 1);
+        if(storage_file_read(file, entries, entries_size) != entries_size) break;
+        if(storage_file_read(file, names, header.names_size) != header.names_size) break;
+        ok = true;
+    } while(false);
+    storage_file_close(file);
+
+    if(ok) {
+        archive_path = strdup(furi_string_get_cstr(path));
+        FuriString* name = furi_string_alloc();
+
+        for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
+            const Icon* icon = ICON_PATHS[i].icon;
+            if(icon->original != NULL) continue;
+            const AssetPackArchiveEntry* entry = archive_find(
+                entries, header.entry_count, names, header.names_size, ICON_PATHS[i].path);
+            if(!entry || !entry->frame_count || !entry->width || !entry->height ||
+               entry->data_size <= sizeof(uint32_t) * (entry->frame_count + 1))
+                continue;
+
+            // Frame data is loaded on first draw, size is needed for layout right away
+            AssetPackIcon* record = malloc(sizeof(AssetPackIcon));
+            record->data_offset = entry->data_offset;
+            record->data_size = entry->data_size;
+            uint8_t** frames = malloc(sizeof(const uint8_t*) * entry->frame_count);
+            replace_icon(
+                icon,
+                record,
+                entry->width,
+                entry->height,
+                entry->frame_rate,
+                entry->frame_count,
+                frames);
+            (*icons)++;
+        }
+
+        for(Font font = 0; font < FontTotalNumber; font++) {
+            furi_string_printf(name, "Fonts/%s", font_names[font]);
+            const AssetPackArchiveEntry* entry = archive_find(
+                entries, header.entry_count, names, header.names_size, furi_string_get_cstr(name));
+            if(!entry || entry->frame_count || entry->data_size <= U8G2_FONT_DATA_STRUCT_SIZE)
+                continue;
+            archive_fonts[font].data_offset = entry->data_offset;
+            archive_fonts[font].data_size = entry->data_size;
+            (*fonts)++;
+        }
+
+        furi_string_free(name);
+    }
+
+    free(names);
+    free(entries);
+    return ok;
+}
+
+static void init_loose(FuriString* path, File* file, size_t* icons, size_t* fonts) {
+    for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
+        if(ICON_PATHS[i].icon->original == NULL) {
+            if(ICON_PATHS[i].icon->frame_count > 1) {
+                load_icon_animated(ICON_PATHS[i].icon, ICON_PATHS[i].path, path, file);
+            } else {
+                load_icon_static(ICON_PATHS[i].icon, ICON_PATHS[i].path, path, file);
+            }
+            if(ICON_PATHS[i].icon->original != NULL) (*icons)++;
+        }
+    }
+
+    for(Font font = 0; font < FontTotalNumber; font++) {
+        load_font(font, font_names[font], path, file);
+        if(asset_packs.fonts[font] != NULL) (*fonts)++;
+    }
+}
+
 void asset_packs_init(void) {
     const char* pack = momentum_settings.asset_pack;
     if(pack[0] == '\0') return;
 
+    if(!archive_mutex) {
+        archive_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    }
+
+    uint32_t start = furi_get_tick();
+    size_t heap = memmgr_get_free_heap();
+    size_t icons = 0, fonts = 0;
+    bool archived = false;
+
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FuriString* p = furi_string_alloc();
     FileInfo info;
@@ -160,27 +471,33 @@ void asset_packs_init(void) {
        info.flags & FSF_DIRECTORY) {
         File* f = storage_file_alloc(storage);
 
-        for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
-            if(ICON_PATHS[i].icon->original == NULL) {
-                if(ICON_PATHS[i].icon->frame_count > 1) {
-                    load_icon_animated(ICON_PATHS[i].icon, ICON_PATHS[i].path, p, f);
-                } else {
-                    load_icon_static(ICON_PATHS[i].icon, ICON_PATHS[i].path, p, f);
-                }
-            }
-        }
-
-        for(Font font = 0; font < FontTotalNumber; font++) {
-            load_font(font, font_names[font], p, f);
+        furi_string_printf(p, ARCHIVE_FMT, pack);
+        archived = init_archive(p, f, &icons, &fonts);
+        if(!archived) {
+            init_loose(p, f, &icons, &fonts);
         }
 
         storage_file_free(f);
     }
     furi_string_free(p);
     furi_record_close(RECORD_STORAGE);
+
+    FURI_LOG_I(
+        TAG,
+        "Pack '%s' (%s): %zu icons, %zu fonts in %lu ms, %d bytes heap",
+        pack,
+        archived ? "archive" : "loose",
+        icons,
+        fonts,
+        furi_get_tick() - start,
+        (int)(heap - memmgr_get_free_heap()));
 }
 
 void asset_packs_free(void) {
+    if(archive_mutex) {
+        furi_check(furi_mutex_acquire(archive_mutex, FuriWaitForever) == FuriStatusOk);
+    }
+
     for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
         if(ICON_PATHS[i].icon->original != NULL) {
             free_icon(ICON_PATHS[i].icon);
@@ -188,8 +505,16 @@ void asset_packs_free(void) {
     }
 
     for(Font font = 0; font < FontTotalNumber; font++) {
+        archive_fonts[font].data_size = 0;
         if(asset_packs.fonts[font] != NULL) {
             free_font(font);
         }
     }
+
+    free(archive_path);
+    archive_path = NULL;
+
+    if(archive_mutex) {
+        furi_mutex_release(archive_mutex);
+    }
 }
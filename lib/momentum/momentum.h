@@ -13,6 +13,7 @@ extern "C" {
 
 #define MOMENTUM_SETTINGS_PATH CFG_PATH("momentum_settings.txt")
 #define ASSET_PACKS_PATH EXT_PATH("asset_packs")
+#define ASSET_PACKS_ARCHIVE "assets.pak"
 #define MAINMENU_APPS_PATH CFG_PATH("mainmenu_apps.txt")
 #define ASSET_PACKS_NAME_LEN 32
 
@@ -111,6 +112,13 @@ extern MomentumSettings momentum_settings;
 
 void asset_packs_init(void);
 void asset_packs_free(void);
+// Archived pack icons and fonts are read from SD card on first use
+const uint8_t* asset_packs_get_icon_frame(const Icon* icon, uint32_t frame);
+// Same, but frame data is not evicted until unpinned, for drawing
+const uint8_t* asset_packs_pin_icon_frame(const Icon* icon, uint32_t frame);
+void asset_packs_unpin_icon_frame(const Icon* icon);
+const uint8_t* asset_packs_get_font(Font font);
+const CanvasFontParameters* asset_packs_get_font_params(Font font);
 extern AssetPacks asset_packs;
 
 #ifdef __cplusplus
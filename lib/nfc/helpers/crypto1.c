@@ -13,6 +13,190 @@
 
 #define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
 
+// Feedback bits of 8 steps for each byte of odd and even halves, high nibble is shifted
+// into odd half, low nibble into even half. Feedback is linear, so contributions are XORed
+static const uint8_t crypto1_feedback_table[6][256] = {
+    {
+        0x00, 0x23, 0x57, 0x74, 0xBE, 0x9D, 0xE9, 0xCA, 0x2C, 0x0F, 0x7B, 0x58, 0x92, 0xB1, 0xC5,
+        0xE6, 0x3B, 0x18, 0x6C, 0x4F, 0x85, 0xA6, 0xD2, 0xF1, 0x17, 0x34, 0x40, 0x63, 0xA9, 0x8A,
+        0xFE, 0xDD, 0x14, 0x37, 0x43, 0x60, 0xAA, 0x89, 0xFD, 0xDE, 0x38, 0x1B, 0x6F, 0x4C, 0x86,
+        0xA5, 0xD1, 0xF2, 0x2F, 0x0C, 0x78, 0x5B, 0x91, 0xB2, 0xC6, 0xE5, 0x03, 0x20, 0x54, 0x77,
+        0xBD, 0x9E, 0xEA, 0xC9, 0x38, 0x1B, 0x6F, 0x4C, 0x86, 0xA5, 0xD1, 0xF2, 0x14, 0x37, 0x43,
+        0x60, 0xAA, 0x89, 0xFD, 0xDE, 0x03, 0x20, 0x54, 0x77, 0xBD, 0x9E, 0xEA, 0xC9, 0x2F, 0x0C,
+        0x78, 0x5B, 0x91, 0xB2, 0xC6, 0xE5, 0x2C, 0x0F, 0x7B, 0x58, 0x92, 0xB1, 0xC5, 0xE6, 0x00,
+        0x23, 0x57, 0x74, 0xBE, 0x9D, 0xE9, 0xCA, 0x17, 0x34, 0x40, 0x63, 0xA9, 0x8A, 0xFE, 0xDD,
+        0x3B, 0x18, 0x6C, 0x4F, 0x85, 0xA6, 0xD2, 0xF1, 0x03, 0x20, 0x54, 0x77, 0xBD, 0x9E, 0xEA,
+        0xC9, 0x2F, 0x0C, 0x78, 0x5B, 0x91, 0xB2, 0xC6, 0xE5, 0x38, 0x1B, 0x6F, 0x4C, 0x86, 0xA5,
+        0xD1, 0xF2, 0x14, 0x37, 0x43, 0x60, 0xAA, 0x89, 0xFD, 0xDE, 0x17, 0x34, 0x40, 0x63, 0xA9,
+        0x8A, 0xFE, 0xDD, 0x3B, 0x18, 0x6C, 0x4F, 0x85, 0xA6, 0xD2, 0xF1, 0x2C, 0x0F, 0x7B, 0x58,
+        0x92, 0xB1, 0xC5, 0xE6, 0x00, 0x23, 0x57, 0x74, 0xBE, 0x9D, 0xE9, 0xCA, 0x3B, 0x18, 0x6C,
+        0x4F, 0x85, 0xA6, 0xD2, 0xF1, 0x17, 0x34, 0x40, 0x63, 0xA9, 0x8A, 0xFE, 0xDD, 0x00, 0x23,
+        0x57, 0x74, 0xBE, 0x9D, 0xE9, 0xCA, 0x2C, 0x0F, 0x7B, 0x58, 0x92, 0xB1, 0xC5, 0xE6, 0x2F,
+        0x0C, 0x78, 0x5B, 0x91, 0xB2, 0xC6, 0xE5, 0x03, 0x20, 0x54, 0x77, 0xBD, 0x9E, 0xEA, 0xC9,
+        0x14, 0x37, 0x43, 0x60, 0xAA, 0x89, 0xFD, 0xDE, 0x38, 0x1B, 0x6F, 0x4C, 0x86, 0xA5, 0xD1,
+        0xF2,
+    },
+    {
+        0x00, 0x07, 0x0F, 0x08, 0x6D, 0x6A, 0x62, 0x65, 0xA9, 0xAE, 0xA6, 0xA1, 0xC4, 0xC3, 0xCB,
+        0xCC, 0x03, 0x04, 0x0C, 0x0B, 0x6E, 0x69, 0x61, 0x66, 0xAA, 0xAD, 0xA5, 0xA2, 0xC7, 0xC0,
+        0xC8, 0xCF, 0x07, 0x00, 0x08, 0x0F, 0x6A, 0x6D, 0x65, 0x62, 0xAE, 0xA9, 0xA1, 0xA6, 0xC3,
+        0xC4, 0xCC, 0xCB, 0x04, 0x03, 0x0B, 0x0C, 0x69, 0x6E, 0x66, 0x61, 0xAD, 0xAA, 0xA2, 0xA5,
+        0xC0, 0xC7, 0xCF, 0xC8, 0x1F, 0x18, 0x10, 0x17, 0x72, 0x75, 0x7D, 0x7A, 0xB6, 0xB1, 0xB9,
+        0xBE, 0xDB, 0xDC, 0xD4, 0xD3, 0x1C, 0x1B, 0x13, 0x14, 0x71, 0x76, 0x7E, 0x79, 0xB5, 0xB2,
+        0xBA, 0xBD, 0xD8, 0xDF, 0xD7, 0xD0, 0x18, 0x1F, 0x17, 0x10, 0x75, 0x72, 0x7A, 0x7D, 0xB1,
+        0xB6, 0xBE, 0xB9, 0xDC, 0xDB, 0xD3, 0xD4, 0x1B, 0x1C, 0x14, 0x13, 0x76, 0x71, 0x79, 0x7E,
+        0xB2, 0xB5, 0xBD, 0xBA, 0xDF, 0xD8, 0xD0, 0xD7, 0x5D, 0x5A, 0x52, 0x55, 0x30, 0x37, 0x3F,
+        0x38, 0xF4, 0xF3, 0xFB, 0xFC, 0x99, 0x9E, 0x96, 0x91, 0x5E, 0x59, 0x51, 0x56, 0x33, 0x34,
+        0x3C, 0x3B, 0xF7, 0xF0, 0xF8, 0xFF, 0x9A, 0x9D, 0x95, 0x92, 0x5A, 0x5D, 0x55, 0x52, 0x37,
+        0x30, 0x38, 0x3F, 0xF3, 0xF4, 0xFC, 0xFB, 0x9E, 0x99, 0x91, 0x96, 0x59, 0x5E, 0x56, 0x51,
+        0x34, 0x33, 0x3B, 0x3C, 0xF0, 0xF7, 0xFF, 0xF8, 0x9D, 0x9A, 0x92, 0x95, 0x42, 0x45, 0x4D,
+        0x4A, 0x2F, 0x28, 0x20, 0x27, 0xEB, 0xEC, 0xE4, 0xE3, 0x86, 0x81, 0x89, 0x8E, 0x41, 0x46,
+        0x4E, 0x49, 0x2C, 0x2B, 0x23, 0x24, 0xE8, 0xEF, 0xE7, 0xE0, 0x85, 0x82, 0x8A, 0x8D, 0x45,
+        0x42, 0x4A, 0x4D, 0x28, 0x2F, 0x27, 0x20, 0xEC, 0xEB, 0xE3, 0xE4, 0x81, 0x86, 0x8E, 0x89,
+        0x46, 0x41, 0x49, 0x4E, 0x2B, 0x2C, 0x24, 0x23, 0xEF, 0xE8, 0xE0, 0xE7, 0x82, 0x85, 0x8D,
+        0x8A,
+    },
+    {
+        0x00, 0xC9, 0xD3, 0x1A, 0x84, 0x4D, 0x57, 0x9E, 0x3B, 0xF2, 0xE8, 0x21, 0xBF, 0x76, 0x6C,
+        0xA5, 0x04, 0xCD, 0xD7, 0x1E, 0x80, 0x49, 0x53, 0x9A, 0x3F, 0xF6, 0xEC, 0x25, 0xBB, 0x72,
+        0x68, 0xA1, 0x19, 0xD0, 0xCA, 0x03, 0x9D, 0x54, 0x4E, 0x87, 0x22, 0xEB, 0xF1, 0x38, 0xA6,
+        0x6F, 0x75, 0xBC, 0x1D, 0xD4, 0xCE, 0x07, 0x99, 0x50, 0x4A, 0x83, 0x26, 0xEF, 0xF5, 0x3C,
+        0xA2, 0x6B, 0x71, 0xB8, 0x40, 0x89, 0x93, 0x5A, 0xC4, 0x0D, 0x17, 0xDE, 0x7B, 0xB2, 0xA8,
+        0x61, 0xFF, 0x36, 0x2C, 0xE5, 0x44, 0x8D, 0x97, 0x5E, 0xC0, 0x09, 0x13, 0xDA, 0x7F, 0xB6,
+        0xAC, 0x65, 0xFB, 0x32, 0x28, 0xE1, 0x59, 0x90, 0x8A, 0x43, 0xDD, 0x14, 0x0E, 0xC7, 0x62,
+        0xAB, 0xB1, 0x78, 0xE6, 0x2F, 0x35, 0xFC, 0x5D, 0x94, 0x8E, 0x47, 0xD9, 0x10, 0x0A, 0xC3,
+        0x66, 0xAF, 0xB5, 0x7C, 0xE2, 0x2B, 0x31, 0xF8, 0x91, 0x58, 0x42, 0x8B, 0x15, 0xDC, 0xC6,
+        0x0F, 0xAA, 0x63, 0x79, 0xB0, 0x2E, 0xE7, 0xFD, 0x34, 0x95, 0x5C, 0x46, 0x8F, 0x11, 0xD8,
+        0xC2, 0x0B, 0xAE, 0x67, 0x7D, 0xB4, 0x2A, 0xE3, 0xF9, 0x30, 0x88, 0x41, 0x5B, 0x92, 0x0C,
+        0xC5, 0xDF, 0x16, 0xB3, 0x7A, 0x60, 0xA9, 0x37, 0xFE, 0xE4, 0x2D, 0x8C, 0x45, 0x5F, 0x96,
+        0x08, 0xC1, 0xDB, 0x12, 0xB7, 0x7E, 0x64, 0xAD, 0x33, 0xFA, 0xE0, 0x29, 0xD1, 0x18, 0x02,
+        0xCB, 0x55, 0x9C, 0x86, 0x4F, 0xEA, 0x23, 0x39, 0xF0, 0x6E, 0xA7, 0xBD, 0x74, 0xD5, 0x1C,
+        0x06, 0xCF, 0x51, 0x98, 0x82, 0x4B, 0xEE, 0x27, 0x3D, 0xF4, 0x6A, 0xA3, 0xB9, 0x70, 0xC8,
+        0x01, 0x1B, 0xD2, 0x4C, 0x85, 0x9F, 0x56, 0xF3, 0x3A, 0x20, 0xE9, 0x77, 0xBE, 0xA4, 0x6D,
+        0xCC, 0x05, 0x1F, 0xD6, 0x48, 0x81, 0x9B, 0x52, 0xF7, 0x3E, 0x24, 0xED, 0x73, 0xBA, 0xA0,
+        0x69,
+    },
+    {
+        0x00, 0x72, 0xE5, 0x97, 0xF8, 0x8A, 0x1D, 0x6F, 0xB1, 0xC3, 0x54, 0x26, 0x49, 0x3B, 0xAC,
+        0xDE, 0x40, 0x32, 0xA5, 0xD7, 0xB8, 0xCA, 0x5D, 0x2F, 0xF1, 0x83, 0x14, 0x66, 0x09, 0x7B,
+        0xEC, 0x9E, 0x81, 0xF3, 0x64, 0x16, 0x79, 0x0B, 0x9C, 0xEE, 0x30, 0x42, 0xD5, 0xA7, 0xC8,
+        0xBA, 0x2D, 0x5F, 0xC1, 0xB3, 0x24, 0x56, 0x39, 0x4B, 0xDC, 0xAE, 0x70, 0x02, 0x95, 0xE7,
+        0x88, 0xFA, 0x6D, 0x1F, 0x30, 0x42, 0xD5, 0xA7, 0xC8, 0xBA, 0x2D, 0x5F, 0x81, 0xF3, 0x64,
+        0x16, 0x79, 0x0B, 0x9C, 0xEE, 0x70, 0x02, 0x95, 0xE7, 0x88, 0xFA, 0x6D, 0x1F, 0xC1, 0xB3,
+        0x24, 0x56, 0x39, 0x4B, 0xDC, 0xAE, 0xB1, 0xC3, 0x54, 0x26, 0x49, 0x3B, 0xAC, 0xDE, 0x00,
+        0x72, 0xE5, 0x97, 0xF8, 0x8A, 0x1D, 0x6F, 0xF1, 0x83, 0x14, 0x66, 0x09, 0x7B, 0xEC, 0x9E,
+        0x40, 0x32, 0xA5, 0xD7, 0xB8, 0xCA, 0x5D, 0x2F, 0x70, 0x02, 0x95, 0xE7, 0x88, 0xFA, 0x6D,
+        0x1F, 0xC1, 0xB3, 0x24, 0x56, 0x39, 0x4B, 0xDC, 0xAE, 0x30, 0x42, 0xD5, 0xA7, 0xC8, 0xBA,
+        0x2D, 0x5F, 0x81, 0xF3, 0x64, 0x16, 0x79, 0x0B, 0x9C, 0xEE, 0xF1, 0x83, 0x14, 0x66, 0x09,
+        0x7B, 0xEC, 0x9E, 0x40, 0x32, 0xA5, 0xD7, 0xB8, 0xCA, 0x5D, 0x2F, 0xB1, 0xC3, 0x54, 0x26,
+        0x49, 0x3B, 0xAC, 0xDE, 0x00, 0x72, 0xE5, 0x97, 0xF8, 0x8A, 0x1D, 0x6F, 0x40, 0x32, 0xA5,
+        0xD7, 0xB8, 0xCA, 0x5D, 0x2F, 0xF1, 0x83, 0x14, 0x66, 0x09, 0x7B, 0xEC, 0x9E, 0x00, 0x72,
+        0xE5, 0x97, 0xF8, 0x8A, 0x1D, 0x6F, 0xB1, 0xC3, 0x54, 0x26, 0x49, 0x3B, 0xAC, 0xDE, 0xC1,
+        0xB3, 0x24, 0x56, 0x39, 0x4B, 0xDC, 0xAE, 0x70, 0x02, 0x95, 0xE7, 0x88, 0xFA, 0x6D, 0x1F,
+        0x81, 0xF3, 0x64, 0x16, 0x79, 0x0B, 0x9C, 0xEE, 0x30, 0x42, 0xD5, 0xA7, 0xC8, 0xBA, 0x2D,
+        0x5F,
+    },
+    {
+        0x00, 0xF0, 0xD3, 0x23, 0x95, 0x65, 0x46, 0xB6, 0x09, 0xF9, 0xDA, 0x2A, 0x9C, 0x6C, 0x4F,
+        0xBF, 0x70, 0x80, 0xA3, 0x53, 0xE5, 0x15, 0x36, 0xC6, 0x79, 0x89, 0xAA, 0x5A, 0xEC, 0x1C,
+        0x3F, 0xCF, 0xF0, 0x00, 0x23, 0xD3, 0x65, 0x95, 0xB6, 0x46, 0xF9, 0x09, 0x2A, 0xDA, 0x6C,
+        0x9C, 0xBF, 0x4F, 0x80, 0x70, 0x53, 0xA3, 0x15, 0xE5, 0xC6, 0x36, 0x89, 0x79, 0x5A, 0xAA,
+        0x1C, 0xEC, 0xCF, 0x3F, 0xD2, 0x22, 0x01, 0xF1, 0x47, 0xB7, 0x94, 0x64, 0xDB, 0x2B, 0x08,
+        0xF8, 0x4E, 0xBE, 0x9D, 0x6D, 0xA2, 0x52, 0x71, 0x81, 0x37, 0xC7, 0xE4, 0x14, 0xAB, 0x5B,
+        0x78, 0x88, 0x3E, 0xCE, 0xED, 0x1D, 0x22, 0xD2, 0xF1, 0x01, 0xB7, 0x47, 0x64, 0x94, 0x2B,
+        0xDB, 0xF8, 0x08, 0xBE, 0x4E, 0x6D, 0x9D, 0x52, 0xA2, 0x81, 0x71, 0xC7, 0x37, 0x14, 0xE4,
+        0x5B, 0xAB, 0x88, 0x78, 0xCE, 0x3E, 0x1D, 0xED, 0x96, 0x66, 0x45, 0xB5, 0x03, 0xF3, 0xD0,
+        0x20, 0x9F, 0x6F, 0x4C, 0xBC, 0x0A, 0xFA, 0xD9, 0x29, 0xE6, 0x16, 0x35, 0xC5, 0x73, 0x83,
+        0xA0, 0x50, 0xEF, 0x1F, 0x3C, 0xCC, 0x7A, 0x8A, 0xA9, 0x59, 0x66, 0x96, 0xB5, 0x45, 0xF3,
+        0x03, 0x20, 0xD0, 0x6F, 0x9F, 0xBC, 0x4C, 0xFA, 0x0A, 0x29, 0xD9, 0x16, 0xE6, 0xC5, 0x35,
+        0x83, 0x73, 0x50, 0xA0, 0x1F, 0xEF, 0xCC, 0x3C, 0x8A, 0x7A, 0x59, 0xA9, 0x44, 0xB4, 0x97,
+        0x67, 0xD1, 0x21, 0x02, 0xF2, 0x4D, 0xBD, 0x9E, 0x6E, 0xD8, 0x28, 0x0B, 0xFB, 0x34, 0xC4,
+        0xE7, 0x17, 0xA1, 0x51, 0x72, 0x82, 0x3D, 0xCD, 0xEE, 0x1E, 0xA8, 0x58, 0x7B, 0x8B, 0xB4,
+        0x44, 0x67, 0x97, 0x21, 0xD1, 0xF2, 0x02, 0xBD, 0x4D, 0x6E, 0x9E, 0x28, 0xD8, 0xFB, 0x0B,
+        0xC4, 0x34, 0x17, 0xE7, 0x51, 0xA1, 0x82, 0x72, 0xCD, 0x3D, 0x1E, 0xEE, 0x58, 0xA8, 0x8B,
+        0x7B,
+    },
+    {
+        0x00, 0x0F, 0x7D, 0x72, 0x88, 0x87, 0xF5, 0xFA, 0x40, 0x4F, 0x3D, 0x32, 0xC8, 0xC7, 0xB5,
+        0xBA, 0x90, 0x9F, 0xED, 0xE2, 0x18, 0x17, 0x65, 0x6A, 0xD0, 0xDF, 0xAD, 0xA2, 0x58, 0x57,
+        0x25, 0x2A, 0x02, 0x0D, 0x7F, 0x70, 0x8A, 0x85, 0xF7, 0xF8, 0x42, 0x4D, 0x3F, 0x30, 0xCA,
+        0xC5, 0xB7, 0xB8, 0x92, 0x9D, 0xEF, 0xE0, 0x1A, 0x15, 0x67, 0x68, 0xD2, 0xDD, 0xAF, 0xA0,
+        0x5A, 0x55, 0x27, 0x28, 0x14, 0x1B, 0x69, 0x66, 0x9C, 0x93, 0xE1, 0xEE, 0x54, 0x5B, 0x29,
+        0x26, 0xDC, 0xD3, 0xA1, 0xAE, 0x84, 0x8B, 0xF9, 0xF6, 0x0C, 0x03, 0x71, 0x7E, 0xC4, 0xCB,
+        0xB9, 0xB6, 0x4C, 0x43, 0x31, 0x3E, 0x16, 0x19, 0x6B, 0x64, 0x9E, 0x91, 0xE3, 0xEC, 0x56,
+        0x59, 0x2B, 0x24, 0xDE, 0xD1, 0xA3, 0xAC, 0x86, 0x89, 0xFB, 0xF4, 0x0E, 0x01, 0x73, 0x7C,
+        0xC6, 0xC9, 0xBB, 0xB4, 0x4E, 0x41, 0x33, 0x3C, 0x39, 0x36, 0x44, 0x4B, 0xB1, 0xBE, 0xCC,
+        0xC3, 0x79, 0x76, 0x04, 0x0B, 0xF1, 0xFE, 0x8C, 0x83, 0xA9, 0xA6, 0xD4, 0xDB, 0x21, 0x2E,
+        0x5C, 0x53, 0xE9, 0xE6, 0x94, 0x9B, 0x61, 0x6E, 0x1C, 0x13, 0x3B, 0x34, 0x46, 0x49, 0xB3,
+        0xBC, 0xCE, 0xC1, 0x7B, 0x74, 0x06, 0x09, 0xF3, 0xFC, 0x8E, 0x81, 0xAB, 0xA4, 0xD6, 0xD9,
+        0x23, 0x2C, 0x5E, 0x51, 0xEB, 0xE4, 0x96, 0x99, 0x63, 0x6C, 0x1E, 0x11, 0x2D, 0x22, 0x50,
+        0x5F, 0xA5, 0xAA, 0xD8, 0xD7, 0x6D, 0x62, 0x10, 0x1F, 0xE5, 0xEA, 0x98, 0x97, 0xBD, 0xB2,
+        0xC0, 0xCF, 0x35, 0x3A, 0x48, 0x47, 0xFD, 0xF2, 0x80, 0x8F, 0x75, 0x7A, 0x08, 0x07, 0x2F,
+        0x20, 0x52, 0x5D, 0xA7, 0xA8, 0xDA, 0xD5, 0x6F, 0x60, 0x12, 0x1D, 0xE7, 0xE8, 0x9A, 0x95,
+        0xBF, 0xB0, 0xC2, 0xCD, 0x37, 0x38, 0x4A, 0x45, 0xFF, 0xF0, 0x82, 0x8D, 0x77, 0x78, 0x0A,
+        0x05,
+    },
+};
+
+// Feedback bits of 8 steps for input byte, same layout as crypto1_feedback_table
+static const uint8_t crypto1_feedback_in_table[256] = {
+    0x00, 0x39, 0x91, 0xA8, 0x14, 0x2D, 0x85, 0xBC, 0x40, 0x79, 0xD1, 0xE8, 0x54, 0x6D, 0xC5, 0xFC,
+    0x02, 0x3B, 0x93, 0xAA, 0x16, 0x2F, 0x87, 0xBE, 0x42, 0x7B, 0xD3, 0xEA, 0x56, 0x6F, 0xC7, 0xFE,
+    0x20, 0x19, 0xB1, 0x88, 0x34, 0x0D, 0xA5, 0x9C, 0x60, 0x59, 0xF1, 0xC8, 0x74, 0x4D, 0xE5, 0xDC,
+    0x22, 0x1B, 0xB3, 0x8A, 0x36, 0x0F, 0xA7, 0x9E, 0x62, 0x5B, 0xF3, 0xCA, 0x76, 0x4F, 0xE7, 0xDE,
+    0x01, 0x38, 0x90, 0xA9, 0x15, 0x2C, 0x84, 0xBD, 0x41, 0x78, 0xD0, 0xE9, 0x55, 0x6C, 0xC4, 0xFD,
+    0x03, 0x3A, 0x92, 0xAB, 0x17, 0x2E, 0x86, 0xBF, 0x43, 0x7A, 0xD2, 0xEB, 0x57, 0x6E, 0xC6, 0xFF,
+    0x21, 0x18, 0xB0, 0x89, 0x35, 0x0C, 0xA4, 0x9D, 0x61, 0x58, 0xF0, 0xC9, 0x75, 0x4C, 0xE4, 0xDD,
+    0x23, 0x1A, 0xB2, 0x8B, 0x37, 0x0E, 0xA6, 0x9F, 0x63, 0x5A, 0xF2, 0xCB, 0x77, 0x4E, 0xE6, 0xDF,
+    0x10, 0x29, 0x81, 0xB8, 0x04, 0x3D, 0x95, 0xAC, 0x50, 0x69, 0xC1, 0xF8, 0x44, 0x7D, 0xD5, 0xEC,
+    0x12, 0x2B, 0x83, 0xBA, 0x06, 0x3F, 0x97, 0xAE, 0x52, 0x6B, 0xC3, 0xFA, 0x46, 0x7F, 0xD7, 0xEE,
+    0x30, 0x09, 0xA1, 0x98, 0x24, 0x1D, 0xB5, 0x8C, 0x70, 0x49, 0xE1, 0xD8, 0x64, 0x5D, 0xF5, 0xCC,
+    0x32, 0x0B, 0xA3, 0x9A, 0x26, 0x1F, 0xB7, 0x8E, 0x72, 0x4B, 0xE3, 0xDA, 0x66, 0x5F, 0xF7, 0xCE,
+    0x11, 0x28, 0x80, 0xB9, 0x05, 0x3C, 0x94, 0xAD, 0x51, 0x68, 0xC0, 0xF9, 0x45, 0x7C, 0xD4, 0xED,
+    0x13, 0x2A, 0x82, 0xBB, 0x07, 0x3E, 0x96, 0xAF, 0x53, 0x6A, 0xC2, 0xFB, 0x47, 0x7E, 0xD6, 0xEF,
+    0x31, 0x08, 0xA0, 0x99, 0x25, 0x1C, 0xB4, 0x8D, 0x71, 0x48, 0xE0, 0xD9, 0x65, 0x5C, 0xF4, 0xCD,
+    0x33, 0x0A, 0xA2, 0x9B, 0x27, 0x1E, 0xB6, 0x8F, 0x73, 0x4A, 0xE2, 0xDB, 0x67, 0x5E, 0xF6, 0xCF,
+};
+
+// First two filter stages for low and high byte of odd half
+static const uint8_t crypto1_filter_lo_table[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+};
+
+static const uint8_t crypto1_filter_hi_table[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+};
+
 Crypto1* crypto1_alloc(void) {
     Crypto1* instance = malloc(sizeof(Crypto1));
 
@@ -41,12 +225,9 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
     }
 }
 
-static uint32_t crypto1_filter(uint32_t in) {
-    uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+static inline uint32_t crypto1_filter(uint32_t in) {
+    uint32_t out = crypto1_filter_lo_table[in & 0xff];
+    out |= crypto1_filter_hi_table[in >> 8 & 0xff];
     out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
     return FURI_BIT(0xEC57E80A, out);
 }
@@ -64,11 +245,53 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     return out;
 }
 
+// 8 steps at once, same as 8 crypto1_bit() calls with is_encrypted = 0
+static inline uint8_t crypto1_byte_plain(Crypto1* crypto1, uint8_t in) {
+    const uint32_t odd = crypto1->odd;
+    const uint32_t even = crypto1->even;
+    uint8_t feed = crypto1_feedback_in_table[in];
+    feed ^= crypto1_feedback_table[0][odd & 0xff] ^ crypto1_feedback_table[1][odd >> 8 & 0xff] ^
+            crypto1_feedback_table[2][odd >> 16 & 0xff];
+    feed ^= crypto1_feedback_table[3][even & 0xff] ^ crypto1_feedback_table[4][even >> 8 & 0xff] ^
+            crypto1_feedback_table[5][even >> 16 & 0xff];
+    crypto1->odd = odd << 4 | feed >> 4;
+    crypto1->even = even << 4 | (feed & 0xf);
+
+    // Halves swap every step, so filter input alternates between them
+    uint8_t out = crypto1_filter(crypto1->odd >> 4);
+    out |= crypto1_filter(crypto1->even >> 3) << 1;
+    out |= crypto1_filter(crypto1->odd >> 3) << 2;
+    out |= crypto1_filter(crypto1->even >> 2) << 3;
+    out |= crypto1_filter(crypto1->odd >> 2) << 4;
+    out |= crypto1_filter(crypto1->even >> 1) << 5;
+    out |= crypto1_filter(crypto1->odd >> 1) << 6;
+    out |= crypto1_filter(crypto1->even) << 7;
+    return out;
+}
+
+// Encrypt byte and its parity bit, parity uses keystream bit following the byte
+static inline uint8_t crypto1_encrypt_byte(
+    Crypto1* crypto1,
+    uint8_t in,
+    uint8_t plain,
+    BitBuffer* out,
+    size_t index) {
+    uint8_t encrypted = crypto1_byte_plain(crypto1, in) ^ plain;
+    bool parity_bit = (crypto1_filter(crypto1->odd) ^ nfc_util_odd_parity8(plain)) & 0x01;
+    bit_buffer_set_byte_with_parity(out, index, encrypted, parity_bit);
+    return encrypted;
+}
+
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    if(is_encrypted) {
+        // Feedback depends on filter output, no shortcut here
+        for(uint8_t i = 0; i < 8; i++) {
+            out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+        }
+    } else {
+        out = crypto1_byte_plain(crypto1, in);
     }
     return out;
 }
@@ -76,8 +299,15 @@ uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    if(is_encrypted) {
+        for(uint8_t i = 0; i < 32; i++) {
+            out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+        }
+    } else {
+        // Bytes go from most significant, bits within byte from least significant
+        for(int8_t shift = 24; shift >= 0; shift -= 8) {
+            out |= (uint32_t)crypto1_byte_plain(crypto1, in >> shift) << shift;
+        }
     }
     return out;
 }
@@ -108,7 +338,7 @@ void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
         bit_buffer_set_byte(out, 0, decrypted_byte);
     } else {
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t decrypted_byte = crypto1_byte(crypto, 0, 0) ^ encrypted_data[i];
+            uint8_t decrypted_byte = crypto1_byte_plain(crypto, 0) ^ encrypted_data[i];
             bit_buffer_set_byte(out, i, decrypted_byte);
         }
     }
@@ -130,11 +360,7 @@ void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff,
         bit_buffer_set_byte(out, 0, encrypted_byte);
     } else {
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t encrypted_byte = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
-                                     plain_data[i];
-            bool parity_bit =
-                ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01);
-            bit_buffer_set_byte_with_parity(out, i, encrypted_byte, parity_bit);
+            crypto1_encrypt_byte(crypto, keystream ? keystream[i] : 0, plain_data[i], out, i);
         }
     }
 }
@@ -163,17 +389,12 @@ void crypto1_encrypt_reader_nonce(
     }
 
     for(size_t i = 0; i < 4; i++) {
-        uint8_t byte = crypto1_byte(crypto, nr[i], 0) ^ nr[i];
-        bool parity_bit = ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nr[i])) & 0x01);
-        bit_buffer_set_byte_with_parity(out, i, byte, parity_bit);
-        nr[i] = byte;
+        nr[i] = crypto1_encrypt_byte(crypto, nr[i], nr[i], out, i);
     }
 
     nt_num = prng_successor(nt_num, 32);
     for(size_t i = 4; i < 8; i++) {
         nt_num = prng_successor(nt_num, 8);
-        uint8_t byte = crypto1_byte(crypto, 0, 0) ^ (uint8_t)(nt_num);
-        bool parity_bit = ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nt_num)) & 0x01);
-        bit_buffer_set_byte_with_parity(out, i, byte, parity_bit);
+        crypto1_encrypt_byte(crypto, 0, nt_num, out, i);
     }
 }
@@ -0,0 +1,531 @@
+#include "mfkey32.h"
+#include "crypto1.h"
+
+#include <lib/nfc/helpers/nfc_util.h>
+#include <furi.h>
+
+// Algorithm from https://github.com/RfidResearchGroup/proxmark3.git
+
+#define TAG "Mfkey32"
+
+#define LF_POLY_ODD (0x29CE5C)
+#define LF_POLY_EVEN (0x870804)
+
+#define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
+
+// Keystream bits of each half, first one selects seeds, the rest extend states by one bit
+#define MFKEY32_KEYSTREAM_BITS 16
+// Bits after which states of both halves are matched by contribution byte
+#define MFKEY32_SEED_BITS 9
+#define MFKEY32_SIMPLE_BITS 5
+#define MFKEY32_MATCH_BITS 4
+
+#define MFKEY32_SEED_COUNT (1UL << 20)
+#define MFKEY32_SEED_STATES 256
+#define MFKEY32_SEEDS_PER_CHECK 4096
+#define MFKEY32_MSB_COUNT 256
+// Average states of one half per contribution byte
+#define MFKEY32_STATES_PER_MSB 2048
+// Room for states added while extending the last matched groups of a round
+#define MFKEY32_POOL_SLACK 1024
+
+typedef enum {
+    Mfkey32StageIdle,
+    Mfkey32StageScan,
+    Mfkey32StageMatch,
+    Mfkey32StageDone,
+} Mfkey32Stage;
+
+typedef enum {
+    Mfkey32ResultContinue,
+    Mfkey32ResultFound,
+    Mfkey32ResultOverflow,
+} Mfkey32Result;
+
+struct Mfkey32 {
+    Mfkey32Nonces nonces;
+    uint32_t oks;
+    uint32_t eks;
+    uint64_t key;
+    Mfkey32Stage stage;
+    Mfkey32Status status;
+
+    // Round covers contribution bytes from msb to msb + msb_step
+    uint16_t msb;
+    uint16_t msb_step;
+    uint16_t msb_step_max;
+    uint32_t seed;
+
+    uint32_t* odd;
+    uint32_t* even;
+    size_t capacity;
+    size_t odd_size;
+    size_t even_size;
+    size_t odd_end;
+    size_t even_end;
+
+    uint32_t bucket_next[MFKEY32_MSB_COUNT];
+    uint32_t bucket_end[MFKEY32_MSB_COUNT];
+    uint32_t states[MFKEY32_SEED_STATES];
+};
+
+// Filter input bits 4-19, state and its extension only differ in the lowest nibble
+static inline uint32_t mfkey32_filter_high(uint32_t in) {
+    uint32_t out = 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return out;
+}
+
+static inline uint32_t mfkey32_filter_low(uint32_t high, uint32_t in) {
+    return FURI_BIT(0xEC57E80A, high | (0xf22c0 >> (in & 0xf) & 16));
+}
+
+static inline uint32_t mfkey32_filter(uint32_t in) {
+    return mfkey32_filter_low(mfkey32_filter_high(in), in);
+}
+
+// Keep feedback contribution of the other half in the most significant byte
+static inline uint32_t mfkey32_contribution(uint32_t state, uint32_t mask1, uint32_t mask2) {
+    uint32_t contribution = state >> 25;
+    contribution = contribution << 1 | nfc_util_even_parity32(state & mask1);
+    contribution = contribution << 1 | nfc_util_even_parity32(state & mask2);
+    return contribution << 24 | (state & 0xffffff);
+}
+
+// Extend states by one bit matching keystream, returns false if states don't fit
+static bool mfkey32_extend(
+    uint32_t* states,
+    size_t* size,
+    size_t capacity,
+    uint32_t bit,
+    uint32_t mask1,
+    uint32_t mask2) {
+    size_t end = *size;
+    size_t i = 0;
+    while(i < end) {
+        uint32_t state = states[i] << 1;
+        uint32_t high = mfkey32_filter_high(state);
+        uint32_t out = mfkey32_filter_low(high, state);
+        if(out != mfkey32_filter_low(high, state | 1)) {
+            // Exactly one extension matches
+            state |= out ^ bit;
+            states[i++] = mask1 ? mfkey32_contribution(state, mask1, mask2) : state;
+        } else if(out == bit) {
+            // Both extensions match, next state goes to the end to make room
+            if(end == capacity) return false;
+            states[end++] = states[i + 1];
+            states[i++] = mask1 ? mfkey32_contribution(state, mask1, mask2) : state;
+            states[i++] = mask1 ? mfkey32_contribution(state | 1, mask1, mask2) : state | 1;
+        } else {
+            states[i] = states[--end];
+        }
+    }
+    *size = end;
+    return true;
+}
+
+// In place radix sort by contribution byte
+static void mfkey32_sort(Mfkey32* instance, uint32_t* states, size_t size) {
+    uint32_t* next = instance->bucket_next;
+    uint32_t* end = instance->bucket_end;
+    memset(end, 0, sizeof(instance->bucket_end));
+    for(size_t i = 0; i < size; i++) {
+        end[states[i] >> 24]++;
+    }
+    uint32_t offset = 0;
+    for(size_t bucket = 0; bucket < MFKEY32_MSB_COUNT; bucket++) {
+        next[bucket] = offset;
+        offset += end[bucket];
+        end[bucket] = offset;
+    }
+    for(size_t bucket = 0; bucket < MFKEY32_MSB_COUNT; bucket++) {
+        while(next[bucket] < end[bucket]) {
+            // Swap states into their buckets until one for this bucket comes back
+            uint32_t state = states[next[bucket]];
+            while(state >> 24 != bucket) {
+                uint32_t target = state >> 24;
+                FURI_SWAP(state, states[next[target]]);
+                next[target]++;
+            }
+            states[next[bucket]++] = state;
+        }
+    }
+}
+
+// Find last groups with the same contribution byte before odd_end and even_end in sorted lists
+static bool mfkey32_prev_group(
+    const uint32_t* odd,
+    size_t* odd_start,
+    size_t* odd_end,
+    const uint32_t* even,
+    size_t* even_start,
+    size_t* even_end) {
+    size_t odd_index = *odd_end;
+    size_t even_index = *even_end;
+    while(odd_index && even_index) {
+        uint32_t odd_msb = odd[odd_index - 1] >> 24;
+        uint32_t even_msb = even[even_index - 1] >> 24;
+        *odd_end = odd_index;
+        *even_end = even_index;
+        if(odd_msb >= even_msb) {
+            while(odd_index && odd[odd_index - 1] >> 24 == odd_msb) {
+                odd_index--;
+            }
+        }
+        if(even_msb >= odd_msb) {
+            while(even_index && even[even_index - 1] >> 24 == even_msb) {
+                even_index--;
+            }
+        }
+        if(odd_msb == even_msb) {
+            *odd_start = odd_index;
+            *even_start = even_index;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void mfkey32_rollback_word(Crypto1* crypto, uint32_t in, bool is_encrypted) {
+    for(int8_t i = 31; i >= 0; i--) {
+        crypto->odd &= 0xffffff;
+        FURI_SWAP(crypto->odd, crypto->even);
+        uint32_t out = crypto->even & 1;
+        crypto->even >>= 1;
+        out ^= LF_POLY_EVEN & crypto->even;
+        out ^= LF_POLY_ODD & crypto->odd;
+        out ^= BEBIT(in, i);
+        out ^= mfkey32_filter(crypto->odd) & is_encrypted;
+        crypto->even |= (uint32_t)nfc_util_even_parity32(out) << 23;
+    }
+}
+
+static uint64_t mfkey32_lfsr_key(const Crypto1* crypto) {
+    uint64_t key = 0;
+    for(int8_t i = 23; i >= 0; i--) {
+        key = key << 1 | FURI_BIT(crypto->odd, i ^ 3);
+        key = key << 1 | FURI_BIT(crypto->even, i ^ 3);
+    }
+    return key;
+}
+
+// Combine halves into full states, roll them back to the key and check second authentication
+static Mfkey32Result mfkey32_check(
+    Mfkey32* instance,
+    const uint32_t* odd,
+    size_t odd_size,
+    const uint32_t* even,
+    size_t even_size) {
+    const Mfkey32Nonces* nonces = &instance->nonces;
+    const uint32_t answer = prng_successor(nonces->nt1, 64);
+    for(size_t i = 0; i < even_size; i++) {
+        uint32_t even_state = even[i] << 1 ^ nfc_util_even_parity32(even[i] & LF_POLY_EVEN);
+        for(size_t j = 0; j < odd_size; j++) {
+            Crypto1 crypto = {
+                .odd = even_state ^ nfc_util_even_parity32(odd[j] & LF_POLY_ODD),
+                .even = odd[j],
+            };
+            mfkey32_rollback_word(&crypto, 0, false);
+            mfkey32_rollback_word(&crypto, nonces->nr0, true);
+            mfkey32_rollback_word(&crypto, nonces->cuid ^ nonces->nt0, false);
+            uint64_t key = mfkey32_lfsr_key(&crypto);
+
+            crypto1_init(&crypto, key);
+            crypto1_word(&crypto, nonces->cuid ^ nonces->nt1, 0);
+            crypto1_word(&crypto, nonces->nr1, 1);
+            if((crypto1_word(&crypto, 0, 0) ^ answer) == nonces->ar1) {
+                instance->key = key;
+                return Mfkey32ResultFound;
+            }
+        }
+    }
+    return Mfkey32ResultContinue;
+}
+
+static Mfkey32Result mfkey32_recover(
+    Mfkey32* instance,
+    uint32_t* odd,
+    size_t odd_size,
+    size_t odd_capacity,
+    uint32_t* even,
+    size_t even_size,
+    size_t even_capacity,
+    uint8_t bit) {
+    if(bit == MFKEY32_KEYSTREAM_BITS) {
+        return mfkey32_check(instance, odd, odd_size, even, even_size);
+    }
+
+    for(uint8_t i = 0; i < MFKEY32_MATCH_BITS && bit < MFKEY32_KEYSTREAM_BITS; i++, bit++) {
+        if(!mfkey32_extend(
+               odd,
+               &odd_size,
+               odd_capacity,
+               FURI_BIT(instance->oks, bit),
+               LF_POLY_EVEN << 1 | 1,
+               LF_POLY_ODD << 1)) {
+            return Mfkey32ResultOverflow;
+        }
+        if(!mfkey32_extend(
+               even,
+               &even_size,
+               even_capacity,
+               FURI_BIT(instance->eks, bit),
+               LF_POLY_ODD,
+               LF_POLY_EVEN << 1 | 1)) {
+            return Mfkey32ResultOverflow;
+        }
+        if(!odd_size || !even_size) return Mfkey32ResultContinue;
+    }
+
+    mfkey32_sort(instance, odd, odd_size);
+    mfkey32_sort(instance, even, even_size);
+
+    // Last groups first, so extended groups only overwrite already processed ones
+    size_t odd_start, even_start;
+    while(mfkey32_prev_group(odd, &odd_start, &odd_size, even, &even_start, &even_size)) {
+        Mfkey32Result result = mfkey32_recover(
+            instance,
+            odd + odd_start,
+            odd_size - odd_start,
+            odd_capacity - odd_start,
+            even + even_start,
+            even_size - even_start,
+            even_capacity - even_start,
+            bit);
+        if(result != Mfkey32ResultContinue) return result;
+        odd_size = odd_start;
+        even_size = even_start;
+    }
+
+    return Mfkey32ResultContinue;
+}
+
+// Extend seed to all states matching first keystream bits, keep ones in round range
+static bool mfkey32_scan_seed(
+    Mfkey32* instance,
+    uint32_t seed,
+    uint32_t keystream,
+    uint32_t mask1,
+    uint32_t mask2,
+    uint32_t* pool,
+    size_t* pool_size) {
+    uint32_t* states = instance->states;
+    size_t size = 1;
+    states[0] = seed;
+    for(uint8_t bit = 1; bit < MFKEY32_SEED_BITS && size; bit++) {
+        if(bit < MFKEY32_SIMPLE_BITS) {
+            mfkey32_extend(states, &size, MFKEY32_SEED_STATES, FURI_BIT(keystream, bit), 0, 0);
+            continue;
+        }
+        mfkey32_extend(
+            states, &size, MFKEY32_SEED_STATES, FURI_BIT(keystream, bit), mask1, mask2);
+
+        // Every extension adds two contribution bits, drop states already out of round range
+        uint8_t shift = (MFKEY32_SEED_BITS - 1 - bit) * 2;
+        uint32_t first = instance->msb >> shift;
+        uint32_t last = (instance->msb + instance->msb_step - 1) >> shift;
+        size_t i = 0;
+        while(i < size) {
+            uint32_t prefix = states[i] >> 24 & 0xff >> shift;
+            if(prefix < first || prefix > last) {
+                states[i] = states[--size];
+            } else {
+                i++;
+            }
+        }
+    }
+
+    if(*pool_size + size > instance->capacity - MFKEY32_POOL_SLACK) return false;
+    memcpy(pool + *pool_size, states, size * sizeof(uint32_t));
+    *pool_size += size;
+    return true;
+}
+
+static void mfkey32_start_round(Mfkey32* instance) {
+    instance->stage = Mfkey32StageScan;
+    instance->seed = 0;
+    instance->odd_size = 0;
+    instance->even_size = 0;
+}
+
+static void mfkey32_retry_round(Mfkey32* instance) {
+    if(instance->msb_step > 1) {
+        instance->msb_step /= 2;
+        FURI_LOG_D(TAG, "Retry msb %u step %u", instance->msb, instance->msb_step);
+    } else {
+        FURI_LOG_W(TAG, "Msb %u doesn't fit, skipped", instance->msb);
+        instance->msb++;
+    }
+    mfkey32_start_round(instance);
+}
+
+static void mfkey32_next_round(Mfkey32* instance) {
+    instance->msb += instance->msb_step;
+    if(instance->msb >= MFKEY32_MSB_COUNT) {
+        instance->stage = Mfkey32StageDone;
+        instance->status = Mfkey32StatusKeyNotFound;
+    } else {
+        // Go back to bigger rounds after retry with smaller ones
+        instance->msb_step = MIN(instance->msb_step_max, MFKEY32_MSB_COUNT - instance->msb);
+        mfkey32_start_round(instance);
+    }
+}
+
+static void mfkey32_scan(Mfkey32* instance) {
+    uint32_t seed_end = MIN(instance->seed + MFKEY32_SEEDS_PER_CHECK, MFKEY32_SEED_COUNT);
+    uint32_t high = 0;
+    for(uint32_t seed = instance->seed; seed < seed_end; seed++) {
+        if((seed & 0xf) == 0) high = mfkey32_filter_high(seed);
+        uint32_t out = mfkey32_filter_low(high, seed);
+        if(out == (instance->oks & 1) &&
+           !mfkey32_scan_seed(
+               instance,
+               seed,
+               instance->oks,
+               LF_POLY_EVEN << 1 | 1,
+               LF_POLY_ODD << 1,
+               instance->odd,
+               &instance->odd_size)) {
+            mfkey32_retry_round(instance);
+            return;
+        }
+        if(out == (instance->eks & 1) &&
+           !mfkey32_scan_seed(
+               instance,
+               seed,
+               instance->eks,
+               LF_POLY_ODD,
+               LF_POLY_EVEN << 1 | 1,
+               instance->even,
+               &instance->even_size)) {
+            mfkey32_retry_round(instance);
+            return;
+        }
+    }
+    instance->seed = seed_end;
+
+    if(instance->seed == MFKEY32_SEED_COUNT) {
+        mfkey32_sort(instance, instance->odd, instance->odd_size);
+        mfkey32_sort(instance, instance->even, instance->even_size);
+        instance->odd_end = instance->odd_size;
+        instance->even_end = instance->even_size;
+        instance->stage = Mfkey32StageMatch;
+    }
+}
+
+static void mfkey32_match(Mfkey32* instance) {
+    size_t odd_start, even_start;
+    if(!mfkey32_prev_group(
+           instance->odd,
+           &odd_start,
+           &instance->odd_end,
+           instance->even,
+           &even_start,
+           &instance->even_end)) {
+        mfkey32_next_round(instance);
+        return;
+    }
+
+    Mfkey32Result result = mfkey32_recover(
+        instance,
+        instance->odd + odd_start,
+        instance->odd_end - odd_start,
+        instance->capacity - odd_start,
+        instance->even + even_start,
+        instance->even_end - even_start,
+        instance->capacity - even_start,
+        MFKEY32_SEED_BITS);
+    instance->odd_end = odd_start;
+    instance->even_end = even_start;
+
+    if(result == Mfkey32ResultFound) {
+        instance->stage = Mfkey32StageDone;
+        instance->status = Mfkey32StatusKeyFound;
+    } else if(result == Mfkey32ResultOverflow) {
+        mfkey32_retry_round(instance);
+    }
+}
+
+Mfkey32* mfkey32_alloc(size_t memory_limit) {
+    Mfkey32* instance = malloc(sizeof(Mfkey32));
+
+    // Both halves share the rest equally
+    size_t capacity = (memory_limit - MIN(memory_limit, sizeof(Mfkey32))) / sizeof(uint32_t) / 2;
+    furi_check(capacity >= MFKEY32_STATES_PER_MSB * 5 / 4 + MFKEY32_POOL_SLACK);
+    instance->capacity = capacity;
+    instance->odd = malloc(capacity * sizeof(uint32_t));
+    instance->even = malloc(capacity * sizeof(uint32_t));
+
+    // Leave a quarter for uneven distribution of states
+    instance->msb_step_max =
+        MIN((capacity - MFKEY32_POOL_SLACK) / (MFKEY32_STATES_PER_MSB * 5 / 4),
+            (size_t)MFKEY32_MSB_COUNT);
+
+    return instance;
+}
+
+void mfkey32_free(Mfkey32* instance) {
+    furi_check(instance);
+
+    free(instance->odd);
+    free(instance->even);
+    free(instance);
+}
+
+void mfkey32_start(Mfkey32* instance, const Mfkey32Nonces* nonces) {
+    furi_check(instance);
+    furi_check(nonces);
+
+    instance->nonces = *nonces;
+    instance->key = 0;
+    instance->status = Mfkey32StatusInProgress;
+
+    // Split keystream of the first reader answer between halves
+    uint32_t keystream = nonces->ar0 ^ prng_successor(nonces->nt0, 64);
+    instance->oks = 0;
+    instance->eks = 0;
+    for(int8_t i = 31; i >= 0; i -= 2) {
+        instance->oks = instance->oks << 1 | BEBIT(keystream, i);
+        instance->eks = instance->eks << 1 | BEBIT(keystream, i - 1);
+    }
+
+    instance->msb = 0;
+    instance->msb_step = instance->msb_step_max;
+    mfkey32_start_round(instance);
+}
+
+Mfkey32Status mfkey32_run(Mfkey32* instance, uint32_t time_slice_ms) {
+    furi_check(instance);
+    furi_check(instance->stage != Mfkey32StageIdle);
+
+    uint32_t start = furi_get_tick();
+    while(instance->stage != Mfkey32StageDone &&
+          furi_get_tick() - start < furi_ms_to_ticks(time_slice_ms)) {
+        if(instance->stage == Mfkey32StageScan) {
+            mfkey32_scan(instance);
+        } else {
+            mfkey32_match(instance);
+        }
+    }
+
+    return instance->status;
+}
+
+uint8_t mfkey32_get_progress(const Mfkey32* instance) {
+    furi_check(instance);
+
+    if(instance->stage == Mfkey32StageDone) return 100;
+    uint64_t done = (uint64_t)instance->msb * MFKEY32_SEED_COUNT +
+                    (uint64_t)instance->msb_step * instance->seed;
+    return done * 100 / ((uint64_t)MFKEY32_MSB_COUNT * MFKEY32_SEED_COUNT);
+}
+
+bool mfkey32_get_key(const Mfkey32* instance, uint64_t* key) {
+    furi_check(instance);
+    furi_check(key);
+
+    *key = instance->key;
+    return instance->status == Mfkey32StatusKeyFound;
+}
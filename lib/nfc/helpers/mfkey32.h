@@ -0,0 +1,88 @@
+/**
+ * @file mfkey32.h
+ * MIFARE Classic key recovery from two reader authentications (mfkey32)
+ *
+ * Keystream of the reader answer gives all cipher states that could produce it,
+ * states are rolled back to the key and checked against the second authentication.
+ * Candidate states are processed in rounds, each covering a part of the search space,
+ * so memory is fixed at allocation time. Work is done in time slices, so recovery
+ * can run in a background thread and report progress.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Memory needed to run recovery with the smallest rounds */
+#define MFKEY32_MEMORY_MIN (32 * 1024)
+
+typedef struct Mfkey32 Mfkey32;
+
+/** Two authentications of a reader with the same key */
+typedef struct {
+    uint32_t cuid; /**< Card UID, last 4 bytes */
+    uint32_t nt0; /**< Card nonce of the first authentication */
+    uint32_t nr0; /**< Encrypted reader nonce of the first authentication */
+    uint32_t ar0; /**< Encrypted reader answer of the first authentication */
+    uint32_t nt1; /**< Card nonce of the second authentication */
+    uint32_t nr1; /**< Encrypted reader nonce of the second authentication */
+    uint32_t ar1; /**< Encrypted reader answer of the second authentication */
+} Mfkey32Nonces;
+
+typedef enum {
+    Mfkey32StatusInProgress,
+    Mfkey32StatusKeyFound,
+    Mfkey32StatusKeyNotFound,
+} Mfkey32Status;
+
+/**
+ * @brief Allocate key recovery instance
+ * @param memory_limit Heap size to use, at least MFKEY32_MEMORY_MIN, more memory means less rounds
+ * @return Mfkey32 instance
+ */
+Mfkey32* mfkey32_alloc(size_t memory_limit);
+
+/**
+ * @brief Free key recovery instance
+ * @param instance Mfkey32 instance
+ */
+void mfkey32_free(Mfkey32* instance);
+
+/**
+ * @brief Start key recovery, stops previous recovery if any
+ * @param instance Mfkey32 instance
+ * @param nonces Authentications to recover key from
+ */
+void mfkey32_start(Mfkey32* instance, const Mfkey32Nonces* nonces);
+
+/**
+ * @brief Continue key recovery for given time
+ * @param instance Mfkey32 instance
+ * @param time_slice_ms Time to run for, recovery may run a bit longer
+ * @return Mfkey32StatusInProgress until key is found or search space is exhausted
+ */
+Mfkey32Status mfkey32_run(Mfkey32* instance, uint32_t time_slice_ms);
+
+/**
+ * @brief Get recovery progress
+ * @param instance Mfkey32 instance
+ * @return Progress in percent
+ */
+uint8_t mfkey32_get_progress(const Mfkey32* instance);
+
+/**
+ * @brief Get recovered key
+ * @param instance Mfkey32 instance
+ * @param key Recovered key, as used by crypto1_init()
+ * @return true if key was found
+ */
+bool mfkey32_get_key(const Mfkey32* instance, uint64_t* key);
+
+#ifdef __cplusplus
+}
+#endif
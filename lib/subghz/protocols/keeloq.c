@@ -774,6 +774,45 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+#define KEELOQ_MF_CACHE_FLAG_CENTURION (1u << 0)
+
+static inline bool subghz_protocol_keeloq_check_man(
+    SubGhzBlockGeneric* instance,
+    uint32_t hop,
+    uint64_t man,
+    uint8_t btn,
+    uint16_t end_serial,
+    uint8_t flags) {
+    uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+    if(flags & KEELOQ_MF_CACHE_FLAG_CENTURION) {
+        return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+    } else {
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    }
+}
+
+/** 
+ * Apply found manufacture key and remember it for this serial
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param found Resolved serial to manufacture key binding
+ * @param manufacture_name 
+ * @return always 1
+ */
+static uint8_t subghz_protocol_keeloq_mf_found(
+    SubGhzKeystore* keystore,
+    const SubGhzKeystoreMfCacheItem* found,
+    const char** manufacture_name) {
+    const SubGhzKey* manufacture_code =
+        SubGhzKeyArray_cget(*subghz_keystore_get_data(keystore), found->key_index);
+    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+    keystore->mfname = *manufacture_name;
+    if(found->kl_type) {
+        keystore->kl_type = found->kl_type;
+    }
+    subghz_keystore_mf_cache_put(keystore, found);
+    return 1;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -795,8 +834,6 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -810,186 +847,102 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
+
+    SubGhzKeyArray_t* manufacture_codes = subghz_keystore_get_data(keystore);
+    SubGhzKeystoreMfCacheItem found = {.serial = fix & 0x0FFFFFFF};
+
+    // Repeated parcels of the same remote: derived key is already known, single decrypt
+    const SubGhzKeystoreMfCacheItem* cached = subghz_keystore_mf_cache_get(keystore, found.serial);
+    if(cached) {
+        const SubGhzKey* manufacture_code =
+            SubGhzKeyArray_cget(*manufacture_codes, cached->key_index);
+        if((mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) &&
+           subghz_protocol_keeloq_check_man(
+               instance, hop, cached->man, btn, end_serial, cached->flags)) {
+            return subghz_protocol_keeloq_mf_found(keystore, cached, manufacture_name);
+        }
+    }
+
+    for(size_t i = 0; i < SubGhzKeyArray_size(*manufacture_codes); i++) {
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(*manufacture_codes, i);
+        if(!mf_not_set && (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) != 0)) {
+            continue;
+        }
+
+        found.key_index = i;
+        found.kl_type = 0;
+        found.flags = 0;
+
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            // Simple Learning
+            found.man = manufacture_code->key;
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            // Normal Learning
+            // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+            found.man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+            if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
+                found.flags = KEELOQ_MF_CACHE_FLAG_CENTURION;
+            }
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            found.man = subghz_protocol_keeloq_common_secure_learning(
+                fix, instance->seed, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+            found.man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                fix, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+            found.man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+                fix, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+            found.man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
+                fix, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+            found.man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
+                fix, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            // Try simple, normal, secure and magic xor type1 learning,
+            // each with the key as is and with the mirrored key
+            for(uint8_t step = 0; step < 8; step++) {
+                uint64_t key = (step & 1) ? subghz_keystore_get_key_mirrored(keystore, i) :
+                                            manufacture_code->key;
+                found.kl_type = KEELOQ_LEARNING_SIMPLE + step / 2;
+                switch(found.kl_type) {
                 case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
+                    found.man = key;
                     break;
                 case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
+                    found.man = subghz_protocol_keeloq_common_normal_learning(fix, key);
                     break;
                 case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
+                    found.man =
+                        subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, key);
                     break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
+                default:
+                    found.man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
                     break;
                 }
+                if(subghz_protocol_keeloq_check_man(
+                       instance, hop, found.man, btn, end_serial, found.flags)) {
+                    return subghz_protocol_keeloq_mf_found(keystore, &found, manufacture_name);
+                }
             }
+            continue;
+        default:
+            continue;
+        }
+
+        if(subghz_protocol_keeloq_check_man(
+               instance, hop, found.man, btn, end_serial, found.flags)) {
+            return subghz_protocol_keeloq_mf_found(keystore, &found, manufacture_name);
         }
+    }
 
     // MF not found
     *manufacture_name = "Unknown";
@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_bin.h"
 
 #include "../blocks/const.h"
 #include "../blocks/generic.h"
@@ -30,6 +31,8 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+    bool binary;
+    uint8_t* binary_buffer;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -158,6 +161,9 @@ bool subghz_protocol_raw_save_to_file_init(
         }
 
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
+        if(instance->binary) {
+            instance->binary_buffer = malloc(SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX);
+        }
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
         instance->last_level = false;
@@ -175,9 +181,19 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
-            FURI_LOG_E(TAG, "Unable to add RAW_Data");
+        bool is_added = false;
+        if(instance->binary) {
+            is_added = subghz_raw_bin_write_block(
+                flipper_format_get_raw_stream(instance->flipper_file),
+                instance->upload_raw,
+                instance->ind_write,
+                instance->binary_buffer);
+        } else {
+            is_added = flipper_format_write_int32(
+                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write);
+        }
+        if(!is_added) {
+            FURI_LOG_E(TAG, "Unable to add RAW data");
         } else {
             instance->sample_write += instance->ind_write;
             instance->ind_write = 0;
@@ -195,6 +211,8 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
+        free(instance->binary_buffer);
+        instance->binary_buffer = NULL;
         flipper_format_file_close(instance->flipper_file);
         flipper_format_free(instance->flipper_file);
         furi_record_close(RECORD_STORAGE);
@@ -211,6 +229,13 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary) {
+    furi_check(instance);
+    furi_check(instance->file_is_open == RAWFileIsOpenClose);
+
+    instance->binary = binary;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     furi_check(instance);
     return instance->sample_write + instance->ind_write;
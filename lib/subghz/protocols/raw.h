@@ -29,6 +29,14 @@ bool subghz_protocol_raw_save_to_file_init(
     const char* dev_name,
     SubGhzRadioPreset* preset);
 
+/**
+ * Select RAW data representation for the next file written
+ * Binary RAW_Bin blocks are several times smaller and faster to replay than RAW_Data lines.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param binary true to write RAW_Bin blocks, false to write RAW_Data lines
+ */
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary);
+
 /**
  * Stop writing file to flash
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
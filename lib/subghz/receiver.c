@@ -11,8 +11,18 @@ typedef struct {
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
+/** Decoder that passed receiver filters, resolved once per filter change */
+typedef struct {
+    SubGhzDecoderFeed feed;
+    void* decoder;
+} SubGhzReceiverActiveDecoder;
+
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
+    // Filters can be changed from another thread while the worker decodes
+    FuriMutex* active_mutex;
+    SubGhzReceiverActiveDecoder* active;
+    size_t active_count;
     SubGhzProtocolFlag filter;
     SubGhzProtocolFilter ignore_filter;
 
@@ -36,11 +46,32 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         }
     }
 
+    instance->active = malloc(
+        SubGhzReceiverSlotArray_size(instance->slots) * sizeof(SubGhzReceiverActiveDecoder));
+    instance->active_count = 0;
+    instance->active_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
 }
 
+static void subghz_receiver_update_active(SubGhzReceiver* instance) {
+    furi_check(furi_mutex_acquire(instance->active_mutex, FuriWaitForever) == FuriStatusOk);
+    instance->active_count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            const SubGhzProtocol* protocol = slot->base->protocol;
+            if((protocol->flag & instance->filter) != 0 &&
+               (protocol->filter & instance->ignore_filter) == 0) {
+                SubGhzReceiverActiveDecoder* active = &instance->active[instance->active_count++];
+                active->feed = protocol->decoder->feed;
+                active->decoder = slot->base;
+            }
+        }
+    furi_check(furi_mutex_release(instance->active_mutex) == FuriStatusOk);
+}
+
 void subghz_receiver_free(SubGhzReceiver* instance) {
     furi_check(instance);
 
@@ -54,6 +85,8 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
             slot->base = NULL;
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
+    free(instance->active);
+    furi_mutex_free(instance->active_mutex);
 
     free(instance);
 }
@@ -62,13 +95,32 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
     furi_check(instance);
     furi_check(instance->slots);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0 &&
-               (slot->base->protocol->filter & instance->ignore_filter) == 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
+    // Hot path: called for every edge, filters are already applied
+    furi_check(furi_mutex_acquire(instance->active_mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzReceiverActiveDecoder* active = instance->active;
+    for(size_t i = 0; i < instance->active_count; i++) {
+        active[i].feed(active[i].decoder, level, duration);
+    }
+    furi_check(furi_mutex_release(instance->active_mutex) == FuriStatusOk);
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_durations,
+    size_t count) {
+    furi_check(instance);
+    furi_check(level_durations);
+
+    furi_check(furi_mutex_acquire(instance->active_mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzReceiverActiveDecoder* active = instance->active;
+    for(size_t i = 0; i < count; i++) {
+        bool level = level_duration_get_level(level_durations[i]);
+        uint32_t duration = level_duration_get_duration(level_durations[i]);
+        for(size_t j = 0; j < instance->active_count; j++) {
+            active[j].feed(active[j].decoder, level, duration);
         }
+    }
+    furi_check(furi_mutex_release(instance->active_mutex) == FuriStatusOk);
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -107,6 +159,7 @@ void subghz_receiver_set_rx_callback(
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_check(instance);
     instance->filter = filter;
+    subghz_receiver_update_active(instance);
 }
 
 void subghz_receiver_set_ignore_filter(
@@ -114,6 +167,7 @@ void subghz_receiver_set_ignore_filter(
     SubGhzProtocolFilter ignore_filter) {
     furi_assert(instance);
     instance->ignore_filter = ignore_filter;
+    subghz_receiver_update_active(instance);
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
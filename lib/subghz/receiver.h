@@ -35,6 +35,18 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a block of raw levels and durations received from the air.
+ * Equal to calling subghz_receiver_decode for each element, in order.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param level_durations Array of signal levels and durations
+ * @param count Number of elements in array
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_durations,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -4,6 +4,7 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
+#include "subghz_raw_bin.h"
 
 #define TAG "SubGhzFileEncoderWorker"
 
@@ -21,6 +22,8 @@ struct SubGhzFileEncoderWorker {
     bool is_storage_slow;
     FuriString* str_data;
     FuriString* file_path;
+    int32_t* bin_samples;
+    uint8_t* bin_buffer;
     const SubGhzDevice* device;
 
     SubGhzFileEncoderWorkerCallbackEnd callback_end;
@@ -81,6 +84,33 @@ bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, co
     return res;
 }
 
+static bool subghz_file_encoder_worker_bin_parse(
+    SubGhzFileEncoderWorker* instance,
+    Stream* stream,
+    size_t count,
+    size_t size) {
+    if(!instance->bin_samples) {
+        instance->bin_samples = malloc(SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX * sizeof(int32_t));
+        instance->bin_buffer = malloc(SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX + 1);
+    }
+    if(!subghz_raw_bin_read_block(
+           stream, instance->bin_samples, count, size, instance->bin_buffer)) {
+        return false;
+    }
+    // Same overflow rule as for text data
+    for(size_t i = 0; i < count; i++) {
+        int32_t sample = instance->bin_samples[i];
+        if((sample < -1000000) || (sample > 1000000)) {
+            instance->bin_samples[i] = (sample > 0) ? 100 : -100;
+        }
+    }
+    // Block is decoded at once, push it in one go as well
+    size_t ret = furi_stream_buffer_send(
+        instance->stream, instance->bin_samples, count * sizeof(int32_t), 100);
+    if(count * sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
+    return true;
+}
+
 void subghz_file_encoder_worker_get_text_progress(
     SubGhzFileEncoderWorker* instance,
     FuriString* output) {
@@ -153,8 +183,18 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
             if(stream_read_line(stream, instance->str_data)) {
                 furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
+                size_t bin_count = 0;
+                size_t bin_size = 0;
+                if(subghz_raw_bin_parse_header(
+                       furi_string_get_cstr(instance->str_data), &bin_count, &bin_size)) {
+                    if(!subghz_file_encoder_worker_bin_parse(
+                           instance, stream, bin_count, bin_size)) {
+                        subghz_file_encoder_worker_add_level_duration(
+                            instance, LEVEL_DURATION_RESET);
+                        break;
+                    }
+                } else if(!subghz_file_encoder_worker_data_parse(
+                              instance, furi_string_get_cstr(instance->str_data))) {
                     subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
                     break;
                 }
@@ -215,6 +255,8 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
 
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
+    free(instance->bin_samples);
+    free(instance->bin_buffer);
 
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
@@ -31,6 +31,9 @@ SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    instance->key_mirrored = NULL;
+    instance->key_mirrored_count = 0;
+    memset(instance->mf_cache, 0, sizeof(instance->mf_cache));
 
     subghz_keystore_reset_kl(instance);
 
@@ -53,10 +56,71 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
+    free(instance->key_mirrored);
 
     free(instance);
 }
 
+static uint64_t subghz_keystore_mirror_key(uint64_t key) {
+    uint64_t key_mirrored = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        key_mirrored |= (uint64_t)(uint8_t)(key >> i) << (56 - i);
+    }
+    return key_mirrored;
+}
+
+static void subghz_keystore_build_index(SubGhzKeystore* instance) {
+    size_t count = SubGhzKeyArray_size(instance->data);
+    // Keys are only appended, so already mirrored part stays valid
+    if(count != instance->key_mirrored_count) {
+        instance->key_mirrored = realloc(instance->key_mirrored, count * sizeof(uint64_t)); //-V701
+        for(size_t i = instance->key_mirrored_count; i < count; i++) {
+            instance->key_mirrored[i] =
+                subghz_keystore_mirror_key(SubGhzKeyArray_cget(instance->data, i)->key);
+        }
+        instance->key_mirrored_count = count;
+    }
+    // Key indexes may point to a different set now
+    memset(instance->mf_cache, 0, sizeof(instance->mf_cache));
+}
+
+uint64_t subghz_keystore_get_key_mirrored(SubGhzKeystore* instance, size_t key_index) {
+    furi_assert(instance);
+    if(key_index < instance->key_mirrored_count) {
+        return instance->key_mirrored[key_index];
+    } else {
+        return subghz_keystore_mirror_key(SubGhzKeyArray_cget(instance->data, key_index)->key);
+    }
+}
+
+static inline size_t subghz_keystore_mf_cache_slot(uint32_t serial) {
+    // Fibonacci hashing, serials are often sequential within a manufacture batch
+    return (uint32_t)(serial * (uint32_t)2654435769U) >> (32 - SUBGHZ_KEYSTORE_MF_CACHE_SIZE_BITS);
+}
+
+const SubGhzKeystoreMfCacheItem*
+    subghz_keystore_mf_cache_get(SubGhzKeystore* instance, uint32_t serial) {
+    furi_assert(instance);
+    const SubGhzKeystoreMfCacheItem* item =
+        &instance->mf_cache[subghz_keystore_mf_cache_slot(serial)];
+    if(item->valid && item->serial == serial &&
+       item->key_index < SubGhzKeyArray_size(instance->data)) {
+        return item;
+    }
+    return NULL;
+}
+
+void subghz_keystore_mf_cache_put(
+    SubGhzKeystore* instance,
+    const SubGhzKeystoreMfCacheItem* item) {
+    furi_assert(instance);
+    furi_assert(item);
+    SubGhzKeystoreMfCacheItem* slot =
+        &instance->mf_cache[subghz_keystore_mf_cache_slot(item->serial)];
+    *slot = *item;
+    slot->valid = true;
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
@@ -246,6 +310,8 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
     furi_string_free(filetype);
 
+    subghz_keystore_build_index(instance);
+
     return result;
 }
 
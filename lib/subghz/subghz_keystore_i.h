@@ -2,8 +2,49 @@
 
 #include <m-array.h>
 
+#define SUBGHZ_KEYSTORE_MF_CACHE_SIZE_BITS 5
+#define SUBGHZ_KEYSTORE_MF_CACHE_SIZE (1u << SUBGHZ_KEYSTORE_MF_CACHE_SIZE_BITS)
+
+/** Resolved serial to manufacture key binding */
+typedef struct {
+    uint32_t serial; /**< 28 bit serial, used as cache key */
+    uint32_t key_index; /**< Index of the manufacture key in keystore data */
+    uint64_t man; /**< Derived key for this serial, ready for decrypt */
+    uint8_t kl_type; /**< Learning type to restore on hit, 0 - leave as is */
+    uint8_t flags; /**< Protocol specific check flags */
+    bool valid;
+} SubGhzKeystoreMfCacheItem;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
     const char* mfname;
     uint8_t kl_type;
+
+    uint64_t* key_mirrored;
+    size_t key_mirrored_count;
+    SubGhzKeystoreMfCacheItem mf_cache[SUBGHZ_KEYSTORE_MF_CACHE_SIZE];
 };
+
+/** 
+ * Get byte mirrored manufacture key, precomputed at load time
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param key_index Index of the key in keystore data
+ * @return byte mirrored key
+ */
+uint64_t subghz_keystore_get_key_mirrored(SubGhzKeystore* instance, size_t key_index);
+
+/** 
+ * Lookup resolved manufacture key for serial
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial 28 bit serial
+ * @return pointer to cache item or NULL if serial is not cached
+ */
+const SubGhzKeystoreMfCacheItem*
+    subghz_keystore_mf_cache_get(SubGhzKeystore* instance, uint32_t serial);
+
+/** 
+ * Store resolved manufacture key for serial
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param item Cache item to store, replaces item in the same slot
+ */
+void subghz_keystore_mf_cache_put(SubGhzKeystore* instance, const SubGhzKeystoreMfCacheItem* item);
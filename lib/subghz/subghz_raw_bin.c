@@ -0,0 +1,242 @@
+#include "subghz_raw_bin.h"
+
+#include <toolbox/varint.h>
+#include <toolbox/stream/file_stream.h>
+
+#define TAG "SubGhzRawBin"
+
+#define SUBGHZ_RAW_BIN_TEXT_KEY "RAW_Data"
+
+size_t subghz_raw_bin_encode(const int32_t* samples, size_t count, uint8_t* output) {
+    furi_check(samples);
+    furi_check(output);
+    furi_check(count <= SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX);
+
+    uint8_t* cursor = output;
+    for(size_t i = 0; i < count; i++) {
+        if(samples[i] > SUBGHZ_RAW_BIN_SAMPLE_MAX || samples[i] < -SUBGHZ_RAW_BIN_SAMPLE_MAX) {
+            return 0;
+        }
+        int32_t previous = (i < 2) ? 0 : samples[i - 2];
+        cursor += varint_int32_pack(samples[i] - previous, cursor);
+    }
+
+    return cursor - output;
+}
+
+bool subghz_raw_bin_decode(const uint8_t* input, size_t size, int32_t* samples, size_t count) {
+    furi_check(input);
+    furi_check(samples);
+
+    size_t offset = 0;
+    for(size_t i = 0; i < count; i++) {
+        size_t available = size - offset;
+        if(!available) return false;
+
+        int32_t delta = 0;
+        size_t used = varint_int32_unpack(&delta, &input[offset], MIN(available, 5U));
+        if(used > available) return false;
+        offset += used;
+
+        int32_t previous = (i < 2) ? 0 : samples[i - 2];
+        samples[i] = previous + delta;
+    }
+
+    return offset == size;
+}
+
+bool subghz_raw_bin_parse_header(const char* line, size_t* count, size_t* size) {
+    furi_check(line);
+    furi_check(count);
+    furi_check(size);
+
+    while(*line == ' ') line++;
+    const size_t key_length = strlen(SUBGHZ_RAW_BIN_KEY);
+    if(strncmp(line, SUBGHZ_RAW_BIN_KEY, key_length) != 0 || line[key_length] != ':') {
+        return false;
+    }
+
+    unsigned int parsed_count = 0;
+    unsigned int parsed_size = 0;
+    if(sscanf(&line[key_length + 1], "%u %u", &parsed_count, &parsed_size) != 2) {
+        return false;
+    }
+    if(parsed_count > SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX ||
+       parsed_size > SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX) {
+        FURI_LOG_E(TAG, "Block too big: %u samples, %u bytes", parsed_count, parsed_size);
+        return false;
+    }
+
+    *count = parsed_count;
+    *size = parsed_size;
+    return true;
+}
+
+bool subghz_raw_bin_write_block(
+    Stream* stream,
+    const int32_t* samples,
+    size_t count,
+    uint8_t* buffer) {
+    furi_check(stream);
+
+    size_t size = subghz_raw_bin_encode(samples, count, buffer);
+    if(count && !size) return false;
+
+    if(!stream_write_format(stream, "%s: %zu %zu\n", SUBGHZ_RAW_BIN_KEY, count, size)) {
+        return false;
+    }
+    if(stream_write(stream, buffer, size) != size) return false;
+    return stream_write_char(stream, '\n') == 1;
+}
+
+bool subghz_raw_bin_read_block(
+    Stream* stream,
+    int32_t* samples,
+    size_t count,
+    size_t size,
+    uint8_t* buffer) {
+    furi_check(stream);
+    furi_check(size <= SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX);
+
+    // Payload is followed by a line feed
+    if(stream_read(stream, buffer, size + 1) != size + 1 || buffer[size] != '\n') {
+        FURI_LOG_E(TAG, "Truncated block");
+        return false;
+    }
+    if(!subghz_raw_bin_decode(buffer, size, samples, count)) {
+        FURI_LOG_E(TAG, "Malformed block");
+        return false;
+    }
+    return true;
+}
+
+static const char* subghz_raw_bin_parse_text_line(
+    const char* cursor,
+    int32_t* samples,
+    size_t* samples_count,
+    size_t samples_max) {
+    // Same value rules as in SubGhzFileEncoderWorker text parser
+    char* end = NULL;
+    while(*samples_count < samples_max) {
+        long value = strtol(cursor, &end, 10);
+        if(end == cursor) return NULL;
+        cursor = end;
+        if((value < -1000000) || (value > 1000000)) {
+            value = (value > 0) ? 100 : -100;
+        }
+        samples[(*samples_count)++] = value;
+    }
+    return cursor;
+}
+
+static bool subghz_raw_bin_flush(
+    Stream* stream,
+    const int32_t* samples,
+    size_t count,
+    uint8_t* buffer,
+    FuriString* line,
+    bool binary) {
+    if(!count) return true;
+
+    if(binary) {
+        return subghz_raw_bin_write_block(stream, samples, count, buffer);
+    } else {
+        furi_string_set(line, SUBGHZ_RAW_BIN_TEXT_KEY ":");
+        for(size_t i = 0; i < count; i++) {
+            furi_string_cat_printf(line, " %ld", samples[i]);
+        }
+        furi_string_push_back(line, '\n');
+        return stream_write_string(stream, line) == furi_string_size(line);
+    }
+}
+
+bool subghz_raw_bin_convert_file(
+    Storage* storage,
+    const char* source_path,
+    const char* destination_path,
+    bool binary) {
+    furi_check(storage);
+    furi_check(source_path);
+    furi_check(destination_path);
+
+    Stream* source = file_stream_alloc(storage);
+    Stream* destination = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    FuriString* output_line = furi_string_alloc();
+    // Room for one full block plus one text line worth of samples
+    const size_t samples_max = SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX * 2;
+    int32_t* samples = malloc(samples_max * sizeof(int32_t));
+    uint8_t* buffer = malloc(SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX + 1);
+    size_t samples_count = 0;
+    bool result = false;
+
+    do {
+        if(!file_stream_open(source, source_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Unable to open %s", source_path);
+            break;
+        }
+        if(!file_stream_open(destination, destination_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open %s", destination_path);
+            break;
+        }
+
+        result = true;
+        while(result && stream_read_line(source, line)) {
+            size_t block_count = 0;
+            size_t block_size = 0;
+            const char* line_cstr = furi_string_get_cstr(line);
+            const char* text_cursor = NULL;
+
+            if(subghz_raw_bin_parse_header(line_cstr, &block_count, &block_size)) {
+                result = subghz_raw_bin_read_block(
+                    source, &samples[samples_count], block_count, block_size, buffer);
+                samples_count += block_count;
+            } else if(furi_string_start_with_str(line, SUBGHZ_RAW_BIN_TEXT_KEY ":")) {
+                text_cursor = line_cstr + strlen(SUBGHZ_RAW_BIN_TEXT_KEY ":");
+            } else {
+                // Keep non RAW lines in place
+                result = subghz_raw_bin_flush(
+                    destination, samples, samples_count, buffer, output_line, binary);
+                samples_count = 0;
+                result = result &&
+                         (stream_write_string(destination, line) == furi_string_size(line));
+                continue;
+            }
+
+            do {
+                if(text_cursor) {
+                    text_cursor = subghz_raw_bin_parse_text_line(
+                        text_cursor, samples, &samples_count, samples_max);
+                }
+                // Emit full blocks, keep the tail for the next line
+                while(result && samples_count >= SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX) {
+                    result = subghz_raw_bin_flush(
+                        destination,
+                        samples,
+                        SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX,
+                        buffer,
+                        output_line,
+                        binary);
+                    samples_count -= SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX;
+                    memmove(
+                        samples,
+                        &samples[SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX],
+                        samples_count * sizeof(int32_t));
+                }
+            } while(result && text_cursor);
+        }
+        result = result && subghz_raw_bin_flush(
+                               destination, samples, samples_count, buffer, output_line, binary);
+    } while(false);
+
+    free(buffer);
+    free(samples);
+    furi_string_free(output_line);
+    furi_string_free(line);
+    file_stream_close(destination);
+    file_stream_close(source);
+    stream_free(destination);
+    stream_free(source);
+
+    return result;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary RAW block, stored in .sub files next to or instead of RAW_Data lines:
+ *
+ * RAW_Bin: <sample count> <payload size>\n
+ * <payload>\n
+ *
+ * Payload is a sequence of zigzag varints, each one is a difference between
+ * the sample and the sample two positions before it (same level in an
+ * alternating sequence). Every block starts from zero history.
+ */
+
+#define SUBGHZ_RAW_BIN_KEY "RAW_Bin"
+#define SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX 512
+#define SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX (SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX * 5)
+
+/** Samples outside of this range are not representable in binary block */
+#define SUBGHZ_RAW_BIN_SAMPLE_MAX 0x1FFFFFFF
+
+/** 
+ * Encode samples into binary block payload
+ * @param samples Signed durations, positive for high level
+ * @param count Sample count, up to SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX
+ * @param output Payload buffer, at least SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX bytes
+ * @return payload size, 0 if a sample is out of range
+ */
+size_t subghz_raw_bin_encode(const int32_t* samples, size_t count, uint8_t* output);
+
+/** 
+ * Decode binary block payload into samples
+ * @param input Payload
+ * @param size Payload size
+ * @param samples Output samples
+ * @param count Expected sample count
+ * @return true if payload holds exactly count samples
+ */
+bool subghz_raw_bin_decode(const uint8_t* input, size_t size, int32_t* samples, size_t count);
+
+/** 
+ * Parse binary block header line
+ * @param line Header line, leading and trailing whitespace allowed
+ * @param count Sample count
+ * @param size Payload size
+ * @return true if line is a valid binary block header
+ */
+bool subghz_raw_bin_parse_header(const char* line, size_t* count, size_t* size);
+
+/** 
+ * Write binary block to stream
+ * @param stream Stream positioned at the start of a line
+ * @param samples Signed durations, positive for high level
+ * @param count Sample count, up to SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX
+ * @param buffer Scratch buffer, at least SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX bytes
+ * @return true on success
+ */
+bool subghz_raw_bin_write_block(
+    Stream* stream,
+    const int32_t* samples,
+    size_t count,
+    uint8_t* buffer);
+
+/** 
+ * Read binary block payload following an already parsed header
+ * @param stream Stream positioned right after header line
+ * @param samples Output samples, at least SUBGHZ_RAW_BIN_BLOCK_SAMPLES_MAX
+ * @param count Sample count from header
+ * @param size Payload size from header
+ * @param buffer Scratch buffer, at least SUBGHZ_RAW_BIN_BLOCK_SIZE_MAX + 1 bytes:
+ *               payload is read together with the line feed that ends it
+ * @return true on success, stream is positioned at the next line
+ */
+bool subghz_raw_bin_read_block(
+    Stream* stream,
+    int32_t* samples,
+    size_t count,
+    size_t size,
+    uint8_t* buffer);
+
+/** 
+ * Convert .sub RAW file between text RAW_Data and binary RAW_Bin representation
+ * Lines other than RAW data are copied as is.
+ * @param storage Pointer to a Storage instance
+ * @param source_path Source file, either representation
+ * @param destination_path Destination file, overwritten
+ * @param binary true to produce RAW_Bin blocks, false for RAW_Data lines
+ * @return true on success
+ */
+bool subghz_raw_bin_convert_file(
+    Storage* storage,
+    const char* source_path,
+    const char* destination_path,
+    bool binary);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,18 +4,26 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE 64
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
 
     volatile bool running;
     volatile bool overrun;
+    volatile uint32_t dropped;
 
     LevelDuration filter_level_duration;
     uint16_t filter_duration;
 
+    LevelDuration rx_batch[SUBGHZ_WORKER_BATCH_SIZE];
+    LevelDuration pair_batch[SUBGHZ_WORKER_BATCH_SIZE];
+    SubGhzWorkerStats stats;
+
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairBatchCallback pair_batch_callback;
     void* context;
 };
 
@@ -35,7 +43,17 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     }
     size_t ret =
         furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(sizeof(LevelDuration) != ret) {
+        instance->overrun = true;
+        instance->dropped++;
+    }
+}
+
+static void subghz_worker_flush_pair_batch(SubGhzWorker* instance, size_t* pair_count) {
+    if(*pair_count) {
+        instance->pair_batch_callback(instance->context, instance->pair_batch, *pair_count);
+        *pair_count = 0;
+    }
 }
 
 /** Worker callback thread
@@ -46,13 +64,26 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        // Drain everything accumulated since the last wakeup, up to batch size
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, instance->rx_batch, sizeof(instance->rx_batch), 10);
+        size_t rx_count = ret / sizeof(LevelDuration);
+        if(!rx_count) continue;
+
+        instance->stats.edges += rx_count;
+        if(rx_count > instance->stats.batch_max) instance->stats.batch_max = rx_count;
+
+        size_t pair_count = 0;
+        for(size_t i = 0; i < rx_count; i++) {
+            LevelDuration level_duration = instance->rx_batch[i];
             if(level_duration_is_reset(level_duration)) {
                 FURI_LOG_E(TAG, "Overrun buffer");
+                instance->stats.overruns++;
+                // Pairs received before overrun must reach receiver before it is reset
+                if(instance->pair_batch_callback) {
+                    subghz_worker_flush_pair_batch(instance, &pair_count);
+                }
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
                 bool level = level_duration_get_level(level_duration);
@@ -63,17 +94,25 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
+                    if(instance->pair_batch_callback) {
+                        instance->pair_batch[pair_count++] = level_duration_make(
+                            instance->filter_level_duration.level,
+                            instance->filter_level_duration.duration);
+                    } else if(instance->pair_callback) {
                         instance->pair_callback(
                             instance->context,
                             instance->filter_level_duration.level,
                             instance->filter_level_duration.duration);
+                    }
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
                 }
             }
         }
+        if(instance->pair_batch_callback) {
+            subghz_worker_flush_pair_batch(instance, &pair_count);
+        }
     }
 
     return 0;
@@ -115,6 +154,13 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback) {
+    furi_check(instance);
+    instance->pair_batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_check(instance);
     instance->context = context;
@@ -146,4 +192,17 @@ bool subghz_worker_is_running(SubGhzWorker* instance) {
 void subghz_worker_set_filter(SubGhzWorker* instance, uint16_t timeout) {
     furi_check(instance);
     instance->filter_duration = timeout;
-}
\ No newline at end of file
+}
+
+void subghz_worker_get_stats(SubGhzWorker* instance, SubGhzWorkerStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+    *stats = instance->stats;
+    stats->dropped = instance->dropped;
+}
+
+void subghz_worker_reset_stats(SubGhzWorker* instance) {
+    furi_check(instance);
+    memset(&instance->stats, 0, sizeof(SubGhzWorkerStats));
+    instance->dropped = 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,19 @@ typedef void (*SubGhzWorkerOverrunCallback)(void* context);
 
 typedef void (*SubGhzWorkerPairCallback)(void* context, bool level, uint32_t duration);
 
+typedef void (*SubGhzWorkerPairBatchCallback)(
+    void* context,
+    const LevelDuration* level_durations,
+    size_t count);
+
+/** SubGhzWorker receive pipeline counters */
+typedef struct {
+    uint32_t edges; /**< Edges taken from the stream by worker thread */
+    uint32_t overruns; /**< Stream overflow events, each one resets the receiver */
+    uint32_t dropped; /**< Edges that did not fit into the stream */
+    size_t batch_max; /**< Most edges drained from the stream at once */
+} SubGhzWorkerStats;
+
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context);
 
 /** 
@@ -42,6 +56,17 @@ void subghz_worker_set_overrun_callback(
  */
 void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCallback callback);
 
+/** 
+ * Pair batch callback SubGhzWorker.
+ * Filtered pairs are delivered in blocks, one call per stream drain.
+ * Takes precedence over pair callback when set.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param callback SubGhzWorkerPairBatchCallback callback
+ */
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback);
+
 /** 
  * Context callback SubGhzWorker.
  * @param instance Pointer to a SubGhzWorker instance
@@ -75,6 +100,19 @@ bool subghz_worker_is_running(SubGhzWorker* instance);
  */
 void subghz_worker_set_filter(SubGhzWorker* instance, uint16_t timeout);
 
+/** 
+ * Get receive pipeline counters.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param stats Pointer to a SubGhzWorkerStats to fill
+ */
+void subghz_worker_get_stats(SubGhzWorker* instance, SubGhzWorkerStats* stats);
+
+/** 
+ * Reset receive pipeline counters.
+ * @param instance Pointer to a SubGhzWorker instance
+ */
+void subghz_worker_reset_stats(SubGhzWorker* instance);
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,14 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
     }
 }
 
+size_t compress_icon_get_compressed_size(const uint8_t* icon_data) {
+    furi_check(icon_data);
+
+    CompressHeader* header = (CompressHeader*)icon_data;
+    if(!header->is_compressed) return 0;
+    return sizeof(CompressHeader) + header->compressed_buff_size;
+}
+
 struct Compress {
     const void* config;
     heatshrink_encoder* encoder;
@@ -0,0 +1,219 @@
+#include "delta_sync.h"
+
+#include <furi.h>
+#include <mbedtls/md5.h>
+
+#define DELTA_SYNC_BUFFER_SIZE (512)
+#define DELTA_SYNC_TEMP_EXTENSION ".dsync"
+
+#define DELTA_SYNC_OP_COPY 'C'
+#define DELTA_SYNC_OP_LITERAL 'L'
+
+uint32_t delta_sync_checksum(const uint8_t* data, size_t size) {
+    uint32_t a = 0;
+    uint32_t b = 0;
+    for(size_t i = 0; i < size; i++) {
+        a += data[i];
+        b += (size - i) * data[i];
+    }
+    return (a & 0xFFFF) | (b << 16);
+}
+
+uint32_t delta_sync_checksum_roll(
+    uint32_t checksum,
+    size_t block_size,
+    uint8_t byte_out,
+    uint8_t byte_in) {
+    uint32_t a = checksum & 0xFFFF;
+    uint32_t b = checksum >> 16;
+    a = (a - byte_out + byte_in) & 0xFFFF;
+    b = (b - block_size * byte_out + a) & 0xFFFF;
+    return a | (b << 16);
+}
+
+bool delta_sync_signature_file(
+    File* file,
+    const char* path,
+    size_t block_size,
+    DeltaSyncSignatureCallback callback,
+    void* context,
+    FS_Error* file_error) {
+    furi_check(file);
+    furi_check(path);
+    furi_check(block_size && block_size <= DELTA_SYNC_BLOCK_SIZE_MAX);
+    furi_check(callback);
+
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        if(file_error != NULL) {
+            *file_error = storage_file_get_error(file);
+        }
+        return false;
+    }
+
+    uint8_t* block = malloc(block_size);
+    uint8_t md5[DELTA_SYNC_MD5_SIZE];
+    bool result = true;
+
+    while(true) {
+        size_t read_size = storage_file_read(file, block, block_size);
+        if(storage_file_get_error(file) != FSE_OK) {
+            result = false;
+            break;
+        }
+        if(read_size == 0) {
+            break;
+        }
+
+        mbedtls_md5(block, read_size, md5);
+        callback(delta_sync_checksum(block, read_size), md5, context);
+
+        if(read_size < block_size) {
+            break;
+        }
+    }
+    free(block);
+
+    if(file_error != NULL) {
+        *file_error = storage_file_get_error(file);
+    }
+
+    storage_file_close(file);
+    return result;
+}
+
+static bool delta_sync_read_u32(File* file, uint32_t* value) {
+    uint8_t bytes[sizeof(uint32_t)];
+    if(storage_file_read(file, bytes, sizeof(bytes)) != sizeof(bytes)) return false;
+
+    *value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+    return true;
+}
+
+static bool delta_sync_copy(File* from, File* to, uint64_t size, uint8_t* buffer) {
+    while(size) {
+        size_t chunk_size = MIN(size, (uint64_t)DELTA_SYNC_BUFFER_SIZE);
+        if(storage_file_read(from, buffer, chunk_size) != chunk_size) return false;
+        if(storage_file_write(to, buffer, chunk_size) != chunk_size) return false;
+        size -= chunk_size;
+    }
+    return true;
+}
+
+static bool delta_sync_patch_copy(
+    File* original,
+    File* delta,
+    File* patched,
+    uint32_t block_size,
+    uint8_t* buffer) {
+    uint32_t first_block, block_count;
+    if(!delta_sync_read_u32(delta, &first_block)) return false;
+    if(!delta_sync_read_u32(delta, &block_count)) return false;
+
+    uint64_t original_size = storage_file_size(original);
+    uint64_t offset = (uint64_t)first_block * block_size;
+    uint64_t size = (uint64_t)block_count * block_size;
+    if(!block_count || offset >= original_size) return false;
+    // Only the last block of original file can be shorter
+    if(offset + size > original_size) {
+        if(offset + size - original_size >= block_size) return false;
+        size = original_size - offset;
+    }
+
+    if(!storage_file_seek(original, offset, true)) return false;
+    return delta_sync_copy(original, patched, size, buffer);
+}
+
+static bool delta_sync_patch_literal(File* delta, File* patched, uint8_t* buffer) {
+    uint32_t length;
+    if(!delta_sync_read_u32(delta, &length)) return false;
+
+    return delta_sync_copy(delta, patched, length, buffer);
+}
+
+static bool delta_sync_patch(File* original, File* delta, File* patched, uint8_t* buffer) {
+    uint32_t magic, block_size;
+    if(!delta_sync_read_u32(delta, &magic) || magic != DELTA_SYNC_MAGIC) return false;
+    if(!delta_sync_read_u32(delta, &block_size) || !block_size) return false;
+
+    uint8_t op;
+    bool result = true;
+    while(result && storage_file_read(delta, &op, sizeof(op)) == sizeof(op)) {
+        if(op == DELTA_SYNC_OP_COPY) {
+            result = delta_sync_patch_copy(original, delta, patched, block_size, buffer);
+        } else if(op == DELTA_SYNC_OP_LITERAL) {
+            result = delta_sync_patch_literal(delta, patched, buffer);
+        } else {
+            result = false;
+        }
+    }
+
+    return result && storage_file_get_error(delta) == FSE_OK;
+}
+
+bool delta_sync_patch_file(
+    Storage* storage,
+    const char* path,
+    const char* delta_path,
+    FS_Error* file_error) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(delta_path);
+
+    File* original = storage_file_alloc(storage);
+    File* delta = storage_file_alloc(storage);
+    File* patched = storage_file_alloc(storage);
+    FuriString* patched_path = furi_string_alloc_printf("%s" DELTA_SYNC_TEMP_EXTENSION, path);
+    FS_Error error = FSE_OK;
+    bool result = false;
+
+    do {
+        if(!storage_file_open(original, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            error = storage_file_get_error(original);
+            break;
+        }
+        if(!storage_file_open(delta, delta_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            error = storage_file_get_error(delta);
+            break;
+        }
+        if(!storage_file_open(
+               patched, furi_string_get_cstr(patched_path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            error = storage_file_get_error(patched);
+            break;
+        }
+
+        uint8_t* buffer = malloc(DELTA_SYNC_BUFFER_SIZE);
+        result = delta_sync_patch(original, delta, patched, buffer);
+        free(buffer);
+
+        if(!result) {
+            // Storage errors take precedence over malformed delta
+            error = storage_file_get_error(patched);
+            if(error == FSE_OK) error = storage_file_get_error(original);
+            if(error == FSE_OK) error = storage_file_get_error(delta);
+            if(error == FSE_OK) error = FSE_INVALID_PARAMETER;
+        }
+    } while(false);
+
+    bool patched_open = storage_file_is_open(patched);
+    storage_file_close(original);
+    storage_file_close(delta);
+    storage_file_close(patched);
+
+    if(result) {
+        error = storage_common_rename(storage, furi_string_get_cstr(patched_path), path);
+        result = (error == FSE_OK);
+    }
+    if(!result && patched_open) {
+        storage_common_remove(storage, furi_string_get_cstr(patched_path));
+    }
+
+    furi_string_free(patched_path);
+    storage_file_free(patched);
+    storage_file_free(delta);
+    storage_file_free(original);
+
+    if(file_error != NULL) {
+        *file_error = error;
+    }
+    return result;
+}
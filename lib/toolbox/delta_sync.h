@@ -0,0 +1,100 @@
+/**
+ * @file delta_sync.h
+ * Block checksums and delta patches for updating files with small changes
+ *
+ * Same scheme as rsync: the receiver reports a rolling and a strong (MD5)
+ * checksum for every block of its copy, the sender finds these blocks in
+ * the new version and sends a delta made of block copies and literal data.
+ *
+ * Delta file format, all numbers are little endian uint32:
+ * - header: DELTA_SYNC_MAGIC, block size
+ * - any number of instructions:
+ *   - 'C', first block, block count: copy blocks from the original file
+ *   - 'L', length, data: append literal data
+ */
+#pragma once
+
+#include <stdint.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DELTA_SYNC_MAGIC (0x4E595344) // "DSYN"
+#define DELTA_SYNC_BLOCK_SIZE_MAX (8192)
+#define DELTA_SYNC_MD5_SIZE (16)
+
+/** Calculate rolling checksum of data block
+ *
+ * @param      data  pointer to data
+ * @param[in]  size  data size
+ *
+ * @return     checksum
+ */
+uint32_t delta_sync_checksum(const uint8_t* data, size_t size);
+
+/** Move rolling checksum window one byte forward
+ *
+ * @param[in]  checksum    checksum of current window
+ * @param[in]  block_size  window size
+ * @param[in]  byte_out    first byte of current window
+ * @param[in]  byte_in     byte following current window
+ *
+ * @return     checksum of next window
+ */
+uint32_t delta_sync_checksum_roll(
+    uint32_t checksum,
+    size_t block_size,
+    uint8_t byte_out,
+    uint8_t byte_in);
+
+/** Block signature callback
+ *
+ * @param      checksum  rolling checksum of the block
+ * @param      md5       MD5 of the block, DELTA_SYNC_MD5_SIZE bytes
+ * @param      context   user context
+ */
+typedef void (*DeltaSyncSignatureCallback)(uint32_t checksum, const uint8_t* md5, void* context);
+
+/** Calculate checksums of every block of a file
+ *
+ * @param      file        file instance to use, closed on return
+ * @param      path        path of the file
+ * @param[in]  block_size  block size, up to DELTA_SYNC_BLOCK_SIZE_MAX
+ * @param      callback    called for each block in order, last block may be shorter
+ * @param      context     callback context
+ * @param      file_error  pointer to store file error, can be NULL
+ *
+ * @return     true on success
+ */
+bool delta_sync_signature_file(
+    File* file,
+    const char* path,
+    size_t block_size,
+    DeltaSyncSignatureCallback callback,
+    void* context,
+    FS_Error* file_error);
+
+/** Apply delta to a file
+ *
+ * Patched file is assembled next to the original one and replaces it only
+ * when the whole delta is applied.
+ *
+ * @param      storage     storage API instance
+ * @param      path        path of the file to patch
+ * @param      delta_path  path of the delta file
+ * @param      file_error  pointer to store file error, can be NULL.
+ *                         FSE_INVALID_PARAMETER for malformed delta.
+ *
+ * @return     true on success
+ */
+bool delta_sync_patch_file(
+    Storage* storage,
+    const char* path,
+    const char* delta_path,
+    FS_Error* file_error);
+
+#ifdef __cplusplus
+}
+#endif
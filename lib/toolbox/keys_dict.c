@@ -5,23 +5,97 @@
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/stream/buffered_file_stream.h>
 #include <toolbox/args.h>
+#include <furi_hal_rtc.h>
 
 #define TAG "KeysDict"
 
+#define KEYS_DICT_INDEX_EXTENSION ".kdx"
+#define KEYS_DICT_INDEX_TMP_EXTENSION ".tmp"
+#define KEYS_DICT_INDEX_MAGIC (0x3158444BUL) // "KDX1"
+#define KEYS_DICT_INDEX_VERSION (1U)
+// Smaller dictionaries are scanned as text
+#define KEYS_DICT_INDEX_MIN_KEYS (64U)
+// Keys sorted in RAM at once while building the index
+#define KEYS_DICT_INDEX_SORT_CHUNK (512U)
+// Keys read or written per storage call
+#define KEYS_DICT_INDEX_IO_KEYS (32U)
+#define KEYS_DICT_BLOOM_BITS_PER_KEY (8U)
+#define KEYS_DICT_BLOOM_HASHES (3U)
+#define KEYS_DICT_BLOOM_MIN_SIZE (64U)
+#define KEYS_DICT_BLOOM_MAX_SIZE (4096U)
+// FAT timestamps have 2 second resolution, sources modified more recently
+// than this may still change without changing their timestamp
+#define KEYS_DICT_INDEX_MTIME_WINDOW (3U)
+
+/* Compiled index, stored next to the text dictionary:
+ * - header
+ * - keys in dictionary order, key_size bytes each
+ * - keys sorted in ascending order, key_size bytes each
+ * - bloom filter
+ * Keys are stored big endian, so byte order matches numeric order.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint8_t bloom_hashes;
+    uint8_t reserved;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t total_keys;
+    uint32_t bloom_size;
+} FURI_PACKED KeysDictIndexHeader;
+
+typedef struct {
+    File* file;
+    uint8_t* bloom;
+    uint32_t bloom_mask;
+    uint32_t next_key;
+    uint32_t buffer_pos;
+    uint32_t buffer_len;
+    uint8_t buffer[KEYS_DICT_INDEX_IO_KEYS * sizeof(uint64_t)];
+} KeysDictIndex;
+
 struct KeysDict {
+    Storage* storage;
     Stream* stream;
+    FuriString* path;
+    bool writable;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+    KeysDictIndex* index;
 };
 
+// Dictionaries are opened read only, reopens the file for writing keeping the position
+static bool keys_dict_make_writable(KeysDict* instance) {
+    if(instance->writable) return true;
+
+    const size_t position = stream_tell(instance->stream);
+    buffered_file_stream_close(instance->stream);
+    instance->writable = buffered_file_stream_open(
+        instance->stream,
+        furi_string_get_cstr(instance->path),
+        FSAM_READ_WRITE,
+        FSOM_OPEN_EXISTING);
+    if(instance->writable) {
+        stream_seek(instance->stream, position, StreamOffsetFromStart);
+    } else {
+        FURI_LOG_E(TAG, "Failed to reopen dictionary for writing");
+    }
+
+    return instance->writable;
+}
+
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
     if(stream_seek(instance->stream, -1, StreamOffsetFromEnd)) {
         uint8_t last_char = 0;
 
         // Check if the last char is new line or add a new line
-        if(stream_read(instance->stream, &last_char, 1) == 1 && last_char != '\n') {
+        if(stream_read(instance->stream, &last_char, 1) == 1 && last_char != '\n' &&
+           keys_dict_make_writable(instance)) {
             FURI_LOG_D(TAG, "Adding new line ending");
+            stream_seek(instance->stream, 0, StreamOffsetFromEnd);
             stream_write_char(instance->stream, '\n');
         }
 
@@ -52,6 +126,509 @@ static bool keys_dict_read_key_line(KeysDict* instance, FuriString* line, bool*
     return false;
 }
 
+static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int);
+
+static uint64_t keys_dict_key_to_int(const uint8_t* key, size_t key_size) {
+    uint64_t key_int = 0;
+
+    for(size_t i = 0; i < key_size; i++) {
+        key_int = (key_int << 8) | key[i];
+    }
+
+    return key_int;
+}
+
+static void keys_dict_int_to_key(uint64_t key_int, uint8_t* key, size_t key_size) {
+    while(key_size--) {
+        key[key_size] = (uint8_t)key_int;
+        key_int >>= 8;
+    }
+}
+
+static int keys_dict_compare_int(const void* a, const void* b) {
+    const uint64_t key_a = *(const uint64_t*)a;
+    const uint64_t key_b = *(const uint64_t*)b;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+static uint64_t keys_dict_bloom_hash(uint64_t key) {
+    // splitmix64 finalizer, keys are often far from random
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBULL;
+    key ^= key >> 31;
+    return key;
+}
+
+static void keys_dict_bloom_add(uint8_t* bloom, uint32_t mask, uint64_t key) {
+    const uint64_t hash = keys_dict_bloom_hash(key);
+    const uint32_t h1 = (uint32_t)hash;
+    const uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+
+    for(uint32_t i = 0; i < KEYS_DICT_BLOOM_HASHES; i++) {
+        const uint32_t bit = (h1 + i * h2) & mask;
+        bloom[bit / 8] |= 1 << (bit % 8);
+    }
+}
+
+static bool keys_dict_bloom_check(const uint8_t* bloom, uint32_t mask, uint64_t key) {
+    const uint64_t hash = keys_dict_bloom_hash(key);
+    const uint32_t h1 = (uint32_t)hash;
+    const uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+
+    for(uint32_t i = 0; i < KEYS_DICT_BLOOM_HASHES; i++) {
+        const uint32_t bit = (h1 + i * h2) & mask;
+        if(!(bloom[bit / 8] & (1 << (bit % 8)))) return false;
+    }
+
+    return true;
+}
+
+static uint32_t keys_dict_bloom_get_size(size_t total_keys) {
+    const size_t bits = total_keys * KEYS_DICT_BLOOM_BITS_PER_KEY;
+    uint32_t size = KEYS_DICT_BLOOM_MIN_SIZE;
+
+    while(size * 8 < bits && size < KEYS_DICT_BLOOM_MAX_SIZE) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+static bool keys_dict_get_source_info(
+    KeysDict* instance,
+    const char* path,
+    uint32_t* size,
+    uint32_t* timestamp) {
+    FileInfo info;
+
+    // Own modification time of the dictionary file
+    if(storage_common_stat(instance->storage, path, &info) != FSE_OK) return false;
+    if(storage_common_timestamp(instance->storage, path, timestamp) != FSE_OK) return false;
+    *size = info.size;
+
+    // Racily clean: a write within the same FAT time slot would go unnoticed
+    return furi_hal_rtc_get_timestamp() - *timestamp >= KEYS_DICT_INDEX_MTIME_WINDOW;
+}
+
+typedef struct {
+    File* file;
+    size_t len;
+    bool ok;
+    uint8_t buffer[KEYS_DICT_INDEX_IO_KEYS * sizeof(uint64_t)];
+} KeysDictIndexWriter;
+
+static void keys_dict_index_writer_flush(KeysDictIndexWriter* writer) {
+    if(writer->len && storage_file_write(writer->file, writer->buffer, writer->len) != writer->len)
+        writer->ok = false;
+    writer->len = 0;
+}
+
+static void
+    keys_dict_index_writer_put(KeysDictIndexWriter* writer, const void* data, size_t size) {
+    if(writer->len + size > sizeof(writer->buffer)) {
+        keys_dict_index_writer_flush(writer);
+    }
+    memcpy(&writer->buffer[writer->len], data, size);
+    writer->len += size;
+}
+
+// Reads sorted run of native uint64_t keys from a temporary file
+typedef struct {
+    File* file;
+    uint32_t offset;
+    uint32_t left;
+    uint32_t pos;
+    uint32_t len;
+    bool ok;
+    uint64_t buffer[KEYS_DICT_INDEX_IO_KEYS];
+} KeysDictIndexRunReader;
+
+static void keys_dict_index_run_reader_init(
+    KeysDictIndexRunReader* reader,
+    File* file,
+    uint32_t start,
+    uint32_t count) {
+    reader->file = file;
+    reader->offset = start * sizeof(uint64_t);
+    reader->left = count;
+    reader->pos = 0;
+    reader->len = 0;
+    reader->ok = true;
+}
+
+static bool keys_dict_index_run_reader_next(KeysDictIndexRunReader* reader, uint64_t* key) {
+    if(reader->pos == reader->len) {
+        if(reader->left == 0) return false;
+
+        const uint32_t count = MIN(reader->left, KEYS_DICT_INDEX_IO_KEYS);
+        const size_t size = count * sizeof(uint64_t);
+
+        // Runs share the file, so always seek
+        if(!storage_file_seek(reader->file, reader->offset, true) ||
+           storage_file_read(reader->file, reader->buffer, size) != size) {
+            reader->ok = false;
+            reader->left = 0;
+            return false;
+        }
+
+        reader->offset += size;
+        reader->left -= count;
+        reader->pos = 0;
+        reader->len = count;
+    }
+
+    *key = reader->buffer[reader->pos++];
+    return true;
+}
+
+// Merges pairs of sorted runs of run_len keys from src_path into dst_path
+static bool keys_dict_index_merge_pass(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    uint32_t total_keys,
+    uint32_t run_len) {
+    File* src = storage_file_alloc(storage);
+    File* dst = storage_file_alloc(storage);
+    KeysDictIndexRunReader* readers = malloc(sizeof(KeysDictIndexRunReader) * 2);
+    KeysDictIndexWriter* writer = malloc(sizeof(KeysDictIndexWriter));
+
+    bool success = storage_file_open(src, src_path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                   storage_file_open(dst, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    writer->file = dst;
+    writer->ok = success;
+
+    for(uint32_t start = 0; success && start < total_keys; start += 2 * run_len) {
+        const uint32_t len_a = MIN(run_len, total_keys - start);
+        const uint32_t len_b = MIN(run_len, total_keys - start - len_a);
+        keys_dict_index_run_reader_init(&readers[0], src, start, len_a);
+        keys_dict_index_run_reader_init(&readers[1], src, start + len_a, len_b);
+
+        uint64_t key_a = 0, key_b = 0;
+        bool has_a = keys_dict_index_run_reader_next(&readers[0], &key_a);
+        bool has_b = keys_dict_index_run_reader_next(&readers[1], &key_b);
+
+        while(has_a || has_b) {
+            if(has_a && (!has_b || key_a <= key_b)) {
+                keys_dict_index_writer_put(writer, &key_a, sizeof(key_a));
+                has_a = keys_dict_index_run_reader_next(&readers[0], &key_a);
+            } else {
+                keys_dict_index_writer_put(writer, &key_b, sizeof(key_b));
+                has_b = keys_dict_index_run_reader_next(&readers[1], &key_b);
+            }
+        }
+
+        success = readers[0].ok && readers[1].ok && writer->ok;
+    }
+
+    keys_dict_index_writer_flush(writer);
+    success = success && writer->ok;
+
+    storage_file_close(src);
+    storage_file_close(dst);
+    storage_file_free(src);
+    storage_file_free(dst);
+    free(readers);
+    free(writer);
+
+    return success;
+}
+
+// Writes keys in dictionary order to the index and the sorted chunk to the run file
+static bool keys_dict_index_write_chunk(
+    KeysDict* instance,
+    KeysDictIndexWriter* writer,
+    File* run_file,
+    uint64_t* chunk,
+    size_t chunk_len) {
+    uint8_t key[sizeof(uint64_t)];
+
+    for(size_t i = 0; i < chunk_len; i++) {
+        keys_dict_int_to_key(chunk[i], key, instance->key_size);
+        keys_dict_index_writer_put(writer, key, instance->key_size);
+    }
+    keys_dict_index_writer_flush(writer);
+
+    qsort(chunk, chunk_len, sizeof(uint64_t), keys_dict_compare_int);
+    const size_t size = chunk_len * sizeof(uint64_t);
+
+    return writer->ok && storage_file_write(run_file, chunk, size) == size;
+}
+
+// Appends sorted keys and bloom filter to the index, then writes the header
+static bool keys_dict_index_finalize(
+    KeysDict* instance,
+    KeysDictIndexWriter* writer,
+    const char* run_path,
+    KeysDictIndexHeader* header) {
+    File* run_file = storage_file_alloc(instance->storage);
+    KeysDictIndexRunReader* reader = malloc(sizeof(KeysDictIndexRunReader));
+    uint8_t* bloom = malloc(header->bloom_size);
+    const uint32_t bloom_mask = header->bloom_size * 8 - 1;
+    uint8_t key[sizeof(uint64_t)];
+    uint64_t key_int;
+
+    bool success = storage_file_open(run_file, run_path, FSAM_READ, FSOM_OPEN_EXISTING);
+    keys_dict_index_run_reader_init(reader, run_file, 0, header->total_keys);
+
+    while(success && keys_dict_index_run_reader_next(reader, &key_int)) {
+        keys_dict_int_to_key(key_int, key, instance->key_size);
+        keys_dict_index_writer_put(writer, key, instance->key_size);
+        keys_dict_bloom_add(bloom, bloom_mask, key_int);
+    }
+    keys_dict_index_writer_flush(writer);
+
+    success = success && reader->ok && writer->ok &&
+              storage_file_write(writer->file, bloom, header->bloom_size) == header->bloom_size;
+
+    // Header is written last, so an interrupted build never looks valid
+    header->magic = KEYS_DICT_INDEX_MAGIC;
+    success = success && storage_file_seek(writer->file, 0, true) &&
+              storage_file_write(writer->file, header, sizeof(*header)) == sizeof(*header);
+
+    storage_file_close(run_file);
+    storage_file_free(run_file);
+    free(reader);
+    free(bloom);
+
+    return success;
+}
+
+// Counts the keys and, if index_path is set, compiles the index
+static bool keys_dict_index_build(
+    KeysDict* instance,
+    const char* index_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    FuriString* run_path[2] = {furi_string_alloc(), furi_string_alloc()};
+    if(index_path) {
+        furi_string_printf(run_path[0], "%s" KEYS_DICT_INDEX_TMP_EXTENSION "0", index_path);
+        furi_string_printf(run_path[1], "%s" KEYS_DICT_INDEX_TMP_EXTENSION "1", index_path);
+    }
+    FuriString* line = furi_string_alloc();
+    uint64_t* chunk = malloc(KEYS_DICT_INDEX_SORT_CHUNK * sizeof(uint64_t));
+    KeysDictIndexWriter* writer = malloc(sizeof(KeysDictIndexWriter));
+    writer->file = storage_file_alloc(instance->storage);
+    File* run_file = storage_file_alloc(instance->storage);
+
+    KeysDictIndexHeader header = {
+        .version = KEYS_DICT_INDEX_VERSION,
+        .key_size = instance->key_size,
+        .bloom_hashes = KEYS_DICT_BLOOM_HASHES,
+        .source_size = source_size,
+        .source_timestamp = source_timestamp,
+    };
+
+    bool files_open = false;
+    bool success = true;
+    bool is_endfile = false;
+    size_t chunk_len = 0;
+
+    // Count keys and write sorted runs of KEYS_DICT_INDEX_SORT_CHUNK keys
+    instance->total_keys = 0;
+    stream_rewind(instance->stream);
+    while(!is_endfile) {
+        if(keys_dict_read_key_line(instance, line, &is_endfile)) {
+            instance->total_keys++;
+            if(index_path) keys_dict_str_to_int(instance, line, &chunk[chunk_len++]);
+        }
+
+        if(!index_path) continue;
+        if(chunk_len < KEYS_DICT_INDEX_SORT_CHUNK && !(is_endfile && chunk_len)) continue;
+
+        if(!files_open) {
+            // Only possible at the end of a small dictionary
+            if(instance->total_keys < KEYS_DICT_INDEX_MIN_KEYS) break;
+
+            files_open = true;
+            writer->ok = true;
+            writer->len = 0;
+            success = storage_file_open(
+                          writer->file, index_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS) &&
+                      storage_file_write(writer->file, &header, sizeof(header)) ==
+                          sizeof(header) &&
+                      storage_file_open(
+                          run_file,
+                          furi_string_get_cstr(run_path[0]),
+                          FSAM_WRITE,
+                          FSOM_CREATE_ALWAYS);
+        }
+
+        if(success) {
+            success = keys_dict_index_write_chunk(instance, writer, run_file, chunk, chunk_len);
+        }
+        chunk_len = 0;
+    }
+    stream_rewind(instance->stream);
+    storage_file_close(run_file);
+    storage_file_free(run_file);
+    free(chunk);
+    furi_string_free(line);
+
+    if(files_open) {
+        // Merge runs until there is only one left
+        size_t src = 0;
+        for(uint32_t run_len = KEYS_DICT_INDEX_SORT_CHUNK;
+            success && run_len < instance->total_keys;
+            run_len *= 2) {
+            success = keys_dict_index_merge_pass(
+                instance->storage,
+                furi_string_get_cstr(run_path[src]),
+                furi_string_get_cstr(run_path[src ^ 1]),
+                instance->total_keys,
+                run_len);
+            src ^= 1;
+        }
+
+        header.total_keys = instance->total_keys;
+        header.bloom_size = keys_dict_bloom_get_size(instance->total_keys);
+        success = success && keys_dict_index_finalize(
+                                 instance, writer, furi_string_get_cstr(run_path[src]), &header);
+
+        storage_file_close(writer->file);
+        if(!success) {
+            FURI_LOG_W(TAG, "Failed to build index");
+            storage_common_remove(instance->storage, index_path);
+        }
+        storage_common_remove(instance->storage, furi_string_get_cstr(run_path[0]));
+        storage_common_remove(instance->storage, furi_string_get_cstr(run_path[1]));
+    }
+
+    storage_file_free(writer->file);
+    free(writer);
+    furi_string_free(run_path[0]);
+    furi_string_free(run_path[1]);
+
+    return files_open && success;
+}
+
+static bool keys_dict_index_open(
+    KeysDict* instance,
+    const char* index_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    KeysDictIndex* index = malloc(sizeof(KeysDictIndex));
+    index->file = storage_file_alloc(instance->storage);
+    KeysDictIndexHeader header;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(index->file, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(index->file, &header, sizeof(header)) != sizeof(header)) break;
+
+        if(header.magic != KEYS_DICT_INDEX_MAGIC || header.version != KEYS_DICT_INDEX_VERSION ||
+           header.key_size != instance->key_size ||
+           header.bloom_hashes != KEYS_DICT_BLOOM_HASHES ||
+           header.source_size != source_size || header.source_timestamp != source_timestamp)
+            break;
+        if(header.bloom_size != keys_dict_bloom_get_size(header.total_keys)) break;
+
+        const uint32_t bloom_offset = sizeof(header) + 2 * header.total_keys * header.key_size;
+        if(storage_file_size(index->file) != bloom_offset + header.bloom_size) break;
+
+        index->bloom = malloc(header.bloom_size);
+        if(!storage_file_seek(index->file, bloom_offset, true) ||
+           storage_file_read(index->file, index->bloom, header.bloom_size) != header.bloom_size)
+            break;
+
+        index->bloom_mask = header.bloom_size * 8 - 1;
+        instance->total_keys = header.total_keys;
+        instance->index = index;
+        success = true;
+    } while(false);
+
+    if(!success) {
+        free(index->bloom);
+        storage_file_close(index->file);
+        storage_file_free(index->file);
+        free(index);
+    }
+
+    return success;
+}
+
+// Switches the instance back to the text dictionary, keeping the read position
+static void keys_dict_index_close(KeysDict* instance) {
+    KeysDictIndex* index = instance->index;
+    if(!index) return;
+
+    FuriString* line = furi_string_alloc();
+    bool is_endfile = false;
+
+    stream_rewind(instance->stream);
+    for(uint32_t skipped = 0; skipped < index->next_key && !is_endfile;) {
+        if(keys_dict_read_key_line(instance, line, &is_endfile)) skipped++;
+    }
+    furi_string_free(line);
+
+    storage_file_close(index->file);
+    storage_file_free(index->file);
+    free(index->bloom);
+    free(index);
+    instance->index = NULL;
+}
+
+static bool keys_dict_index_get_next_key(KeysDict* instance, uint8_t* key) {
+    KeysDictIndex* index = instance->index;
+
+    if(index->buffer_pos == index->buffer_len) {
+        if(index->next_key >= instance->total_keys) return false;
+
+        const uint32_t left = instance->total_keys - index->next_key;
+        const uint32_t count = MIN(KEYS_DICT_INDEX_IO_KEYS, left);
+        const size_t size = count * instance->key_size;
+        const uint32_t offset =
+            sizeof(KeysDictIndexHeader) + index->next_key * instance->key_size;
+
+        if(!storage_file_seek(index->file, offset, true) ||
+           storage_file_read(index->file, index->buffer, size) != size)
+            return false;
+
+        index->buffer_pos = 0;
+        index->buffer_len = count;
+    }
+
+    memcpy(key, &index->buffer[index->buffer_pos * instance->key_size], instance->key_size);
+    index->buffer_pos++;
+    index->next_key++;
+
+    return true;
+}
+
+static bool keys_dict_index_is_key_present(KeysDict* instance, const uint8_t* key) {
+    KeysDictIndex* index = instance->index;
+    const uint64_t key_int = keys_dict_key_to_int(key, instance->key_size);
+
+    if(!keys_dict_bloom_check(index->bloom, index->bloom_mask, key_int)) return false;
+
+    // Binary search in the sorted keys
+    const uint32_t sorted_offset =
+        sizeof(KeysDictIndexHeader) + instance->total_keys * instance->key_size;
+    uint32_t low = 0;
+    uint32_t high = instance->total_keys;
+    uint8_t mid_key[sizeof(uint64_t)];
+
+    while(low < high) {
+        const uint32_t mid = low + (high - low) / 2;
+        if(!storage_file_seek(index->file, sorted_offset + mid * instance->key_size, true) ||
+           storage_file_read(index->file, mid_key, instance->key_size) != instance->key_size)
+            break;
+
+        const uint64_t mid_int = keys_dict_key_to_int(mid_key, instance->key_size);
+        if(mid_int == key_int) {
+            return true;
+        } else if(mid_int < key_int) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
 bool keys_dict_check_presence(const char* path) {
     furi_check(path);
 
@@ -70,11 +647,9 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
 
     KeysDict* instance = malloc(sizeof(KeysDict));
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    instance->stream = buffered_file_stream_alloc(storage);
-
-    FS_OpenMode open_mode = (mode == KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
-                                                               FSOM_OPEN_EXISTING;
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->stream = buffered_file_stream_alloc(instance->storage);
+    instance->path = furi_string_alloc_set(path);
 
     // Byte = 2 symbols + 1 end of line
     instance->key_size = key_size;
@@ -82,32 +657,45 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
 
     instance->total_keys = 0;
 
+    // Only open for writing when the file has to be created, keys are mostly read
     bool file_exists =
-        buffered_file_stream_open(instance->stream, path, FSAM_READ_WRITE, open_mode);
+        buffered_file_stream_open(instance->stream, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    if(!file_exists && mode == KeysDictModeOpenAlways) {
+        buffered_file_stream_close(instance->stream);
+        file_exists =
+            buffered_file_stream_open(instance->stream, path, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS);
+        instance->writable = file_exists;
+    }
 
     if(!file_exists) {
         buffered_file_stream_close(instance->stream);
     } else {
         // Eventually add new line character in the last line to avoid skipping keys
         keys_dict_add_ending_new_line(instance);
-    }
-
-    FuriString* line = furi_string_alloc();
 
-    bool is_endfile = false;
-
-    // In this loop we only count the entries in the file
-    // We prefer not to load the whole file in memory for space reasons
-    while(file_exists && !is_endfile) {
-        bool read_key = keys_dict_read_key_line(instance, line, &is_endfile);
-        if(read_key) {
-            instance->total_keys++;
+        // Use compiled index if it is up to date, otherwise rebuild it.
+        // Building also counts the keys, which is all that small dictionaries need.
+        FuriString* index_path = furi_string_alloc_printf("%s" KEYS_DICT_INDEX_EXTENSION, path);
+        const char* index_path_str = furi_string_get_cstr(index_path);
+        uint32_t source_size = 0, source_timestamp = 0;
+
+        if(!keys_dict_get_source_info(instance, path, &source_size, &source_timestamp)) {
+            // Index can't be validated, only count the keys
+            keys_dict_index_build(instance, NULL, 0, 0);
+        } else if(
+            !keys_dict_index_open(instance, index_path_str, source_size, source_timestamp) &&
+            keys_dict_index_build(instance, index_path_str, source_size, source_timestamp)) {
+            keys_dict_index_open(instance, index_path_str, source_size, source_timestamp);
         }
+
+        furi_string_free(index_path);
     }
-    stream_rewind(instance->stream);
-    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
 
-    furi_string_free(line);
+    FURI_LOG_I(
+        TAG,
+        "Loaded dictionary with %zu keys%s",
+        instance->total_keys,
+        instance->index ? " from index" : "");
 
     return instance;
 }
@@ -116,8 +704,10 @@ void keys_dict_free(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    keys_dict_index_close(instance);
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
+    furi_string_free(instance->path);
     free(instance);
 
     furi_record_close(RECORD_STORAGE);
@@ -163,6 +753,13 @@ bool keys_dict_rewind(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->index) {
+        instance->index->next_key = 0;
+        instance->index->buffer_pos = 0;
+        instance->index->buffer_len = 0;
+        return true;
+    }
+
     return stream_rewind(instance->stream);
 }
 
@@ -188,23 +785,20 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
-    FuriString* temp_key = furi_string_alloc();
+    if(instance->index) return keys_dict_index_get_next_key(instance, key);
+
+    FuriString* temp_key = furi_string_scratch_alloc();
 
     bool key_read = keys_dict_get_next_key_str(instance, temp_key);
 
     if(key_read) {
-        size_t tmp_len = key_size;
         uint64_t key_int = 0;
 
         keys_dict_str_to_int(instance, temp_key, &key_int);
-
-        while(tmp_len--) {
-            key[tmp_len] = (uint8_t)key_int;
-            key_int >>= 8;
-        }
+        keys_dict_int_to_key(key_int, key, key_size);
     }
 
-    furi_string_free(temp_key);
+    furi_string_scratch_free(temp_key);
     return key_read;
 }
 
@@ -213,7 +807,7 @@ static bool keys_dict_is_key_present_str(KeysDict* instance, FuriString* key) {
     furi_assert(instance->stream);
     furi_assert(key);
 
-    FuriString* line = furi_string_alloc();
+    FuriString* line = furi_string_scratch_alloc();
 
     bool is_endfile = false;
     bool line_found = false;
@@ -226,7 +820,7 @@ static bool keys_dict_is_key_present_str(KeysDict* instance, FuriString* key) {
             (keys_dict_read_key_line(instance, line, &is_endfile)) &&
             (furi_string_equal(key, line));
 
-    furi_string_free(line);
+    furi_string_scratch_free(line);
 
     // Restore the position of the stream
     stream_seek(instance->stream, actual_pos, StreamOffsetFromStart);
@@ -240,11 +834,13 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
-    FuriString* temp_key = furi_string_alloc();
+    if(instance->index) return keys_dict_index_is_key_present(instance, key);
+
+    FuriString* temp_key = furi_string_scratch_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
     bool key_found = keys_dict_is_key_present_str(instance, temp_key);
-    furi_string_free(temp_key);
+    furi_string_scratch_free(temp_key);
 
     return key_found;
 }
@@ -277,6 +873,10 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    // Index goes stale, it is rebuilt on next alloc
+    keys_dict_index_close(instance);
+    if(!keys_dict_make_writable(instance)) return false;
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
@@ -297,6 +897,9 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
 
     bool key_removed = false;
 
+    keys_dict_index_close(instance);
+    if(!keys_dict_make_writable(instance)) return false;
+
     uint8_t* temp_key = malloc(key_size);
 
     stream_rewind(instance->stream);
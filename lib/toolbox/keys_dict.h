@@ -25,6 +25,10 @@ bool keys_dict_check_presence(const char* path);
 
 /** Open or create list
  * Depending on mode, list will be opened or created.
+ * Large lists are compiled into a sorted binary index with a bloom filter, stored
+ * next to the list with .kdx extension. The index is rebuilt when the list changes.
+ * Adding or deleting keys switches the instance back to plain text access.
+ * The list is opened read only until it is created or modified.
  *
  * @param path      - Path of the file that contain the list
  * @param mode      - ListKeysMode value
@@ -2,10 +2,14 @@
 #include "stream_i.h"
 #include "file_stream.h"
 
+#define FILE_STREAM_TEMP_EXT ".tmp"
+
 typedef struct {
     Stream stream_base;
     Storage* storage;
     File* file;
+    FuriString* path;
+    FS_AccessMode access_mode;
 } FileStream;
 
 static void file_stream_free(FileStream* stream);
@@ -34,12 +38,32 @@ const StreamVTable file_stream_vtable = {
     .delete_and_insert = (StreamDeleteAndInsertFn)file_stream_delete_and_insert,
 };
 
+static bool file_stream_file_open(FileStream* stream, FS_OpenMode open_mode) {
+    const char* path = furi_string_get_cstr(stream->path);
+    bool result = storage_file_open(stream->file, path, stream->access_mode, open_mode);
+
+    // Power was lost between removing the file and renaming its rewritten copy, finish the job
+    if(!result && open_mode == FSOM_OPEN_EXISTING &&
+       storage_file_get_error(stream->file) == FSE_NOT_EXIST) {
+        FuriString* temp_path = furi_string_alloc_printf("%s" FILE_STREAM_TEMP_EXT, path);
+        if(storage_common_rename(stream->storage, furi_string_get_cstr(temp_path), path) ==
+           FSE_OK) {
+            storage_file_close(stream->file);
+            result = storage_file_open(stream->file, path, stream->access_mode, open_mode);
+        }
+        furi_string_free(temp_path);
+    }
+
+    return result;
+}
+
 Stream* file_stream_alloc(Storage* storage) {
     furi_check(storage);
 
     FileStream* stream = malloc(sizeof(FileStream));
     stream->file = storage_file_alloc(storage);
     stream->storage = storage;
+    stream->path = furi_string_alloc();
 
     stream->stream_base.vtable = &file_stream_vtable;
     return (Stream*)stream;
@@ -53,7 +77,11 @@ bool file_stream_open(
     furi_check(_stream);
     FileStream* stream = (FileStream*)_stream;
     furi_check(stream->stream_base.vtable == &file_stream_vtable);
-    return storage_file_open(stream->file, path, access_mode, open_mode);
+
+    furi_string_set(stream->path, path);
+    stream->access_mode = access_mode;
+
+    return file_stream_file_open(stream, open_mode);
 }
 
 bool file_stream_close(Stream* _stream) {
@@ -72,6 +100,7 @@ FS_Error file_stream_get_error(Stream* _stream) {
 
 static void file_stream_free(FileStream* stream) {
     storage_file_free(stream->file);
+    furi_string_free(stream->path);
     free(stream);
 }
 
@@ -143,6 +172,11 @@ static size_t file_stream_read(FileStream* stream, uint8_t* data, size_t size) {
     return storage_file_read(stream->file, data, size);
 }
 
+/*
+ * The result is written to a temporary file next to the original one, which then replaces
+ * the original. Data is copied once, and if power is lost in the process either the old
+ * or the new file content survives.
+ */
 static bool file_stream_delete_and_insert(
     FileStream* _stream,
     size_t delete_size,
@@ -151,24 +185,17 @@ static bool file_stream_delete_and_insert(
     bool result = false;
     Stream* stream = (Stream*)_stream;
 
-    // open scratchpad
-    Stream* scratch_stream = file_stream_alloc(_stream->storage);
-
-    // TODO FL-3546: we need something like "storage_open_tmpfile and storage_close_tmpfile"
-    FuriString* scratch_name;
-    FuriString* tmp_name;
-    tmp_name = furi_string_alloc();
-    storage_get_next_filename(
-        _stream->storage, STORAGE_ANY_PATH_PREFIX, ".scratch", ".pad", tmp_name, 255);
-    scratch_name = furi_string_alloc_printf(ANY_PATH("%s.pad"), furi_string_get_cstr(tmp_name));
-    furi_string_free(tmp_name);
+    Stream* temp_stream = file_stream_alloc(_stream->storage);
+    FuriString* temp_path =
+        furi_string_alloc_printf("%s" FILE_STREAM_TEMP_EXT, furi_string_get_cstr(_stream->path));
+    const char* path = furi_string_get_cstr(_stream->path);
+    size_t new_position = 0;
+    bool renamed = false;
+    bool keep_temp = false;
 
     do {
         if(!file_stream_open(
-               scratch_stream,
-               furi_string_get_cstr(scratch_name),
-               FSAM_READ_WRITE,
-               FSOM_CREATE_NEW))
+               temp_stream, furi_string_get_cstr(temp_path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
             break;
 
         size_t current_position = stream_tell(stream);
@@ -180,28 +207,31 @@ static bool file_stream_delete_and_insert(
         size_t size_to_copy_before = current_position;
         size_t size_to_copy_after = file_size - current_position - size_to_delete;
 
-        // copy file from 0 to insert position to scratchpad
+        // copy file from 0 to insert position to temp file
         if(!stream_rewind(stream)) break;
-        if(stream_copy(stream, scratch_stream, size_to_copy_before) != size_to_copy_before) break;
+        if(stream_copy(stream, temp_stream, size_to_copy_before) != size_to_copy_before) break;
 
         if(write_callback) {
-            if(!write_callback(scratch_stream, ctx)) break;
+            if(!write_callback(temp_stream, ctx)) break;
         }
-        size_t new_position = stream_tell(scratch_stream);
+        new_position = stream_tell(temp_stream);
 
-        // copy key file after insert position + size_to_delete to scratchpad
+        // copy file after insert position + size_to_delete to temp file
         if(!stream_seek(stream, size_to_delete, StreamOffsetFromCurrent)) break;
-        if(stream_copy(stream, scratch_stream, size_to_copy_after) != size_to_copy_after) break;
+        if(stream_copy(stream, temp_stream, size_to_copy_after) != size_to_copy_after) break;
 
-        size_t new_file_size = stream_size(scratch_stream);
-
-        // copy whole scratchpad file to the original file
-        if(!stream_rewind(stream)) break;
-        if(!stream_rewind(scratch_stream)) break;
-        if(stream_copy(scratch_stream, stream, new_file_size) != new_file_size) break;
+        if(!file_stream_close(temp_stream)) break;
 
-        // and truncate original file
-        if(!storage_file_truncate(_stream->file)) break;
+        // replace the original file, it has to be closed for that
+        storage_file_close(_stream->file);
+        renamed = storage_common_rename(
+                      _stream->storage, furi_string_get_cstr(temp_path), path) == FSE_OK;
+        if(!file_stream_file_open(_stream, FSOM_OPEN_EXISTING)) {
+            // the temp file may be the only copy left
+            keep_temp = true;
+            break;
+        }
+        if(!renamed) break;
 
         // move seek pointer at insert end
         if(!stream_seek(stream, new_position, StreamOffsetFromStart)) break;
@@ -209,9 +239,11 @@ static bool file_stream_delete_and_insert(
         result = true;
     } while(false);
 
-    stream_free(scratch_stream);
-    storage_common_remove(_stream->storage, furi_string_get_cstr(scratch_name));
-    furi_string_free(scratch_name);
+    stream_free(temp_stream);
+    if(!renamed && !keep_temp) {
+        storage_common_remove(_stream->storage, furi_string_get_cstr(temp_path));
+    }
+    furi_string_free(temp_path);
 
     return result;
 }
@@ -20,6 +20,9 @@ Stream* file_stream_alloc(Storage* storage);
  * @param access_mode access mode from FS_AccessMode 
  * @param open_mode open mode from FS_OpenMode 
  * @return success flag. You need to close the file even if the open operation failed.
+ * 
+ * Deletions and insertions rewrite the file into "<path>.tmp" and replace the original with it.
+ * If the original is missing and the temp file exists, FSOM_OPEN_EXISTING restores it.
  */
 bool file_stream_open(
     Stream* stream,
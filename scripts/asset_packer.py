@@ -45,62 +45,104 @@ def convert_bmx(img: "Image.Image | pathlib.Path") -> bytes:
     return data
 
 
-def pack_anim(src: pathlib.Path, dst: pathlib.Path):
+BMA_MAGIC = 0x31414D42
+BMA_VERSION = 1
+BMA_STREAM_WINDOW = 4
+HEAP_BLOCK_OVERHEAD = 8
+
+
+def pack_anim(src: pathlib.Path, dst: pathlib.Path) -> "tuple[int, int, int] | None":
+    """Pack animation folder into a single .bma file
+
+    Layout: header, frame_count + 1 absolute frame offsets, meta.txt, frames.
+    Returns frame count and estimated firmware heap use for frame folder and .bma,
+    or None if there is no animation.
+    """
     if not (src / "meta.txt").is_file():
-        return
-    dst.mkdir(parents=True, exist_ok=True)
-    for frame in src.iterdir():
-        if not frame.is_file():
-            continue
-        if frame.name == "meta.txt":
-            shutil.copyfile(frame, dst / frame.name)
-        elif frame.name.startswith("frame_"):
-            if frame.suffix == ".png":
-                (dst / frame.with_suffix(".bm").name).write_bytes(convert_bm(frame))
-            elif frame.suffix == ".bm":
-                if not (dst / frame.name).is_file():
-                    shutil.copyfile(frame, dst / frame.name)
+        return None
+    meta = (src / "meta.txt").read_bytes()
+    width = int(re.search(rb"Width: *(\d+)", meta).group(1))
+    height = int(re.search(rb"Height: *(\d+)", meta).group(1))
+
+    frames = []
+    while True:
+        frame = src / f"frame_{len(frames)}"
+        if frame.with_suffix(".png").is_file():
+            frames.append(convert_bm(frame.with_suffix(".png")))
+        elif frame.with_suffix(".bm").is_file():
+            frames.append(frame.with_suffix(".bm").read_bytes())
+        else:
+            break
+    if not frames:
+        raise Exception(f"No frames in '{src}'")
+
+    data = struct.pack(
+        "<IBBBBH", BMA_MAGIC, BMA_VERSION, width, height, len(frames), len(meta)
+    )
+    offset = len(data) + 4 * (len(frames) + 1) + len(meta)
+    offsets = [offset]
+    for frame in frames:
+        offset += len(frame)
+        offsets.append(offset)
+    data += struct.pack(f"<{len(offsets)}I", *offsets) + meta + b"".join(frames)
+
+    dst.parent.mkdir(parents=True, exist_ok=True)
+    dst.write_bytes(data)
+
+    frames_heap = sum(len(frame) + HEAP_BLOCK_OVERHEAD for frame in frames)
+    frames_heap += 4 * len(frames) + HEAP_BLOCK_OVERHEAD
+    max_frame_size = (width + 7) // 8 * height + 1
+    if sum(len(frame) for frame in frames) > BMA_STREAM_WINDOW * max_frame_size:
+        packed_heap = BMA_STREAM_WINDOW * (max_frame_size + HEAP_BLOCK_OVERHEAD)
+    else:
+        packed_heap = frames_heap
+    packed_heap += 4 * len(offsets) + HEAP_BLOCK_OVERHEAD
+    return len(frames), frames_heap, packed_heap
 
 
-def pack_icon_animated(src: pathlib.Path, dst: pathlib.Path):
+APK_MAGIC = 0x314B5041
+APK_VERSION = 1
+APK_NAME = "assets.pak"
+
+
+def load_icon_animated(
+    src: pathlib.Path,
+) -> "tuple[int, int, int, list[bytes]] | None":
     if not (src / "frame_rate").is_file() and not (src / "meta").is_file():
-        return
-    dst.mkdir(parents=True, exist_ok=True)
-    frame_count = 0
-    frame_rate = None
+        return None
     size = None
+    frame_rate = None
+    if (src / "meta").is_file():
+        *size, frame_rate, _ = struct.unpack("<IIII", (src / "meta").read_bytes()[:16])
+    if (src / "frame_rate").is_file():
+        frame_rate = int((src / "frame_rate").read_text())
+    frames = {}
     for frame in src.iterdir():
-        if not frame.is_file():
+        if not frame.is_file() or not frame.name.startswith("frame_"):
             continue
-        if frame.name == "frame_rate":
-            frame_rate = int(frame.read_text())
-        elif frame.name == "meta":
-            shutil.copyfile(frame, dst / frame.name)
-        elif frame.name.startswith("frame_"):
-            if frame.suffix == ".png":
-                if not size:
-                    size = Image.open(frame).size
-                (dst / frame.with_suffix(".bm").name).write_bytes(convert_bm(frame))
-                frame_count += 1
-            elif frame.suffix == ".bm":
-                if not (dst / frame.name).is_file():
-                    shutil.copyfile(frame, dst / frame.name)
-                    frame_count += 1
-    if size is not None and frame_rate is not None:
-        (dst / "meta").write_bytes(struct.pack("<IIII", *size, frame_rate, frame_count))
-
-
-def pack_icon_static(src: pathlib.Path, dst: pathlib.Path):
-    dst.parent.mkdir(parents=True, exist_ok=True)
+        index = frame.stem.removeprefix("frame_")
+        if not index.isdigit():
+            continue
+        if frame.suffix == ".png":
+            if not size:
+                size = Image.open(frame).size
+            frames[int(index)] = convert_bm(frame)
+        elif frame.suffix == ".bm":
+            frames.setdefault(int(index), frame.read_bytes())
+    if not size or frame_rate is None or not frames:
+        return None
+    return *size, frame_rate, [frames[index] for index in sorted(frames)]
+
+
+def load_icon_static(src: pathlib.Path) -> "tuple[int, int, int, list[bytes]]":
     if src.suffix == ".png":
-        dst.with_suffix(".bmx").write_bytes(convert_bmx(src))
-    elif src.suffix == ".bmx":
-        if not dst.is_file():
-            shutil.copyfile(src, dst)
+        img = Image.open(src)
+        return *img.size, 0, [convert_bm(img)]
+    data = src.read_bytes()
+    return *struct.unpack("<II", data[:8]), 0, [data[8:]]
 
 
-def pack_font(src: pathlib.Path, dst: pathlib.Path):
-    dst.parent.mkdir(parents=True, exist_ok=True)
+def load_font(src: pathlib.Path) -> bytes:
     if src.suffix == ".c":
         code = (
             src.read_bytes().split(b' U8G2_FONT_SECTION("')[1].split(b'") =')[1].strip()
@@ -113,10 +155,60 @@ def pack_font(src: pathlib.Path, dst: pathlib.Path):
                     .decode("unicode_escape")
                     .encode("latin_1")
                 )
-        dst.with_suffix(".u8f").write_bytes(font)
-    elif src.suffix == ".u8f":
-        if not dst.is_file():
-            shutil.copyfile(src, dst)
+        return font
+    return src.read_bytes()
+
+
+def pack_archive(
+    icons: "dict[str, tuple[int, int, int, list[bytes]]]",
+    fonts: "dict[str, bytes]",
+    dst: pathlib.Path,
+):
+    """Pack icons and fonts into a single indexed archive
+
+    Layout: header, entries sorted by name, names, data. Icon data is frame_count + 1
+    offsets relative to icon data, then frames. Font entries have no frames, data is
+    the .u8f font. Firmware reads the index at boot and loads data on first use.
+    """
+    items = {}
+    for name, (width, height, frame_rate, frames) in icons.items():
+        if len(frames) > 255 or frame_rate > 255:
+            raise Exception(f"Too many frames or frame rate too high in '{name}'")
+        offsets = [4 * (len(frames) + 1)]
+        for frame in frames:
+            offsets.append(offsets[-1] + len(frame))
+        data = struct.pack(f"<{len(offsets)}I", *offsets) + b"".join(frames)
+        items[name.encode()] = (width, height, len(frames), frame_rate, data)
+    for name, font in fonts.items():
+        items[f"Fonts/{name}".encode()] = (0, 0, 0, 0, font)
+
+    names = b""
+    name_offsets = {}
+    for name in sorted(items):
+        name_offsets[name] = len(names)
+        names += name + b"\0"
+
+    header = struct.pack("<IBBHI", APK_MAGIC, APK_VERSION, 0, len(items), len(names))
+    offset = len(header) + struct.calcsize("<IIIHHBBH") * len(items) + len(names)
+    index = b""
+    data = b""
+    for name in sorted(items):
+        width, height, frame_count, frame_rate, blob = items[name]
+        index += struct.pack(
+            "<IIIHHBBH",
+            name_offsets[name],
+            offset + len(data),
+            len(blob),
+            width,
+            height,
+            frame_count,
+            frame_rate,
+            0,
+        )
+        data += blob
+
+    dst.parent.mkdir(parents=True, exist_ok=True)
+    dst.write_bytes(header + index + names + data)
 
 
 def pack(
@@ -157,29 +249,39 @@ def pack(
                     .strip()
                 )
                 logger(f"Compile: anim for pack '{source.name}': {anim}")
-                pack_anim(source / "Anims" / anim, packed / "Anims" / anim)
+                stats = pack_anim(
+                    source / "Anims" / anim, packed / "Anims" / f"{anim}.bma"
+                )
+                if stats:
+                    frames, frames_heap, packed_heap = stats
+                    logger(
+                        f"Packed: {frames + 1} files -> 1, "
+                        f"est. heap {frames_heap} -> {packed_heap} bytes"
+                    )
 
+        icons = {}
+        fonts = {}
+        files = 0
         if (source / "Icons").is_dir():
-            for icons in (source / "Icons").iterdir():
-                if not icons.is_dir() or icons.name.startswith("."):
+            for folder in (source / "Icons").iterdir():
+                if not folder.is_dir() or folder.name.startswith("."):
                     continue
-                for icon in icons.iterdir():
+                for icon in folder.iterdir():
                     if icon.name.startswith("."):
                         continue
                     if icon.is_dir():
-                        logger(
-                            f"Compile: icon for pack '{source.name}': {icons.name}/{icon.name}"
-                        )
-                        pack_icon_animated(
-                            icon, packed / "Icons" / icons.name / icon.name
-                        )
+                        name = f"{folder.name}/{icon.name}"
+                        logger(f"Compile: icon for pack '{source.name}': {name}")
+                        if loaded := load_icon_animated(icon):
+                            icons[name] = loaded
+                            files += len(loaded[3]) + 1
                     elif icon.is_file() and icon.suffix in (".png", ".bmx"):
-                        logger(
-                            f"Compile: icon for pack '{source.name}': {icons.name}/{icon.name}"
-                        )
-                        pack_icon_static(
-                            icon, packed / "Icons" / icons.name / icon.name
-                        )
+                        name = f"{folder.name}/{icon.stem}"
+                        logger(f"Compile: icon for pack '{source.name}': {name}")
+                        # Prefer .png over .bmx with same name
+                        if name not in icons or icon.suffix == ".png":
+                            files += name not in icons
+                            icons[name] = load_icon_static(icon)
 
         if (source / "Fonts").is_dir():
             for font in (source / "Fonts").iterdir():
@@ -190,8 +292,14 @@ def pack(
                 ):
                     continue
                 logger(f"Compile: font for pack '{source.name}': {font.name}")
-                pack_font(font, packed / "Fonts" / font.name)
+                # Prefer .c over .u8f with same name
+                if font.stem not in fonts or font.suffix == ".c":
+                    files += font.stem not in fonts
+                    fonts[font.stem] = load_font(font)
 
+        if icons or fonts:
+            pack_archive(icons, fonts, packed / APK_NAME)
+            logger(f"Packed: {files} icon and font files -> {APK_NAME}")
 
 if __name__ == "__main__":
     input(
@@ -4,7 +4,9 @@ import logging
 import math
 import os
 import posixpath
+import struct
 import sys
+import tempfile
 import time
 
 import serial
@@ -29,6 +31,92 @@ def timing(func):
     return wrapper
 
 
+DELTA_SYNC_MAGIC = b"DSYN"
+
+
+def delta_sync_checksum(data: bytes) -> int:
+    """Rolling checksum of a block, same as lib/toolbox/delta_sync.c"""
+    a = sum(data) & 0xFFFF
+    b = sum((len(data) - i) * byte for i, byte in enumerate(data)) & 0xFFFF
+    return a | (b << 16)
+
+
+def delta_sync_checksum_roll(
+    checksum: int, block_size: int, byte_out: int, byte_in: int
+) -> int:
+    a = ((checksum & 0xFFFF) - byte_out + byte_in) & 0xFFFF
+    b = ((checksum >> 16) - block_size * byte_out + a) & 0xFFFF
+    return a | (b << 16)
+
+
+def delta_sync_make(
+    data: bytes, signature: list, block_size: int, original_size: int
+) -> bytes:
+    """Make delta that turns file with given block signature into data"""
+    blocks = {}
+    for index, (checksum, md5) in enumerate(signature):
+        blocks.setdefault(checksum, []).append((index, md5))
+
+    delta = bytearray(DELTA_SYNC_MAGIC + struct.pack("<I", block_size))
+    literal_start = 0
+    copy_first, copy_count = 0, 0
+
+    def flush(literal_end: int):
+        nonlocal copy_count
+        if copy_count:
+            delta.extend(b"C" + struct.pack("<II", copy_first, copy_count))
+            copy_count = 0
+        if literal_end > literal_start:
+            literal = data[literal_start:literal_end]
+            delta.extend(b"L" + struct.pack("<I", len(literal)) + literal)
+
+    def add_copy(position: int, index: int):
+        nonlocal copy_first, copy_count, literal_start
+        if position > literal_start or copy_first + copy_count != index:
+            flush(position)
+            copy_first = index
+        copy_count += 1
+
+    def find_block(checksum: int, block: bytes):
+        candidates = blocks.get(checksum)
+        if candidates:
+            md5 = hashlib.md5(block).hexdigest()
+            for index, block_md5 in candidates:
+                if block_md5 == md5:
+                    return index
+        return None
+
+    position, checksum = 0, None
+    while position + block_size <= len(data):
+        block = data[position : position + block_size]
+        if checksum is None:
+            checksum = delta_sync_checksum(block)
+        index = find_block(checksum, block)
+        if index is not None:
+            add_copy(position, index)
+            position += block_size
+            literal_start = position
+            checksum = None
+            continue
+        if position + block_size < len(data):
+            checksum = delta_sync_checksum_roll(
+                checksum, block_size, data[position], data[position + block_size]
+            )
+        position += 1
+
+    # Last block of original file may be shorter than block size
+    tail_size = original_size % block_size
+    tail_start = len(data) - tail_size
+    if signature and tail_size and tail_start >= literal_start:
+        tail = data[tail_start:]
+        if find_block(delta_sync_checksum(tail), tail) == len(signature) - 1:
+            add_copy(tail_start, len(signature) - 1)
+            literal_start = len(data)
+
+    flush(len(data))
+    return bytes(delta)
+
+
 class StorageErrorCode(enum.Enum):
     OK = "OK"
     NOT_READY = "filesystem not ready"
@@ -91,6 +179,7 @@ class BufferedRead:
 class FlipperStorage:
     CLI_PROMPT = ">: "
     CLI_EOL = "\r\n"
+    DELTA_SYNC_BLOCK_SIZE = 1024
 
     def __init__(self, portname: str, chunk_size: int = 8192):
         self.port = serial.Serial()
@@ -403,6 +492,55 @@ class FlipperStorage:
         self._check_no_error(hash, filename)
         return hash.decode("ascii")
 
+    def signature_flipper(self, filename: str, block_size: int):
+        """Get rolling checksum and md5 of every block of file on Flipper"""
+        self.send_and_wait_eol(f'storage signature "{filename}" {block_size}\r')
+        data = self.read.until(self.CLI_PROMPT)
+        lines = data.split(self.CLI_EOL.encode("ascii"))
+        self._check_no_error(lines[0], filename)
+
+        signature = []
+        for line in lines:
+            line = line.decode("ascii").strip()
+            if len(line) == 0:
+                continue
+            checksum, md5 = line.split(" ")
+            signature.append((int(checksum, 16), md5))
+        return signature
+
+    def patch(self, filename: str, delta_filename: str):
+        """Apply delta file to file on Flipper"""
+        self.send_and_wait_eol(f'storage patch "{filename}" "{delta_filename}"\r')
+        response = self.read.until(self.CLI_EOL)
+        self.read.until(self.CLI_PROMPT)
+        self._check_no_error(response, filename)
+
+    def send_file_delta(self, filename_from: str, filename_to: str):
+        """Update existing file on Flipper sending only changed blocks.
+        Returns False if delta is not worth it, file is left untouched then."""
+        with open(filename_from, "rb") as file:
+            data = file.read()
+        if len(data) < self.DELTA_SYNC_BLOCK_SIZE * 4:
+            return False
+
+        block_size = self.DELTA_SYNC_BLOCK_SIZE
+        signature = self.signature_flipper(filename_to, block_size)
+        delta = delta_sync_make(data, signature, block_size, self.size(filename_to))
+        if len(delta) > len(data) // 2:
+            return False
+
+        delta_filename = filename_to + ".delta"
+        with tempfile.NamedTemporaryFile(delete=False) as delta_file:
+            delta_file.write(delta)
+        try:
+            self.send_file(delta_file.name, delta_filename)
+            self.patch(filename_to, delta_filename)
+        finally:
+            os.unlink(delta_file.name)
+            if self.exist_file(delta_filename):
+                self.remove(delta_filename)
+        return True
+
 
 class FlipperStorageOperations:
     def __init__(self, storage):
@@ -425,6 +563,12 @@ class FlipperStorageOperations:
 
         if do_upload:
             self.logger.info(f'Sending "{local_file_path}" to "{flipper_file_path}"')
+            if exists and self.storage.send_file_delta(
+                local_file_path, flipper_file_path
+            ):
+                if self.storage.hash_flipper(flipper_file_path) == hash_local:
+                    return
+                self.logger.warning("Delta update mismatch, sending whole file")
             self.storage.send_file(local_file_path, flipper_file_path)
 
     # make directory with exist check
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+
+import re
+import time
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+
+class Main(App):
+    LOADED_RE = re.compile(rb"Loaded in (\d+) ms, heap peak (\d+) bytes")
+    ROW_FORMAT = "{:<24}{:>10}{:>10}{:>12}{:>12}"
+    POST_STOP_DELAY_SEC = 0.2
+
+    def init(self):
+        self.parser.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser.add_argument(
+            "--path",
+            help="Directory with scripts on Flipper",
+            default="/ext/apps/Scripts/Examples",
+        )
+        self.parser.add_argument(
+            "--runs", type=int, default=3, help="Warm runs per script"
+        )
+        self.parser.add_argument(
+            "scripts",
+            nargs="*",
+            help="Script names to benchmark (default: all scripts in --path)",
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def run_script(self, storage: FlipperStorage, path: str):
+        storage.send_and_wait_eol(f'js "{path}"\r')
+        result = None
+        while True:
+            line = storage.read.until(storage.CLI_EOL)
+            if match := self.LOADED_RE.search(line):
+                result = (int(match.group(1)), int(match.group(2)))
+                break
+            if line.startswith(b"----") or line.startswith(b"Can not open"):
+                self.logger.warning(f"{path}: {line.decode('ascii', 'replace')}")
+                break
+
+        # Script may be waiting for input, we only care about the load stage
+        storage.send("\x03")
+        storage.read.until(storage.CLI_PROMPT)
+        time.sleep(self.POST_STOP_DELAY_SEC)
+        storage.port.reset_input_buffer()
+        storage.read.buffer.clear()
+        return result
+
+    def bench(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            return 1
+
+        with FlipperStorage(port) as storage:
+            scripts = self.args.scripts
+            if not scripts:
+                _, _, files = next(storage.walk(self.args.path))
+                scripts = sorted(name for name in files if name.endswith(".js"))
+
+            print(
+                self.ROW_FORMAT.format(
+                    "script", "cold ms", "warm ms", "cold heap", "warm heap"
+                )
+            )
+            for name in scripts:
+                path = f"{self.args.path}/{name}"
+                if storage.exist_file(path + "c"):
+                    storage.remove(path + "c")
+
+                cold = self.run_script(storage, path)
+                warm = [self.run_script(storage, path) for _ in range(self.args.runs)]
+                warm = [result for result in warm if result]
+                if not cold or not warm:
+                    continue
+
+                warm_ms = sum(result[0] for result in warm) // len(warm)
+                warm_heap = max(result[1] for result in warm)
+                print(
+                    self.ROW_FORMAT.format(name, cold[0], warm_ms, cold[1], warm_heap)
+                )
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
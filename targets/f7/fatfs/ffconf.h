@@ -75,7 +75,11 @@
 #endif
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
+#ifdef FURI_RAM_EXEC
 #define _USE_CHMOD 0
+#else
+#define _USE_CHMOD 1
+#endif
 /* This option switches attribute manipulation functions, f_chmod() and f_utime().
 /  (0:Disable or 1:Enable) Also _FS_READONLY needs to be 0 to enable this option. */
 
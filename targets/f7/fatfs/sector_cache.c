@@ -6,51 +6,510 @@
 #include <furi.h>
 #include <furi_hal_memory.h>
 
-#define SECTOR_SIZE 512
-#define N_SECTORS 8
+#define SECTOR_SIZE SECTOR_CACHE_SECTOR_SIZE
+#define SECTOR_NONE (0xFFFFFFFFUL)
+#define INDEX_NONE (0xFFFFU)
+
+#define ENTRY_FLAG_DIRTY (1U << 0)
+#define ENTRY_FLAG_READ_AHEAD (1U << 1)
+
+typedef enum {
+    SectorCacheQueueFree,
+    SectorCacheQueueIn, // A1in: FIFO of sectors seen once
+    SectorCacheQueueMain, // Am: LRU of sectors seen again after leaving A1in
+    SectorCacheQueueCount,
+} SectorCacheQueue;
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
-    uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
-} SectorCache;
+    uint32_t sector;
+    uint16_t prev;
+    uint16_t next;
+    uint16_t hash_next;
+    uint8_t queue;
+    uint8_t flags;
+} SectorCacheEntry;
+
+typedef struct {
+    uint16_t head;
+    uint16_t tail;
+    uint16_t size;
+} SectorCacheList;
+
+struct SectorCache {
+    SectorCacheConfig config;
+    SectorCacheReadCallback read_callback;
+    SectorCacheWriteCallback write_callback;
+    void* context;
+
+    uint8_t* data;
+    SectorCacheEntry* entries;
+    uint16_t* buckets;
+    uint16_t bucket_mask;
+    uint16_t* order;
+    SectorCacheList queues[SectorCacheQueueCount];
+    uint16_t in_target;
+    uint16_t dirty_count;
+
+    // A1out: sectors recently evicted from A1in, without data
+    uint32_t* ghosts;
+    uint16_t ghosts_size;
+    uint16_t ghosts_pos;
+
+    // Read ahead and flush buffer, separate from pool for DMA
+    uint8_t* io_buffer;
+    uint16_t io_sectors;
+
+    uint32_t next_sector;
+    uint32_t disk_sectors;
+    uint32_t write_back_start;
+    uint32_t write_back_end;
+
+    SectorCacheStats stats;
+};
+
+static inline uint8_t* sector_cache_entry_data(SectorCache* cache, uint16_t index) {
+    return &cache->data[(size_t)index * SECTOR_SIZE];
+}
+
+static void sector_cache_list_remove(SectorCache* cache, uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheList* list = &cache->queues[entry->queue];
+
+    if(entry->prev != INDEX_NONE) {
+        cache->entries[entry->prev].next = entry->next;
+    } else {
+        list->head = entry->next;
+    }
+
+    if(entry->next != INDEX_NONE) {
+        cache->entries[entry->next].prev = entry->prev;
+    } else {
+        list->tail = entry->prev;
+    }
+
+    list->size--;
+}
+
+static void sector_cache_list_push(SectorCache* cache, uint16_t index, SectorCacheQueue queue) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheList* list = &cache->queues[queue];
+
+    entry->queue = queue;
+    entry->prev = INDEX_NONE;
+    entry->next = list->head;
+
+    if(list->head != INDEX_NONE) {
+        cache->entries[list->head].prev = index;
+    } else {
+        list->tail = index;
+    }
+
+    list->head = index;
+    list->size++;
+}
+
+static uint16_t sector_cache_lookup(SectorCache* cache, uint32_t sector) {
+    uint16_t index = cache->buckets[sector & cache->bucket_mask];
+
+    while(index != INDEX_NONE && cache->entries[index].sector != sector) {
+        index = cache->entries[index].hash_next;
+    }
+
+    return index;
+}
+
+static void sector_cache_hash_remove(SectorCache* cache, uint16_t index) {
+    uint16_t* link = &cache->buckets[cache->entries[index].sector & cache->bucket_mask];
+
+    while(*link != index) {
+        link = &cache->entries[*link].hash_next;
+    }
+
+    *link = cache->entries[index].hash_next;
+}
+
+static bool sector_cache_ghost_take(SectorCache* cache, uint32_t sector) {
+    for(size_t i = 0; i < cache->ghosts_size; i++) {
+        if(cache->ghosts[i] == sector) {
+            cache->ghosts[i] = SECTOR_NONE;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void sector_cache_ghost_put(SectorCache* cache, uint32_t sector) {
+    if(!cache->ghosts_size) return;
+
+    cache->ghosts[cache->ghosts_pos] = sector;
+    cache->ghosts_pos = (cache->ghosts_pos + 1) % cache->ghosts_size;
+}
+
+static void sector_cache_drop(SectorCache* cache, uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    if(entry->flags & ENTRY_FLAG_DIRTY) cache->dirty_count--;
+    entry->flags = 0;
+
+    sector_cache_hash_remove(cache, index);
+    sector_cache_list_remove(cache, index);
+    sector_cache_list_push(cache, index, SectorCacheQueueFree);
+}
+
+static uint16_t sector_cache_victim(SectorCache* cache) {
+    SectorCacheList* free_list = &cache->queues[SectorCacheQueueFree];
+    SectorCacheList* in_list = &cache->queues[SectorCacheQueueIn];
+    SectorCacheList* main_list = &cache->queues[SectorCacheQueueMain];
+
+    if(free_list->size) return free_list->tail;
+    if(in_list->size >= cache->in_target || !main_list->size) return in_list->tail;
+
+    return main_list->tail;
+}
+
+static uint16_t sector_cache_reclaim(SectorCache* cache) {
+    uint16_t index = sector_cache_victim(cache);
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    if(entry->queue == SectorCacheQueueFree) return index;
+
+    // Flush everything at once, so neighbouring dirty sectors share writes
+    if((entry->flags & ENTRY_FLAG_DIRTY) && !sector_cache_sync(cache)) {
+        return INDEX_NONE;
+    }
+
+    if(entry->queue == SectorCacheQueueIn) {
+        sector_cache_ghost_put(cache, entry->sector);
+    }
+
+    cache->stats.evictions++;
+    sector_cache_drop(cache, index);
+
+    return index;
+}
+
+static uint16_t
+    sector_cache_insert(SectorCache* cache, uint32_t sector, const uint8_t* data, uint8_t flags) {
+    uint16_t index = sector_cache_reclaim(cache);
+    if(index == INDEX_NONE) return INDEX_NONE;
+
+    SectorCacheEntry* entry = &cache->entries[index];
+    sector_cache_list_remove(cache, index);
+
+    entry->sector = sector;
+    entry->flags = flags;
+    if(flags & ENTRY_FLAG_DIRTY) cache->dirty_count++;
+
+    uint16_t* bucket = &cache->buckets[sector & cache->bucket_mask];
+    entry->hash_next = *bucket;
+    *bucket = index;
+
+    // Sector seen again soon after leaving A1in is worth keeping
+    sector_cache_list_push(
+        cache,
+        index,
+        sector_cache_ghost_take(cache, sector) ? SectorCacheQueueMain : SectorCacheQueueIn);
+
+    memcpy(sector_cache_entry_data(cache, index), data, SECTOR_SIZE);
+
+    return index;
+}
+
+static void sector_cache_hit(SectorCache* cache, uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    cache->stats.hits++;
+
+    if(entry->flags & ENTRY_FLAG_READ_AHEAD) {
+        entry->flags &= ~ENTRY_FLAG_READ_AHEAD;
+        cache->stats.read_ahead_hits++;
+    }
+
+    if(entry->queue == SectorCacheQueueMain) {
+        sector_cache_list_remove(cache, index);
+        sector_cache_list_push(cache, index, SectorCacheQueueMain);
+    }
+}
+
+static bool sector_cache_read_ahead(SectorCache* cache, uint8_t* data, uint32_t sector) {
+    uint32_t count = cache->io_sectors;
+
+    // Don't read past the end of the disk
+    if(cache->disk_sectors) {
+        if(sector >= cache->disk_sectors) return false;
+        count = MIN(count, cache->disk_sectors - sector);
+    }
+    if(count < 2) return false;
+
+    if(!cache->read_callback(cache->context, cache->io_buffer, sector, count)) return false;
+
+    memcpy(data, cache->io_buffer, SECTOR_SIZE);
+    cache->stats.read_ahead += count - 1;
 
-static SectorCache* cache = NULL;
+    for(uint32_t i = 0; i < count; i++) {
+        // Cached copy may hold a newer deferred write
+        if(sector_cache_lookup(cache, sector + i) != INDEX_NONE) continue;
 
-void sector_cache_init(void) {
-    if(cache == NULL) {
-        cache = memmgr_alloc_from_pool(sizeof(SectorCache));
+        // Flush would reuse io buffer, so stop at dirty victim
+        if(cache->entries[sector_cache_victim(cache)].flags & ENTRY_FLAG_DIRTY) break;
+
+        sector_cache_insert(
+            cache, sector + i, &cache->io_buffer[i * SECTOR_SIZE], i ? ENTRY_FLAG_READ_AHEAD : 0);
     }
 
-    if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+    return true;
+}
+
+SectorCache* sector_cache_alloc(
+    const SectorCacheConfig* config,
+    SectorCacheReadCallback read_callback,
+    SectorCacheWriteCallback write_callback,
+    void* context) {
+    furi_check(config);
+    furi_check(config->sectors > 0 && config->sectors < INDEX_NONE);
+    furi_check(read_callback);
+    furi_check(write_callback);
+
+    uint16_t buckets = 1;
+    while(buckets < config->sectors) {
+        buckets <<= 1;
     }
+    const uint16_t ghosts = config->sectors / 2;
+
+    // Single block, largest alignment first
+    const size_t data_size = (size_t)config->sectors * SECTOR_SIZE;
+    const size_t entries_size = sizeof(SectorCacheEntry) * config->sectors;
+    const size_t ghosts_size = sizeof(uint32_t) * ghosts;
+    const size_t order_size = sizeof(uint16_t) * config->sectors;
+    const size_t buckets_size = sizeof(uint16_t) * buckets;
+    const size_t size = sizeof(SectorCache) + data_size + entries_size + ghosts_size +
+                        order_size + buckets_size;
+
+    uint8_t* memory = config->from_pool ? memmgr_alloc_from_pool(size) : malloc(size);
+    SectorCache* cache = (SectorCache*)memory;
+    memory += sizeof(SectorCache);
+    cache->data = memory;
+    memory += data_size;
+    cache->entries = (SectorCacheEntry*)memory;
+    memory += entries_size;
+    cache->ghosts = (uint32_t*)memory;
+    memory += ghosts_size;
+    cache->order = (uint16_t*)memory;
+    memory += order_size;
+    cache->buckets = (uint16_t*)memory;
+
+    cache->config = *config;
+    cache->read_callback = read_callback;
+    cache->write_callback = write_callback;
+    cache->context = context;
+    cache->bucket_mask = buckets - 1;
+    cache->ghosts_size = ghosts;
+    cache->in_target = MAX(config->sectors / 4, MIN(config->read_ahead, config->sectors));
+    cache->io_sectors = MAX(config->read_ahead, 1);
+    cache->io_buffer = malloc(cache->io_sectors * SECTOR_SIZE);
+
+    sector_cache_set_write_back_range(cache, 0, 0);
+    sector_cache_reset_stats(cache);
+    sector_cache_reset(cache);
+
+    return cache;
+}
+
+void sector_cache_free(SectorCache* cache) {
+    furi_check(cache);
+    furi_check(!cache->config.from_pool);
+
+    free(cache->io_buffer);
+    free(cache);
 }
 
-uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
+bool sector_cache_read(SectorCache* cache, uint8_t* data, uint32_t sector, uint32_t count) {
+    furi_check(cache);
+    furi_check(data);
+
+    const bool sequential = sector == cache->next_sector;
+    cache->next_sector = sector + count;
+
+    if(count == 1) {
+        uint16_t index = sector_cache_lookup(cache, sector);
+        if(index != INDEX_NONE) {
+            sector_cache_hit(cache, index);
+            memcpy(data, sector_cache_entry_data(cache, index), SECTOR_SIZE);
+            return true;
+        }
+
+        cache->stats.misses++;
+
+        // Falls back to single sector read, e.g. near the end of the disk
+        if(sequential && cache->io_sectors > 1 && sector_cache_read_ahead(cache, data, sector)) {
+            return true;
         }
+
+        if(!cache->read_callback(cache->context, data, sector, 1)) return false;
+        sector_cache_insert(cache, sector, data, 0);
+
+        return true;
+    }
+
+    // Multi-sector reads are file data, they bypass the cache to keep it clean
+    uint32_t cached = 0;
+    while(cached < count && sector_cache_lookup(cache, sector + cached) != INDEX_NONE) {
+        cached++;
+    }
+
+    if(cached == count) {
+        for(uint32_t i = 0; i < count; i++) {
+            uint16_t index = sector_cache_lookup(cache, sector + i);
+            sector_cache_hit(cache, index);
+            memcpy(&data[i * SECTOR_SIZE], sector_cache_entry_data(cache, index), SECTOR_SIZE);
+        }
+        return true;
     }
-    return NULL;
+
+    cache->stats.bypass += count;
+    if(!cache->read_callback(cache->context, data, sector, count)) return false;
+
+    // Deferred writes are newer than disk contents
+    for(uint32_t i = 0; cache->dirty_count && i < count; i++) {
+        uint16_t index = sector_cache_lookup(cache, sector + i);
+        if(index != INDEX_NONE && (cache->entries[index].flags & ENTRY_FLAG_DIRTY)) {
+            memcpy(&data[i * SECTOR_SIZE], sector_cache_entry_data(cache, index), SECTOR_SIZE);
+        }
+    }
+
+    return true;
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
-    if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+bool sector_cache_write(SectorCache* cache, const uint8_t* data, uint32_t sector, uint32_t count) {
+    furi_check(cache);
+    furi_check(data);
+
+    if(count == 1 && sector >= cache->write_back_start && sector < cache->write_back_end) {
+        uint16_t index = sector_cache_lookup(cache, sector);
+
+        if(index != INDEX_NONE) {
+            SectorCacheEntry* entry = &cache->entries[index];
+            if(!(entry->flags & ENTRY_FLAG_DIRTY)) cache->dirty_count++;
+            entry->flags = ENTRY_FLAG_DIRTY;
+            memcpy(sector_cache_entry_data(cache, index), data, SECTOR_SIZE);
+        } else {
+            index = sector_cache_insert(cache, sector, data, ENTRY_FLAG_DIRTY);
+        }
+
+        if(index != INDEX_NONE) {
+            cache->stats.writes_deferred++;
+            return true;
+        }
+    }
+
+    // Cached copies are superseded by this write
+    for(uint32_t i = 0; i < count; i++) {
+        uint16_t index = sector_cache_lookup(cache, sector + i);
+        if(index != INDEX_NONE) sector_cache_drop(cache, index);
+    }
+
+    if(!cache->write_callback(cache->context, data, sector, count)) return false;
+
+    if(count == 1) {
+        sector_cache_insert(cache, sector, data, 0);
+    }
+
+    return true;
 }
 
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+bool sector_cache_sync(SectorCache* cache) {
+    furi_check(cache);
+
+    if(!cache->dirty_count) return true;
+
+    // Sort dirty sectors, so adjacent ones are written together
+    uint16_t dirty = 0;
+    for(uint16_t index = 0; index < cache->config.sectors; index++) {
+        if(!(cache->entries[index].flags & ENTRY_FLAG_DIRTY)) continue;
+
+        uint16_t pos = dirty++;
+        while(pos && cache->entries[cache->order[pos - 1]].sector > cache->entries[index].sector) {
+            cache->order[pos] = cache->order[pos - 1];
+            pos--;
         }
+        cache->order[pos] = index;
+    }
+
+    for(uint16_t start = 0; start < dirty;) {
+        const uint32_t sector = cache->entries[cache->order[start]].sector;
+        uint16_t count = 0;
+
+        while(start + count < dirty && count < cache->io_sectors &&
+              cache->entries[cache->order[start + count]].sector == sector + count) {
+            memcpy(
+                &cache->io_buffer[count * SECTOR_SIZE],
+                sector_cache_entry_data(cache, cache->order[start + count]),
+                SECTOR_SIZE);
+            count++;
+        }
+
+        if(!cache->write_callback(cache->context, cache->io_buffer, sector, count)) return false;
+
+        for(uint16_t i = 0; i < count; i++) {
+            cache->entries[cache->order[start + i]].flags &= ~ENTRY_FLAG_DIRTY;
+        }
+
+        cache->dirty_count -= count;
+        cache->stats.writes_flushed += count;
+        start += count;
+    }
+
+    return true;
+}
+
+void sector_cache_reset(SectorCache* cache) {
+    furi_check(cache);
+
+    memset(cache->queues, 0xFF, sizeof(cache->queues));
+    for(size_t i = 0; i < SectorCacheQueueCount; i++) {
+        cache->queues[i].size = 0;
+    }
+
+    memset(cache->buckets, 0xFF, sizeof(uint16_t) * (cache->bucket_mask + 1));
+    memset(cache->ghosts, 0xFF, sizeof(uint32_t) * cache->ghosts_size);
+    cache->ghosts_pos = 0;
+
+    for(uint16_t index = 0; index < cache->config.sectors; index++) {
+        cache->entries[index].flags = 0;
+        sector_cache_list_push(cache, index, SectorCacheQueueFree);
     }
-}
\ No newline at end of file
+
+    cache->dirty_count = 0;
+    cache->next_sector = SECTOR_NONE;
+}
+
+void sector_cache_set_write_back_range(
+    SectorCache* cache,
+    uint32_t start_sector,
+    uint32_t end_sector) {
+    furi_check(cache);
+    furi_check(start_sector <= end_sector);
+
+    cache->write_back_start = start_sector;
+    cache->write_back_end = end_sector;
+}
+
+void sector_cache_set_disk_sectors(SectorCache* cache, uint32_t disk_sectors) {
+    furi_check(cache);
+
+    cache->disk_sectors = disk_sectors;
+}
+
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats) {
+    furi_check(cache);
+    furi_check(stats);
+
+    *stats = cache->stats;
+}
+
+void sector_cache_reset_stats(SectorCache* cache) {
+    furi_check(cache);
+
+    memset(&cache->stats, 0, sizeof(cache->stats));
+}
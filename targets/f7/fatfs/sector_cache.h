@@ -1,35 +1,149 @@
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define SECTOR_CACHE_SECTOR_SIZE (512)
+
+typedef struct SectorCache SectorCache;
+
+/**
+ * @brief Disk read callback
+ * @param context Callback context
+ * @param data Destination buffer, count * SECTOR_CACHE_SECTOR_SIZE bytes
+ * @param sector First sector number
+ * @param count Number of sectors
+ * @return true on success
+ */
+typedef bool (*SectorCacheReadCallback)(
+    void* context,
+    uint8_t* data,
+    uint32_t sector,
+    uint32_t count);
+
+/**
+ * @brief Disk write callback
+ * @param context Callback context
+ * @param data Source buffer, count * SECTOR_CACHE_SECTOR_SIZE bytes
+ * @param sector First sector number
+ * @param count Number of sectors
+ * @return true on success
+ */
+typedef bool (*SectorCacheWriteCallback)(
+    void* context,
+    const uint8_t* data,
+    uint32_t sector,
+    uint32_t count);
+
+typedef struct {
+    uint16_t sectors; /**< Number of cached sectors */
+    uint16_t read_ahead; /**< Sectors fetched on sequential miss and max sectors per flush */
+    bool from_pool; /**< Allocate cache memory from the memory pool, instance can't be freed */
+} SectorCacheConfig;
+
+typedef struct {
+    uint32_t hits; /**< Sectors served from cache */
+    uint32_t misses; /**< Single sector reads that went to the disk */
+    uint32_t bypass; /**< Sectors of multi-sector reads that went to the disk */
+    uint32_t read_ahead; /**< Sectors fetched ahead of request */
+    uint32_t read_ahead_hits; /**< Fetched ahead sectors that were used */
+    uint32_t evictions; /**< Sectors evicted from cache */
+    uint32_t writes_deferred; /**< Sector writes kept in cache */
+    uint32_t writes_flushed; /**< Deferred sectors written to the disk */
+} SectorCacheStats;
+
+/**
+ * @brief Allocate sector cache
+ *
+ * Uses 2Q replacement: sectors read once go to a short FIFO, sectors read again
+ * after leaving it go to the main LRU queue, so FAT and directory sectors are not
+ * evicted by file data and FAT scans.
+ *
+ * @param config Cache configuration
+ * @param read_callback Disk read callback
+ * @param write_callback Disk write callback
+ * @param context Callbacks context
+ * @return SectorCache instance
+ */
+SectorCache* sector_cache_alloc(
+    const SectorCacheConfig* config,
+    SectorCacheReadCallback read_callback,
+    SectorCacheWriteCallback write_callback,
+    void* context);
+
+/**
+ * @brief Free sector cache, dirty sectors are lost
+ * @param cache SectorCache instance
+ */
+void sector_cache_free(SectorCache* cache);
+
+/**
+ * @brief Read sectors through the cache
+ * @param cache SectorCache instance
+ * @param data Destination buffer
+ * @param sector First sector number
+ * @param count Number of sectors
+ * @return true on success
+ */
+bool sector_cache_read(SectorCache* cache, uint8_t* data, uint32_t sector, uint32_t count);
+
+/**
+ * @brief Write sectors through the cache
+ * Single sector writes inside the write-back range are kept in cache until sync.
+ * @param cache SectorCache instance
+ * @param data Source buffer
+ * @param sector First sector number
+ * @param count Number of sectors
+ * @return true on success
+ */
+bool sector_cache_write(SectorCache* cache, const uint8_t* data, uint32_t sector, uint32_t count);
+
+/**
+ * @brief Write all deferred sectors to the disk
+ * @param cache SectorCache instance
+ * @return true on success
+ */
+bool sector_cache_sync(SectorCache* cache);
+
+/**
+ * @brief Drop all cached sectors, including deferred writes
+ * @param cache SectorCache instance
+ */
+void sector_cache_reset(SectorCache* cache);
+
 /**
- * @brief Init sector cache system
+ * @brief Set range of sectors eligible for write-back, usually the FAT
+ * @param cache SectorCache instance
+ * @param start_sector First sector of the range
+ * @param end_sector Sector after the range, equal to start_sector to disable write-back
  */
-void sector_cache_init(void);
+void sector_cache_set_write_back_range(
+    SectorCache* cache,
+    uint32_t start_sector,
+    uint32_t end_sector);
 
 /**
- * @brief Get sector data from cache
- * @param n_sector Sector number
- * @return Pointer to sector data or NULL if not found
+ * @brief Set disk size, read ahead is limited to it
+ * @param cache SectorCache instance
+ * @param disk_sectors Number of sectors on the disk, 0 if unknown
  */
-uint8_t* sector_cache_get(uint32_t n_sector);
+void sector_cache_set_disk_sectors(SectorCache* cache, uint32_t disk_sectors);
 
 /**
- * @brief Put sector data to cache
- * @param n_sector Sector number
- * @param data Pointer to sector data
+ * @brief Get cache statistics
+ * @param cache SectorCache instance
+ * @param stats Destination statistics
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats);
 
 /**
- * @brief Invalidate sector cache for given range
- * @param start_sector Start sector number
- * @param end_sector End sector number
+ * @brief Reset cache statistics
+ * @param cache SectorCache instance
  */
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
+void sector_cache_reset_stats(SectorCache* cache);
 
 #ifdef __cplusplus
 }
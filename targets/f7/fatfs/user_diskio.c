@@ -87,7 +87,7 @@ static DRESULT driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
     switch(cmd) {
     /* Make sure that no pending write process */
     case CTRL_SYNC:
-        res = RES_OK;
+        res = furi_hal_sd_sync() == FuriStatusOk ? RES_OK : RES_ERROR;
         break;
 
     /* Get number of sectors on the disk (DWORD) */
@@ -5,6 +5,9 @@
 #include "../fatfs/sector_cache.h"
 #define TAG "SdSpi"
 
+#define SD_CACHE_SECTORS (16)
+#define SD_CACHE_READ_AHEAD (4)
+
 #ifdef FURI_HAL_SD_SPI_DEBUG
 #define sd_spi_debug(...) FURI_LOG_I(TAG, __VA_ARGS__)
 #else
@@ -22,6 +25,10 @@
 
 static bool sd_high_capacity = false;
 
+static SectorCache* sd_cache = NULL;
+// Status of the last disk operation made by the cache
+static FuriStatus sd_cache_status = FuriStatusOk;
+
 typedef enum {
     SdSpiDataResponceOK = 0x05,
     SdSpiDataResponceCRCError = 0x0B,
@@ -816,27 +823,6 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
-static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
-    uint8_t* cached_data = sector_cache_get(address);
-    if(cached_data) {
-        memcpy(data, cached_data, SD_BLOCK_SIZE);
-        return true;
-    }
-    return false;
-}
-
-static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
-}
-
-static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    sector_cache_invalidate_range(start_sector, end_sector);
-}
-
-static inline void sd_cache_invalidate_all(void) {
-    sector_cache_init();
-}
-
 static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count) {
     FuriStatus status = FuriStatusError;
 
@@ -877,8 +863,6 @@ static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_
             status = sd_spi_get_card_state();
 
             if(furi_hal_cortex_timer_is_expired(timer)) {
-                sd_cache_invalidate_all();
-
                 status = FuriStatusErrorTimeout;
                 break;
             }
@@ -911,7 +895,7 @@ uint8_t furi_hal_sd_max_mount_retry_count(void) {
     return 10;
 }
 
-FuriStatus furi_hal_sd_init(bool power_reset) {
+static FuriStatus sd_init(bool power_reset) {
     // Slow speed init
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_slow);
     furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_slow;
@@ -953,9 +937,6 @@ FuriStatus furi_hal_sd_init(bool power_reset) {
     furi_hal_sd_spi_handle = NULL;
     furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_slow);
 
-    // Init sector cache
-    sector_cache_init();
-
     return status;
 }
 
@@ -971,19 +952,8 @@ FuriStatus furi_hal_sd_get_card_state(void) {
     return status;
 }
 
-FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
-    furi_check(buff);
-
-    FuriStatus status;
-    bool single_sector = count == 1;
-
-    if(single_sector) {
-        if(sd_cache_get(sector, buff)) {
-            return FuriStatusOk;
-        }
-    }
-
-    status = sd_device_read(buff, sector, count);
+static FuriStatus sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_read(buff, sector, count);
 
     if(status != FuriStatusOk) {
         uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -991,9 +961,9 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
             if((counter % 2) == 0) {
                 // power reset sd card
-                status = furi_hal_sd_init(true);
+                status = sd_init(true);
             } else {
-                status = furi_hal_sd_init(false);
+                status = sd_init(false);
             }
 
             if(status == FuriStatusOk) {
@@ -1003,21 +973,11 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         }
     }
 
-    if(single_sector && status == FuriStatusOk) {
-        sd_cache_put(sector, buff);
-    }
-
     return status;
 }
 
-FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
-    furi_check(buff);
-
-    FuriStatus status;
-
-    sd_cache_invalidate_range(sector, sector + count);
-
-    status = sd_device_write(buff, sector, count);
+static FuriStatus sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_write(buff, sector, count);
 
     if(status != FuriStatusOk) {
         uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -1025,9 +985,9 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
         while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
             if((counter % 2) == 0) {
                 // power reset sd card
-                status = furi_hal_sd_init(true);
+                status = sd_init(true);
             } else {
-                status = furi_hal_sd_init(false);
+                status = sd_init(false);
             }
 
             if(status == FuriStatusOk) {
@@ -1040,6 +1000,93 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
     return status;
 }
 
+static bool
+    sd_cache_read_callback(void* context, uint8_t* data, uint32_t sector, uint32_t count) {
+    UNUSED(context);
+    sd_cache_status = sd_read_blocks((uint32_t*)data, sector, count);
+    return sd_cache_status == FuriStatusOk;
+}
+
+static bool
+    sd_cache_write_callback(void* context, const uint8_t* data, uint32_t sector, uint32_t count) {
+    UNUSED(context);
+    sd_cache_status = sd_write_blocks((const uint32_t*)data, sector, count);
+    return sd_cache_status == FuriStatusOk;
+}
+
+FuriStatus furi_hal_sd_init(bool power_reset) {
+    FuriStatus status = sd_init(power_reset);
+
+    // Card may have been replaced, drop everything
+    if(!sd_cache) {
+        const SectorCacheConfig config = {
+            .sectors = SD_CACHE_SECTORS,
+            .read_ahead = SD_CACHE_READ_AHEAD,
+            .from_pool = true,
+        };
+        sd_cache = sector_cache_alloc(
+            &config, sd_cache_read_callback, sd_cache_write_callback, NULL);
+    } else {
+        sector_cache_reset(sd_cache);
+    }
+
+    FuriHalSdInfo info = {};
+    if(status == FuriStatusOk && furi_hal_sd_info(&info) != FuriStatusOk) {
+        info.logical_block_count = 0;
+    }
+    sector_cache_set_disk_sectors(sd_cache, info.logical_block_count);
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
+    furi_check(buff);
+
+    if(!sd_cache) return sd_read_blocks(buff, sector, count);
+
+    bool success = sector_cache_read(sd_cache, (uint8_t*)buff, sector, count);
+    return success ? FuriStatusOk : sd_cache_status;
+}
+
+FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    furi_check(buff);
+
+    if(!sd_cache) return sd_write_blocks(buff, sector, count);
+
+    bool success = sector_cache_write(sd_cache, (const uint8_t*)buff, sector, count);
+    return success ? FuriStatusOk : sd_cache_status;
+}
+
+FuriStatus furi_hal_sd_sync(void) {
+    if(!sd_cache) return FuriStatusOk;
+
+    return sector_cache_sync(sd_cache) ? FuriStatusOk : sd_cache_status;
+}
+
+void furi_hal_sd_cache_set_write_back(uint32_t start_sector, uint32_t end_sector) {
+    if(sd_cache) sector_cache_set_write_back_range(sd_cache, start_sector, end_sector);
+}
+
+void furi_hal_sd_cache_get_stats(FuriHalSdCacheStats* stats) {
+    furi_check(stats);
+
+    SectorCacheStats cache_stats = {};
+    if(sd_cache) sector_cache_get_stats(sd_cache, &cache_stats);
+
+    stats->hits = cache_stats.hits;
+    stats->misses = cache_stats.misses;
+    stats->bypass = cache_stats.bypass;
+    stats->read_ahead = cache_stats.read_ahead;
+    stats->read_ahead_hits = cache_stats.read_ahead_hits;
+    stats->evictions = cache_stats.evictions;
+    stats->writes_deferred = cache_stats.writes_deferred;
+    stats->writes_flushed = cache_stats.writes_flushed;
+}
+
+void furi_hal_sd_cache_reset_stats(void) {
+    if(sd_cache) sector_cache_reset_stats(sd_cache);
+}
+
 FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
     furi_check(info);
 
@@ -26,6 +26,17 @@ typedef struct {
     uint16_t manufacturing_year; /*!< manufacturing year */
 } FuriHalSdInfo;
 
+typedef struct {
+    uint32_t hits; /*!< sectors served from cache */
+    uint32_t misses; /*!< single sector reads that went to the card */
+    uint32_t bypass; /*!< sectors of multi-sector reads that went to the card */
+    uint32_t read_ahead; /*!< sectors fetched ahead of request */
+    uint32_t read_ahead_hits; /*!< fetched ahead sectors that were used */
+    uint32_t evictions; /*!< sectors evicted from cache */
+    uint32_t writes_deferred; /*!< sector writes kept in cache */
+    uint32_t writes_flushed; /*!< deferred sectors written to the card */
+} FuriHalSdCacheStats;
+
 /** 
  * @brief Init SD card presence detection
  */
@@ -68,6 +79,30 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
  */
 FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count);
 
+/**
+ * @brief Write sectors kept in cache to SD card
+ * @return FuriStatus 
+ */
+FuriStatus furi_hal_sd_sync(void);
+
+/**
+ * @brief Set sectors which writes are kept in cache until sync, usually the FAT
+ * @param start_sector first sector
+ * @param end_sector sector after the last one, equal to start_sector to disable
+ */
+void furi_hal_sd_cache_set_write_back(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Get sector cache statistics
+ * @param stats 
+ */
+void furi_hal_sd_cache_get_stats(FuriHalSdCacheStats* stats);
+
+/**
+ * @brief Reset sector cache statistics
+ */
+void furi_hal_sd_cache_reset_stats(void);
+
 /**
  * @brief Get SD card info
  * @param info 